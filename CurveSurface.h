@@ -0,0 +1,90 @@
+/**
+ * @file CurveSurface.h
+ * @brief 编辑器的绘制表面与曲线 / 圆点绘制入口
+ *
+ * 默认构建中 CurveSurface 就是光栅 QWidget，折线和圆点用 QPainter 绘制；
+ * 以 qmake "CONFIG+=curve_opengl" 构建时 CurveSurface 为 QOpenGLWidget，
+ * 折线与圆点交给 GLCurveRenderer 在 GPU 上绘制，其余内容（文字、缓存图层）仍走 QPainter。
+ * OpenGL 初始化失败（如上下文低于 3.3）时自动退回 QPainter。
+ *
+ * SurfaceRenderer 同时持有每帧临时内存（frameArena），begin() 与 end() 之间分配、end() 时整体回收，
+ * 折线顶点、GPU 圆点实例与视口细分参数都从这里取，稳定交互中绘制不再分配堆内存。
+ */
+#ifndef CURVESURFACE_H
+#define CURVESURFACE_H
+
+#ifdef CURVE_OPENGL
+#include <QOpenGLWidget>
+typedef QOpenGLWidget CurveSurface;
+class GLCurveRenderer;
+#else
+#include <QWidget>
+typedef QWidget CurveSurface;
+#endif
+
+#include <QColor>
+#include <QPointF>
+#include <QVector>
+#include <memory>
+#include "curvecore/ScratchArena.h"
+
+class QPainter;
+class QPen;
+
+/**
+ * @struct SurfaceDisc
+ * @brief 一个圆点：控制点、插值点或手柄
+ */
+struct SurfaceDisc {
+    QPointF center;
+    double radius;
+    QColor inner;               ///< 圆心处填充色
+    QColor outer;               ///< 边缘处填充色，与 inner 相同即纯色
+    QColor stroke;              ///< 描边色
+    double strokeWidth;         ///< 描边宽度，0 表示无描边
+};
+
+class SurfaceRenderer
+{
+public:
+    explicit SurfaceRenderer(CurveSurface *surface);
+    ~SurfaceRenderer();
+
+    SurfaceRenderer(const SurfaceRenderer &) = delete;
+    SurfaceRenderer &operator=(const SurfaceRenderer &) = delete;
+
+    void begin(QPainter &painter);          ///< 每帧开始时调用，OpenGL 构建下首次调用时初始化
+    void end();                             ///< 每帧结束时调用，回收 frameArena
+    curvecore::ScratchArena &frameArena() { return arena; }
+    bool acceleratesDiscs() const;          ///< 圆点是否由 GPU 绘制；否则调用方可自行缓存为图层
+
+    /**
+     * @brief 绘制折线（SoA 顶点）
+     * @param revision 顶点内容的版本号：xs、count 与 revision 均未变化时 GPU 复用已上传的顶点缓冲
+     */
+    void strokePolyline(QPainter &painter, const double *xs, const double *ys, int count,
+                        quint64 revision, const QPen &pen);
+    void strokePolyline(QPainter &painter, const float *xs, const float *ys, int count,
+                        quint64 revision, const QPen &pen);
+
+    void drawDiscs(QPainter &painter, const QVector<SurfaceDisc> &discs);
+
+    /**
+     * @brief 用 QPainter 绘制圆点（光栅后端与预渲染精灵共用）
+     */
+    static void paintDiscs(QPainter &painter, const QVector<SurfaceDisc> &discs);
+
+private:
+    template <typename T>
+    void strokePolylineImpl(QPainter &painter, const T *xs, const T *ys, int count,
+                            quint64 revision, const QPen &pen);
+
+    CurveSurface *surface;
+    curvecore::ScratchArena arena;          ///< 每帧临时内存
+#ifdef CURVE_OPENGL
+    std::unique_ptr<GLCurveRenderer> gl;    ///< 初始化失败时为空
+    bool glInitialized = false;
+#endif
+};
+
+#endif // CURVESURFACE_H
@@ -18,11 +18,29 @@ DEFINES += QT_DEPRECATED_WARNINGS
 SOURCES += \
     HermiteEditor.cpp \
     NurbsEditor.cpp \
-    main.cpp
+    curvesurface.cpp \
+    main.cpp \
+    pointgrid.cpp \
+    renderstats.cpp \
+    sceneviewer.cpp
 
 HEADERS += \
+    CurveSurface.h \
     HermiteEditor.h \
-    NurbsEditor.h
+    NurbsEditor.h \
+    PixmapLayer.h \
+    PointGrid.h \
+    RenderStats.h \
+    SceneViewer.h
+
+# 可选 OpenGL 渲染后端：qmake "CONFIG+=curve_opengl"
+curve_opengl {
+    DEFINES += CURVE_OPENGL
+    SOURCES += glcurverenderer.cpp
+    HEADERS += GLCurveRenderer.h
+}
+
+include(curvecore/curvecore.pri)
 
 FORMS += \
     nurbseditor.ui
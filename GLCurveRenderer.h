@@ -0,0 +1,83 @@
+/**
+ * @file GLCurveRenderer.h
+ * @brief OpenGL 曲线渲染器（仅在 CONFIG+=curve_opengl 构建时编译）
+ *
+ * - 折线：顶点坐标上传到顶点缓冲，每条线段作为一个实例展开成四边形，
+ *   片元着色器按到线段的距离计算覆盖率，得到带圆头、圆角连接的抗锯齿粗线
+ * - 圆点：控制点、手柄等作为实例化四边形一次绘制，支持径向渐变填充与描边
+ *
+ * 所有坐标使用窗口逻辑像素，着色器内乘以设备像素比。调用方负责在当前上下文中调用
+ * （QPainter::beginNativePainting / endNativePainting 之间）。
+ */
+#ifndef GLCURVERENDERER_H
+#define GLCURVERENDERER_H
+
+#include <QOpenGLBuffer>
+#include <QOpenGLExtraFunctions>
+#include <QOpenGLShaderProgram>
+#include <QOpenGLVertexArrayObject>
+#include <QVector>
+
+class GLCurveRenderer : protected QOpenGLExtraFunctions
+{
+public:
+    /**
+     * @struct Disc
+     * @brief 一个圆点实例（与顶点缓冲布局一致）
+     */
+    struct Disc {
+        float center[2];
+        float radius;
+        float strokeWidth;      ///< 描边宽度，0 表示无描边
+        float inner[4];         ///< 圆心处填充色（RGBA，0..1）
+        float outer[4];         ///< 边缘处填充色，与 inner 相同即纯色
+        float stroke[4];        ///< 描边色
+    };
+
+    GLCurveRenderer();
+
+    bool initialize();          ///< 编译着色器并创建缓冲，失败时返回 false
+    bool isValid() const { return valid; }
+    void release();             ///< 释放 GL 资源，需在对应上下文中调用
+
+    void setViewport(int width, int height, float devicePixelRatio);
+
+    /**
+     * @brief 绘制折线
+     *        data 指针、点数与 revision 均未变化时复用已上传的顶点缓冲
+     * @param color RGBA（0..1）
+     * @param width 线宽（逻辑像素）
+     */
+    void drawPolyline(const double *xs, const double *ys, int count, quint64 revision,
+                      const float *color, float width);
+    void drawPolyline(const float *xs, const float *ys, int count, quint64 revision,
+                      const float *color, float width);     ///< float 顶点（混合精度采样结果），上传时不需要转换
+
+    void drawDiscs(const Disc *discs, int count);
+
+private:
+    template <typename T>
+    void drawPolylineImpl(const T *xs, const T *ys, int count, quint64 revision,
+                          const float *color, float width);
+    bool buildProgram(QOpenGLShaderProgram &program, const char *vertex, const char *fragment,
+                      const char *const *attributes, int attributeCount);
+
+    QOpenGLShaderProgram polylineProgram;
+    QOpenGLShaderProgram discProgram;
+    QOpenGLBuffer cornerBuffer;             ///< 单位四边形的四个角（三角形带）
+    QOpenGLBuffer polylineBuffer;           ///< 折线顶点 (x, y)，相邻两个顶点构成一个线段实例
+    QOpenGLBuffer discBuffer;               ///< Disc 实例
+    QOpenGLVertexArrayObject polylineVao;
+    QOpenGLVertexArrayObject discVao;
+
+    QVector<float> uploadScratch;           ///< 交错 (x, y) float 顶点缓冲，跨帧复用
+    const void *uploadedData = nullptr;     ///< 已上传折线的来源，用于判断是否需要重新上传
+    int uploadedCount = 0;
+    quint64 uploadedRevision = 0;
+
+    float viewport[2] = { 1.0f, 1.0f };     ///< 设备像素
+    float scale = 1.0f;                     ///< 设备像素比
+    bool valid = false;
+};
+
+#endif // GLCURVERENDERER_H
@@ -2,12 +2,13 @@
  * @class HermiteEditor
  * @brief 二维交互式 Hermite 曲线编辑器（基于 Qt）
  *
- * HermiteEditor 提供基于 QWidget 的 Hermite 三次插值曲线绘制与控制点交互功能。
+ * HermiteEditor 提供基于 CurveSurface（QWidget 或 QOpenGLWidget）的 Hermite 三次插值曲线绘制与控制点交互功能。
  * 用户可通过鼠标点击创建插值点、拖动控制切线方向，按键调整精度或清空画布。
  *
  * 功能特点：
  * - 鼠标左键点击空白区域添加点，右键点击删除点
  * - 拖动插值点位置或切线手柄动态影响曲线形状
+ * - 悬停时高亮鼠标下方的曲线点，Shift+双击在曲线上最近处插入插值点
  * - Hermite 三次曲线基于点与切线构建
  * - 可调采样精度，可隐藏控制点
  *
@@ -19,11 +20,18 @@
 #ifndef HERMITEEDITOR_H
 #define HERMITEEDITOR_H
 
-#include <QWidget>
+#include "CurveSurface.h"
 #include <QVector>
 #include <QPointF>
-
-class HermiteEditor : public QWidget
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include "curvecore/CurveCore.h"
+#include "PixmapLayer.h"
+#include "PointGrid.h"
+#include "RenderStats.h"
+
+class HermiteEditor : public CurveSurface
 {
     Q_OBJECT
 
@@ -31,6 +39,32 @@ public:
     explicit HermiteEditor(QWidget *parent = nullptr);
     ~HermiteEditor();
 
+    // 批量求值：t[0..n) ∈ [0,1] 均匀映射到各曲线段，结果以 SoA 形式写入 outX/outY
+    void evaluateMany(const double *t, size_t n, double *outX, double *outY) const;
+
+    // 自适应细分：按弦偏差（像素）加密急弯、稀疏直线段
+    void setAdaptiveTessellation(bool enabled);
+    void setAdaptiveTolerance(double pixels);
+    void setAdaptiveMaxDepth(int depth);
+
+    // 视口细分（LOD）：按曲线段在屏幕上的尺寸与曲率取样，视口外的段剔除；自适应细分开启时不生效
+    void setLevelOfDetail(bool enabled);
+    bool levelOfDetail() const;
+
+    // 曲线文件（.crv）：保存当前样条；加载时内存映射文件，失败返回 false 并写入 error
+    bool saveCurve(const QString &fileName, QString *error = nullptr) const;
+    bool loadCurve(const QString &fileName, QString *error = nullptr);
+
+    // 高分辨率折线导出（.bin 为二进制，其余为文本），分块流式写出，内存占用恒定；spacing 选择参数或弧长等距
+    bool exportPolyline(const QString &fileName, qint64 samples, double tolerance = 0.0,
+                        QString *error = nullptr,
+                        curvecore::ExportSpacing spacing = curvecore::EXPORT_UNIFORM_PARAMETER) const;
+
+    // 性能统计：最近一帧与滑动窗口内的细分 / 绘制耗时、求值吞吐、缓存命中率（P 键显示面板）
+    const RenderStats &renderStats() const;
+    void setProfilingOverlay(bool visible);
+    bool profilingOverlay() const;
+
 protected:
      // QWidget 事件处理函数
     void paintEvent(QPaintEvent *event) override;
@@ -42,26 +76,100 @@ protected:
 
 private:
 
+    typedef curvecore::HermiteSpline<double, 2> Spline;
+    typedef curvecore::Polyline<double, 2> Polyline;
+
     /**
-      * @struct InterpPoint
-      * @brief 表示插值点及其切线数据
+      * @struct TessellationJob
+      * @brief 提交给后台细分线程的不可变快照
       */
-    struct InterpPoint {
-        QPointF position;  ///< 插值点位置
-        QPointF tangent;    ///< 切线向量（右切线）
-        bool hasTangent = false;   ///< 是否启用用户自定义切线
-
-        InterpPoint(const QPointF &pos) : position(pos), tangent(50, 0) {}
+    struct TessellationJob {
+        Spline spline;
+        int resolution;
+        bool adaptive;
+        curvecore::TessellationSettings settings;
+        bool lod;
+        curvecore::Viewport viewport;
+        curvecore::LodSettings lodSettings;
+        curvecore::PrecisionSettings precision;
+    };
+    typedef curvecore::BackgroundTessellator<TessellationJob, Polyline> Tessellator;
+
+    /* 撤销日志中的一条修改：只保存变化的字段，清空是唯一需要整条拷贝的修改 */
+    struct Edit {
+        enum Kind { MOVE_POINT, SET_TANGENT, INSERT_POINT, REMOVE_POINT, CLEAR };
+        Kind kind = MOVE_POINT;
+        int index = -1;
+        // MOVE_POINT: x, y；SET_TANGENT: tx, ty, 自定义标志；INSERT/REMOVE_POINT: x, y, tx, ty, 自定义标志（前后相同）
+        double before[5] = {};
+        double after[5] = {};
+        std::shared_ptr<const Spline> clearedSpline;   ///< CLEAR：清空前的样条
+
+        void merge(const Edit &newer) { std::copy(newer.after, newer.after + 5, after); }
     };
 
-    QVector<InterpPoint*> points;               ///< 插值点列表
-    InterpPoint* selectedPoint = nullptr;       ///< 当前选中的插值点
-    QPointF* activeTangent = nullptr;           ///< 当前活动的切线句柄
+    Spline spline;                               ///< 插值点、切线及自定义切线标志（SoA，curvecore）
+    PointGrid pointIndex;                        ///< 插值点位置的网格索引
+    PointGrid handleIndex[2];                    ///< 切线手柄 p+t / p-t 的网格索引
+    int selectedPoint = -1;                      ///< 当前选中的插值点下标，-1 表示未选中
+    bool draggingTangent = false;                ///< 是否正在拖动切线手柄
 
     static const int POINT_RADIUS = 8;           ///< 插值点显示半径
     static const int HANDLE_RADIUS = 6;          ///< 切线手柄显示半径
     static const int SNAP_DISTANCE = 20;         ///< 鼠标命中判定半径
+    static const int HOVER_RADIUS = 5;           ///< 曲线悬停标记半径
+    static const int REPAINT_MARGIN = 32;        ///< 局部重绘区域外扩量，覆盖曲线线宽、点、手柄与编号
+    static const int STATUS_WIDTH = 420;         ///< 左上角说明文字区域（含自适应顶点数等会变化的内容）
+    static const int STATUS_HEIGHT = 216;
+    static const int BACKGROUND_WORK = 200000;   ///< 预计求值样本数超过此值时改由后台线程细分
     int sampleResolution = 100;                  ///< 曲线采样精度
+    curvecore::PrecisionSettings precision;      ///< 绘制精度（F 切换），默认混合；导出与文件始终使用 double
+    int fallbackSegments = 0;                    ///< 最近一次采样中误差上界超限、改用 double 的段数
+
+    // 按段缓存的采样结果（SoA，float 供绘制）：第 i 段占 [i*res, (i+1)*res]，段首样本归属本段
+    QVector<double> sampleParams;                ///< 段内共享的局部参数网格
+    QVector<float> sampleX;
+    QVector<float> sampleY;
+    QVector<bool> segmentDirty;                  ///< 每段是否需要重新采样
+    QVector<int> dirtySegments;                  ///< 本帧待采样的段下标（复用缓冲区）
+    int cachedResolution = 0;                    ///< 缓存对应的采样精度
+
+    bool adaptiveMode = false;                       ///< 是否启用自适应细分
+    curvecore::TessellationSettings adaptiveSettings;   ///< 容差与最大深度
+    QVector<double> adaptiveX;                       ///< 自适应细分得到的顶点
+    QVector<double> adaptiveY;
+
+    bool lodMode = false;                            ///< 是否启用视口细分
+    Polyline lodLine;                                ///< 视口细分得到的顶点
+    curvecore::LodStats lodStats;                    ///< 最近一次视口细分的剔除统计
+    curvecore::Viewport submittedViewport;           ///< 最近提交给后台线程的视口
+
+    curvecore::SnapshotPool<TessellationJob> jobPool;   ///< 复用已处理完的快照，拖动时提交不再分配
+    Tessellator backgroundTessellator;               ///< 大曲线的后台细分线程
+    bool tessellationStale = true;                   ///< 曲线或细分参数变化后尚未提交快照
+
+    RenderStats stats;                               ///< 逐帧性能统计
+    bool showProfiling = false;                      ///< 是否绘制性能面板
+
+    // 缓存图层：插值点只在增删点、切换选中点、窗口尺寸变化时重绘；选中点每帧直接绘制
+    PixmapLayer pointLayer;
+    PixmapLayer statusLayer;                         ///< 左上角说明文字
+    QRect pointArea;                                 ///< 插值点图层覆盖的区域
+    int layerSelection = -1;                         ///< 插值点图层对应的选中点
+    int layerCount = 0;                              ///< 插值点图层对应的点数
+    QSize layerSize;                                 ///< 插值点图层对应的窗口尺寸
+
+    SurfaceRenderer surfaceRenderer;                 ///< 折线与圆点绘制（QPainter 或 OpenGL 后端）
+    quint64 curveRevision = 0;                       ///< 曲线顶点每次重算加一，GPU 据此决定是否重新上传
+    QVector<SurfaceDisc> discBuffer;                 ///< 本帧圆点（复用缓冲区）
+
+    curvecore::DeltaJournal<Edit> journal;           ///< 撤销 / 重做（Ctrl+Z / Ctrl+Y）
+
+    // 曲线投影：悬停高亮与 Shift+双击插点
+    curvecore::ClosestPointIndex<double, 2> curveIndex;   ///< 曲线折线的层次包围盒，曲线变化后按需重建
+    bool curveIndexStale = true;
+    bool hovering = false;                           ///< 鼠标 SNAP_DISTANCE 内是否有曲线
+    QPointF hoverPoint;                              ///< 鼠标在曲线上的投影点
 
     bool draggingPoint=false;
     bool showPoints = true;
@@ -70,11 +178,67 @@ private:
 
 
     void drawPoints(QPainter &painter);
+    void drawPoint(QPainter &painter, int i, bool withDisc);
+    void drawStatusText(QPainter &painter);
+    void syncPointLayer();
     void drawTangents(QPainter &painter);              ///< 绘制当前点切线
     void drawHermiteCurve(QPainter &painter);          ///< 绘制 Hermite 曲线
+    int tessellateAdaptive();                          ///< 按段自适应细分，返回求值次数
+    curvecore::Viewport viewport() const;              ///< 曲线坐标到屏幕的变换与可见区域
+    curvecore::LodSettings lodSettings() const;
+    void drawBackgroundCurve(QPainter &painter);       ///< 绘制后台线程发布的折线
+    void drawHover(QPainter &painter);                 ///< 绘制曲线悬停标记
+
+    QPointF pointAt(int i) const;                      ///< 第 i 个插值点位置
+    QPointF tangentVector(int i) const;                ///< 第 i 个点保存的切线向量（手柄）
+    QPointF tangentAt(int i) const;                    ///< 第 i 个点实际使用的切线（用户或自动）
+    void setPointAt(int i, const QPointF &p);
+    void setTangentVector(int i, const QPointF &t, bool custom);
+
+    // 局部重绘
+    QRect pointRegion(int i) const;                     ///< 点 i 或其切线变化时需重绘的区域
+    QRegion overlayRegion() const;                      ///< 随编辑变化的说明文字与性能面板
+
+    // 段缓存维护
+    void syncSegmentCache();
+    void markSegmentsDirty(int first, int last);
+    void markPointMoved(int i);
+    void markTangentChanged(int i);
+    void onPointAppended();
+    void onPointInserted(int i);
+    void onPointRemoved(int i);
+
+    // 撤销 / 重做
+    Edit captureEdit(Edit::Kind kind, int i) const;
+    void readEditState(Edit::Kind kind, int i, double *out) const;
+    void commitEdit(Edit &edit, int mergeKey);
+    void applyEdit(const Edit &edit, bool undo);
+    void undo();
+    void redo();
+    static int mergeKey(Edit::Kind kind, int i) { return i * 8 + kind; }
+
+    // 曲线投影
+    bool projectToCurve(const QPointF &p, double &t, QPointF &onCurve);   ///< SNAP_DISTANCE 内的最近曲线点
+    void updateHover(const QPointF &p);
+    void clearHover();
+    QRect hoverRegion() const;
+    void invalidateCurveIndex();                        ///< 曲线形状变化：投影索引与悬停标记失效
+    bool insertPointOnCurve(const QPointF &p);          ///< 在 p 投影到曲线处插入插值点，没有曲线在附近时返回 false
+
+    // 后台细分
+    int tessellationWork() const;
+    bool useBackgroundTessellation() const;
+    static void buildTessellation(const TessellationJob &job, Polyline &out);
+
+    void appendToIndex(int i);                          ///< 把点 i 及其手柄加入网格索引
+    void updateIndex(int i);                            ///< 点 i 或其切线变化后更新索引
+    void removeFromIndex(int i);                        ///< 从网格索引中删除点 i
+    void insertIntoIndex(int i);                        ///< 把新插入的点 i 及其手柄加入网格索引
+    void resetIndex();                                  ///< 样条整体替换后重建网格索引
 
     void updateTangent(const QPointF &pos);             ///< 更新切线向量
     void deletePointAt(const QPointF &pos);
+    void exportWithDialog(curvecore::ExportSpacing spacing);   ///< Ctrl+E / Ctrl+Shift+E：选择文件与点数后导出
 
 };
 
@@ -1,9 +1,16 @@
 #ifndef NURBSEDITOR_H
 #define NURBSEDITOR_H
 
-#include <QWidget>
+#include "CurveSurface.h"
 #include <QVector>
 #include <QPointF>
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include "curvecore/CurveCore.h"
+#include "PixmapLayer.h"
+#include "PointGrid.h"
+#include "RenderStats.h"
 /*
  * @class NURBSEditor
  * @brief 一个可交互的 NURBS 曲线编辑器控件
@@ -11,13 +18,13 @@
  *  支持控制点权重调整、阶数设置、曲线采样精度调整以及切线控制手柄的显示与编辑。
  *功能特性包括：
  * 鼠标左键点击选择控制点，拖动移动点或调整手柄，手柄用于调整权重
- * 双击增加控制点
+ * 双击增加控制点，Shift+双击在曲线上最近处插入控制点；悬停时高亮鼠标下方的曲线点
  * 鼠标右键点击删除控制点
  * 支持调整控制点的权重、曲线阶数和采样精度
  *  支持控制点与切线手柄可视化
  *
  */
-class NURBSEditor : public QWidget
+class NURBSEditor : public CurveSurface
 {
     Q_OBJECT
 
@@ -25,6 +32,32 @@ public:
     explicit NURBSEditor(QWidget *parent = nullptr);
     ~NURBSEditor();
 
+    // 批量求值：t[0..n) ∈ [0,1]，结果以 SoA 形式写入调用方提供的 outX/outY
+    void evaluateMany(const double *t, size_t n, double *outX, double *outY) const;
+
+    // 自适应细分：按弦偏差（像素）加密急弯、稀疏直线段
+    void setAdaptiveTessellation(bool enabled);
+    void setAdaptiveTolerance(double pixels);
+    void setAdaptiveMaxDepth(int depth);
+
+    // 视口细分（LOD）：按节点区间在屏幕上的尺寸与曲率取样，视口外区间剔除；自适应细分开启时不生效
+    void setLevelOfDetail(bool enabled);
+    bool levelOfDetail() const;
+
+    // 曲线文件（.crv）：保存当前曲线；加载时内存映射文件，失败返回 false 并写入 error
+    bool saveCurve(const QString &fileName, QString *error = nullptr) const;
+    bool loadCurve(const QString &fileName, QString *error = nullptr);
+
+    // 高分辨率折线导出（.bin 为二进制，其余为文本），分块流式写出，内存占用恒定；spacing 选择参数或弧长等距
+    bool exportPolyline(const QString &fileName, qint64 samples, double tolerance = 0.0,
+                        QString *error = nullptr,
+                        curvecore::ExportSpacing spacing = curvecore::EXPORT_UNIFORM_PARAMETER) const;
+
+    // 性能统计：最近一帧与滑动窗口内的细分 / 绘制耗时、求值吞吐、缓存命中率（P 键显示面板）
+    const RenderStats &renderStats() const;
+    void setProfilingOverlay(bool visible);
+    bool profilingOverlay() const;
+
 protected:
     // QWidget 重载函数：处理绘图与交互事件
     void paintEvent(QPaintEvent *event) override;
@@ -35,33 +68,120 @@ protected:
     void mouseDoubleClickEvent(QMouseEvent *event) override;
 
 private:
-     /* 控制点数据结构，包含位置、权重、切线角度与切线手柄 */
-    struct ControlPoint {
-        QPointF position;
-        QVector<QPointF> slopeHandles;
-        double slopeAngle;
-        double weight;
-
-        ControlPoint(const QPointF &p) : position(p), slopeAngle(0.0), weight(1.0) {}
+    typedef curvecore::NurbsCurve<double, 2> Curve;
+    typedef curvecore::Polyline<double, 2> Polyline;
+
+    /* 提交给后台细分线程的不可变快照 */
+    struct TessellationJob {
+        Curve curve;
+        int resolution;
+        bool adaptive;
+        curvecore::TessellationSettings settings;
+        bool lod;
+        curvecore::Viewport viewport;
+        curvecore::LodSettings lodSettings;
+        curvecore::PrecisionSettings precision;
+    };
+    typedef curvecore::BackgroundTessellator<TessellationJob, Polyline> Tessellator;
+
+    /* 撤销日志中的一条修改：只保存变化的字段，清空是唯一需要整条拷贝的修改 */
+    struct Edit {
+        enum Kind { MOVE_POINT, SET_WEIGHT, INSERT_POINT, REMOVE_POINT, SET_DEGREE, CLEAR };
+        Kind kind = MOVE_POINT;
+        int index = -1;
+        // MOVE_POINT: x, y；SET_WEIGHT: 权重, 手柄角；INSERT/REMOVE_POINT: x, y, 权重, 手柄角（前后相同）；
+        // SET_DEGREE: 阶数
+        double before[4] = {};
+        double after[4] = {};
+        std::shared_ptr<const Curve> clearedCurve;   ///< CLEAR：清空前的曲线
+        QVector<double> clearedAngles;
+
+        void merge(const Edit &newer) { std::copy(newer.after, newer.after + 4, after); }
     };
 
     // Constants
     static const int POINT_SIZE = 14;       ///< 控制点显示大小
     static const int HANDLE_SIZE = 10;      ///< 手柄显示大小
     static const int SNAP_DISTANCE = 30;    ///< 鼠标点击判定距离
+    static const int HOVER_RADIUS = 5;      ///< 曲线悬停标记半径
+    static const int REPAINT_MARGIN = 64;   ///< 局部重绘区域外扩量，覆盖曲线线宽、点精灵与编号 / 权重标签
+    static const int STATUS_WIDTH = 420;    ///< 左上角说明文字区域（含权重、自适应顶点数等会变化的内容）
+    static const int STATUS_HEIGHT = 290;
+    static const int SPRITE_RADIUS = 12;    ///< 控制点精灵半边长，容纳阴影与描边
+    static const int MAX_DEGREE = curvecore::MAX_FIXED_DEGREE;   ///< 支持的最高阶数（对应 Key_1..Key_5，均有展开的特化求值器）
     static const double HANDLE_RADIUS;      ///< 手柄默认长度（非可视）
+    static const int BACKGROUND_WORK = 200000;   ///< 预计基函数求值次数超过此值时改由后台线程细分
 
     // State
     bool isDraggingPoint = false;                 ///< 是否处于点拖动状态
-    QVector<ControlPoint*> controlPoints;        ///< 控制点列表
-    ControlPoint* selectedPoint = nullptr;      ///< 当前选中的控制点
-    QPointF* activeSlopeHandle = nullptr;       ///< 当前选中的切线手柄
+    Curve curve;                                 ///< 控制点、权重与节点向量（SoA，curvecore）
+    QVector<double> slopeAngles;                 ///< 每个控制点的权重手柄方向（仅交互使用）
+    PointGrid pointIndex;                        ///< 控制点位置的网格索引，用于命中测试
+    int selectedPoint = -1;                      ///< 当前选中的控制点下标，-1 表示未选中
+    int activeSlopeHandle = -1;                  ///< 当前拖动的手柄（0/1），-1 表示无
     bool showControlPoints = true;                ///< 是否显示控制点及其多边形
 
 
     // Parameters
-    int degree = 3;                        ///< NURBS 曲线阶数（默认 3 次）
     int sampleResolution = 100;            ///< 曲线采样密度（影响绘制精度）
+    curvecore::PrecisionSettings precision;     ///< 绘制精度（F 切换），默认混合；导出与文件始终使用 double
+    curvecore::BasisTable<double> basisTable;   ///< 均匀采样网格上的稀疏基函数表，阶数/节点/采样密度变化时重建
+    curvecore::BasisTable<float> floatBasisTable;   ///< float / 混合精度下使用的表，两张表只保留当前精度的一张
+    curvecore::MixedNurbs<2> mixedCurve;        ///< 控制点的 float 副本与回退到 double 的节点区间
+    bool mixedCurveStale = true;                ///< 点数、阶数或精度变化后需整体重建 mixedCurve
+
+    // 曲线采样结果（SoA，float 供绘制），作为持久状态跨帧保留，只重算脏区间 [dirtyBegin, dirtyEnd)
+    QVector<float> sampleX;
+    QVector<float> sampleY;
+    int dirtyBegin = 0;
+    int dirtyEnd = 0;
+
+    // 自适应细分
+    bool adaptiveMode = false;                       ///< 是否启用自适应细分
+    curvecore::TessellationSettings adaptiveSettings;   ///< 容差与最大深度
+    QVector<double> adaptiveX;                       ///< 自适应细分得到的顶点
+    QVector<double> adaptiveY;
+
+    // 视口细分
+    bool lodMode = false;
+    Polyline lodLine;                                ///< 视口细分得到的顶点
+    curvecore::LodStats lodStats;                    ///< 最近一次视口细分的剔除统计
+    curvecore::BezierSegments<double, 2> bezier;     ///< 视口细分用的有理 Bézier 分解，只有视口变化时复用
+    bool bezierStale = true;                         ///< 控制点、权重或节点变化后分解已过期
+    curvecore::Viewport submittedViewport;           ///< 最近提交给后台线程的视口
+
+    // 后台细分：大曲线整条交给工作线程，paintEvent 只绘制最近一次发布的折线
+    curvecore::SnapshotPool<TessellationJob> jobPool;   ///< 复用已处理完的快照，拖动时提交不再分配
+    Tessellator backgroundTessellator;
+    bool tessellationStale = true;                   ///< 曲线或细分参数变化后尚未提交快照
+
+    RenderStats stats;                               ///< 逐帧性能统计
+    bool showProfiling = false;                      ///< 是否绘制性能面板
+
+    // 缓存图层：控制多边形与控制点只在增删点、切换选中点、窗口尺寸变化时重绘；
+    // 选中点随拖动变化，不进入图层，每帧直接绘制
+    PixmapLayer polygonLayer;
+    PixmapLayer pointLayer;
+    PixmapLayer statusLayer;                         ///< 左上角说明文字
+    PixmapLayer knotLayer;                           ///< 底部节点向量文字
+    QRect controlArea;                               ///< 控制点图层覆盖的区域
+    int layerSelection = -1;                         ///< 控制点图层对应的选中点
+    QSize layerSize;                                 ///< 控制点图层对应的窗口尺寸
+    QString knotText = "Knots: ";                    ///< 节点向量文字，节点变化时重建
+    QPixmap pointSprites[2];                         ///< 控制点精灵（普通 / 选中），含阴影与渐变
+
+    SurfaceRenderer surfaceRenderer;                 ///< 折线与圆点绘制（QPainter 或 OpenGL 后端）
+    quint64 curveRevision = 0;                       ///< 曲线顶点每次重算加一，GPU 据此决定是否重新上传
+    QVector<SurfaceDisc> discBuffer;                 ///< 本帧圆点（复用缓冲区）
+    QVector<int> hitBuffer;                          ///< 命中测试结果（复用缓冲区）
+
+    curvecore::DeltaJournal<Edit> journal;           ///< 撤销 / 重做（Ctrl+Z / Ctrl+Y）
+
+    // 曲线投影：悬停高亮与 Shift+双击插点
+    curvecore::ClosestPointIndex<double, 2> curveIndex;   ///< 曲线折线的层次包围盒，曲线变化后按需重建
+    bool curveIndexStale = true;
+    bool hovering = false;                           ///< 鼠标 SNAP_DISTANCE 内是否有曲线
+    QPointF hoverPoint;                              ///< 鼠标在曲线上的投影点
 
 
     // 控制点操作及手柄操作
@@ -69,23 +189,71 @@ private:
     bool trySelectSlopeHandle(const QPointF &p);
     void selectOrCreateControlPoint(const QPointF &p);
     void createNewControlPoint(const QPointF &p);
+    void removeControlPoint(int i);
+    void insertControlPoint(int i, const QPointF &p, double weight, double angle);
+    void eraseControlPoint(int i);
+    void clearControlPoints();
+    void resetPointIndex();
     void updateSlopeHandles(const QPointF &p);
-    void initSlopeHandles(ControlPoint &cp);
-    void updateSlopeHandlePositions(ControlPoint &cp);
-    double getCurrentAngle(const ControlPoint &cp);
-    QPointF* getOppositeHandle(ControlPoint &cp);
+    bool insertPointOnCurve(const QPointF &p);   ///< 在 p 投影到曲线处插入控制点，没有曲线在附近时返回 false
+    void exportWithDialog(curvecore::ExportSpacing spacing);
+    QPointF slopeHandlePosition(int i, int side) const;
+    QPointF controlPoint(int i) const;
+    void setControlPoint(int i, const QPointF &p);
+
+    // 撤销 / 重做
+    Edit captureEdit(Edit::Kind kind, int i) const;
+    void readEditState(Edit::Kind kind, int i, double *out) const;
+    void commitEdit(Edit &edit, int mergeKey);
+    void applyEdit(const Edit &edit, bool undo);
+    void undo();
+    void redo();
+    static int mergeKey(Edit::Kind kind, int i) { return i * 8 + kind; }
+
+    // 局部重绘
+    QRect pointRegion(int i) const;              ///< 控制点 i 变化时需重绘的区域
+    QRegion overlayRegion() const;               ///< 随编辑变化的说明文字与性能面板
 
     // 曲线绘制辅助函数
     void drawConnectionLines(QPainter &painter);
     void drawControlPoints(QPainter &painter);
+    void drawControlPoint(QPainter &painter, int idx, bool withSprite);
+    void drawStatusText(QPainter &painter);
+    const QPixmap &pointSprite(bool selected);
+    void appendControlPointDiscs(QVector<SurfaceDisc> &discs, const QPointF &center, bool selected) const;
+    void syncControlLayers();
+    void invalidateControlLayers();
     void drawSlopeHandles(QPainter &painter);
+    void drawHover(QPainter &painter);
     void drawNURBSCurve(QPainter &painter);
+    int tessellateAdaptive();                    ///< 返回求值次数
+    curvecore::Viewport viewport() const;        ///< 曲线坐标到屏幕的变换与可见区域
+    curvecore::LodSettings lodSettings() const;
+    void drawBackgroundCurve(QPainter &painter);
     void drawHermiteCurve(QPainter &painter);
 
     // NURBS 计算相关核心
     QPointF evaluateNURBS(double t) const;
-    double basisFunction(int p, int i, const QVector<double> &knots, double t) const;
-    QVector<double> generateKnots() const;
+    void onKnotsChanged();
+    void updateBasisTable();
+    bool usesFloatTable() const { return precision.mode != curvecore::PRECISION_DOUBLE; }
+    bool basisTableMatches() const;
+    int basisSampleCount() const;
+    void setPrecision(curvecore::EvalPrecision mode);
+    void evaluateSamples(int begin, int end);
+    void markSamplesDirty(int i);
+    void markAllSamplesDirty();
+
+    // 曲线投影
+    bool projectToCurve(const QPointF &p, double &t, QPointF &onCurve);   ///< SNAP_DISTANCE 内的最近曲线点
+    void updateHover(const QPointF &p);
+    void clearHover();
+    QRect hoverRegion() const;
+
+    // 后台细分
+    int tessellationWork() const;
+    bool useBackgroundTessellation() const;
+    static void buildTessellation(const TessellationJob &job, Polyline &out);
 };
 
 #endif // NURBSEDITOR_H
@@ -0,0 +1,66 @@
+/**
+ * @file PixmapLayer.h
+ * @brief 离屏缓存图层
+ *
+ * 把很少变化的内容（说明文字、控制多边形、控制点精灵等）画进 QPixmap，
+ * 之后每帧只需一次 drawPixmap。内容失效、覆盖区域或设备像素比变化时才重新绘制。
+ */
+#ifndef PIXMAPLAYER_H
+#define PIXMAPLAYER_H
+
+#include <QPainter>
+#include <QPixmap>
+#include <QRect>
+#include <QString>
+
+class PixmapLayer
+{
+public:
+    void invalidate() { valid = false; }
+    bool isValid() const { return valid; }
+
+    /**
+     * @brief 以字符串标识内容（如说明文字本身），与上次不同时失效
+     */
+    void setKey(const QString &key)
+    {
+        if (key == contentKey) return;
+        contentKey = key;
+        valid = false;
+    }
+
+    /**
+     * @brief 把图层合成到 painter 上，必要时先调用 paint 重绘缓存
+     * @param area  图层覆盖的窗口区域（逻辑坐标）
+     * @param dpr   设备像素比，保证高分屏下缓存与直接绘制同样清晰
+     * @param paint 绘制函数 void(QPainter &)，使用窗口坐标，超出 area 的部分被裁掉
+     */
+    template <typename Paint>
+    void draw(QPainter &painter, const QRect &area, qreal dpr, Paint paint)
+    {
+        if (area.isEmpty()) return;
+
+        if (!valid || area != cachedArea || dpr != pixmap.devicePixelRatio()) {
+            pixmap = QPixmap(area.size() * dpr);
+            pixmap.setDevicePixelRatio(dpr);
+            pixmap.fill(Qt::transparent);
+
+            QPainter layer(&pixmap);
+            layer.setRenderHint(QPainter::Antialiasing);
+            layer.translate(-area.topLeft());
+            paint(layer);
+
+            cachedArea = area;
+            valid = true;
+        }
+        painter.drawPixmap(area.topLeft(), pixmap);
+    }
+
+private:
+    QPixmap pixmap;
+    QRect cachedArea;
+    QString contentKey;
+    bool valid = false;
+};
+
+#endif // PIXMAPLAYER_H
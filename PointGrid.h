@@ -0,0 +1,53 @@
+/**
+ * @file PointGrid.h
+ * @brief 点拾取用的均匀网格空间索引
+ *
+ * 按固定边长把平面划分为网格，每个格子记录落在其中的点编号。
+ * 命中测试只需检查查询半径覆盖的少数格子，平均 O(1)。
+ * 点编号与编辑器中的数组下标一致：插入/删除时其后的编号随之平移。
+ */
+#ifndef POINTGRID_H
+#define POINTGRID_H
+
+#include <QHash>
+#include <QVector>
+
+class PointGrid
+{
+public:
+    explicit PointGrid(double cellSize = 32.0);
+
+    void clear();
+    int size() const { return px.size(); }
+
+    void append(double x, double y);               ///< 追加点，编号为 size()
+    void insert(int id, double x, double y);       ///< 在 id 处插入，其后编号加一
+    void removeAt(int id);                         ///< 删除 id，其后编号减一
+    void move(int id, double x, double y);         ///< 更新点位置
+
+    /**
+     * @brief 距 (x,y) 小于 radius 的点中编号最小者，没有则返回 -1
+     *        与按数组顺序线性扫描取第一个命中的结果一致
+     */
+    int firstWithin(double x, double y, double radius) const;
+
+    /**
+     * @brief 收集距 (x,y) 小于 radius 的全部点编号（无序）
+     */
+    void queryWithin(double x, double y, double radius, QVector<int> &out) const;
+
+private:
+    qint64 cellKey(double x, double y) const;
+    static qint64 packKey(int ix, int iy);
+    void addToCell(qint64 key, int id);
+    void removeFromCell(qint64 key, int id);
+    void shiftIds(int from, int delta);
+
+    double cellSize;
+    QVector<double> px;                     ///< 点 x 坐标（按编号）
+    QVector<double> py;                     ///< 点 y 坐标（按编号）
+    QVector<qint64> cellOf;                 ///< 点所在格子
+    QHash<qint64, QVector<int>> cells;      ///< 格子 -> 点编号
+};
+
+#endif // POINTGRID_H
@@ -0,0 +1,69 @@
+/**
+ * @file RenderStats.h
+ * @brief 编辑器逐帧性能统计与性能面板（HUD）
+ *
+ * 每帧记录 paintEvent 总耗时、其中曲线采样 / 细分的耗时、绘制的顶点数、
+ * 新求值的样本数与复用缓存的样本数。最近 WINDOW 帧保存在环形缓冲区中，
+ * 用于计算求值吞吐与缓存命中率，区分慢在求值还是慢在 QPainter 光栅化。
+ */
+#ifndef RENDERSTATS_H
+#define RENDERSTATS_H
+
+#include <QElapsedTimer>
+#include <QVector>
+
+class QPainter;
+class QRect;
+
+/**
+ * @struct FrameStats
+ * @brief 单帧统计，时间单位为毫秒
+ */
+struct FrameStats {
+    double frameMs = 0.0;          ///< 整个 paintEvent 耗时
+    double tessellationMs = 0.0;   ///< GUI 线程上的采样 / 细分耗时
+    double drawMs = 0.0;           ///< 其余绘制耗时（frameMs - tessellationMs）
+    qint64 samples = 0;            ///< 绘制的折线顶点数
+    qint64 evaluations = 0;        ///< 本帧新求值的样本数
+    qint64 cacheHits = 0;          ///< 本帧直接复用缓存的样本数
+    bool background = false;       ///< 折线来自后台细分线程（求值不在本帧）
+};
+
+class RenderStats
+{
+public:
+    static const int WINDOW = 60;  ///< 滑动窗口帧数
+
+    RenderStats();
+
+    void beginFrame();
+    void beginTessellation();
+    void endTessellation(qint64 samples, qint64 evaluations, qint64 cacheHits, bool background = false);
+    void endFrame();
+
+    const FrameStats &lastFrame() const { return last; }
+    qint64 frameCount() const { return frames; }
+
+    FrameStats average() const;            ///< 窗口内各项的平均值
+    double evaluationsPerSecond() const;   ///< 窗口内求值总数 / 细分总耗时
+    double cacheHitRate() const;           ///< 窗口内命中样本占比，[0,1]
+
+    void reset();
+
+    /**
+     * @brief 在 area 右上角绘制性能面板
+     */
+    void drawOverlay(QPainter &painter, const QRect &area) const;
+    QRect overlayRect(const QRect &area) const;    ///< 面板占据的区域，局部重绘时并入
+
+private:
+    QElapsedTimer frameTimer;
+    QElapsedTimer stageTimer;
+    FrameStats current;
+    FrameStats last;
+    QVector<FrameStats> history;           ///< 环形缓冲区，最多 WINDOW 帧
+    int next = 0;
+    qint64 frames = 0;
+};
+
+#endif // RENDERSTATS_H
@@ -0,0 +1,84 @@
+/**
+ * @class SceneViewer
+ * @brief 多曲线只读查看器：把多个曲线文件（.crv）载入同一个 curvecore::Scene 并平移缩放浏览
+ *
+ * 功能特点：
+ * - Ctrl+O 选择一个或多个曲线文件加入场景，NURBS 与 Hermite 可混合
+ * - 脏曲线在线程池上并行细分，绘制前按视口矩形查询层次包围盒，视口外的曲线不绘制
+ * - 悬停时拾取最近的曲线并高亮，双击在对应的编辑器中打开其文件
+ * - 左键拖动平移、滚轮缩放，R 适配全部曲线，L 切换视口细分（随缩放重新细分）
+ *
+ * 文档模型目前只读：编辑在双击打开的 NURBSEditor / HermiteEditor 中针对文件副本进行，
+ * 修改不经 Scene::editNurbs / editHermite 回写场景，保存后须重新载入才可见。
+ * 场景的脏标志只在新增曲线与视口细分（视图变化时 markAllDirty）时起作用。
+ */
+#ifndef SCENEVIEWER_H
+#define SCENEVIEWER_H
+
+#include "CurveSurface.h"
+#include <QPointF>
+#include <QStringList>
+#include <vector>
+#include "curvecore/CurveCore.h"
+#include "curvecore/Scene.h"
+
+class SceneViewer : public CurveSurface
+{
+    Q_OBJECT
+
+public:
+    explicit SceneViewer(QWidget *parent = nullptr);
+    ~SceneViewer();
+
+    // 把文件逐个加入场景；任一文件失败时返回 false，error 中每行一个失败的文件
+    bool loadCurves(const QStringList &fileNames, QString *error = nullptr);
+    void clear();
+    void fitToScene();                          ///< 缩放平移使全部曲线可见
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+    void mousePressEvent(QMouseEvent *event) override;
+    void mouseMoveEvent(QMouseEvent *event) override;
+    void mouseReleaseEvent(QMouseEvent *event) override;
+    void mouseDoubleClickEvent(QMouseEvent *event) override;
+    void wheelEvent(QWheelEvent *event) override;
+    void keyPressEvent(QKeyEvent *event) override;
+
+private:
+    typedef curvecore::Scene<double> Scene;
+
+    static const int PICK_DISTANCE = 8;         ///< 拾取半径（像素）
+    static const int FIT_MARGIN = 40;           ///< fitToScene 四周留白（像素）
+    static const int STATUS_WIDTH = 420;
+
+    Scene scene;
+    QStringList sources;                        ///< 每条曲线的来源文件，与场景下标一一对应
+    bool lodMode = false;                       ///< 是否启用视口细分
+    double tolerance = 0.25;                    ///< 弦偏差容差（像素）
+
+    // 视图变换：screen = world * scale + offset
+    double scale = 1.0;
+    QPointF offset;
+    bool panning = false;
+    QPointF panAnchor;                          ///< 上一次拖动事件的鼠标位置
+
+    int hovered = -1;                           ///< 悬停拾取到的曲线，-1 表示没有
+    std::vector<int> visible;                   ///< 本帧与视口相交的曲线（复用缓冲区）
+    int retessellated = 0;                      ///< 最近一次 update 重新细分的曲线数
+    double updateMs = 0.0;                      ///< 最近一次 update 的耗时
+
+    SurfaceRenderer surfaceRenderer;
+    quint64 drawRevision = 0;                   ///< 屏幕坐标每帧重算，每次绘制都是新顶点
+
+    curvecore::Viewport viewport() const;
+    void applySettings();                       ///< 视图或细分参数变化后更新场景设置
+    void updateScene();                         ///< 重新细分脏曲线
+    void drawCurves(QPainter &painter);
+    void drawStatusText(QPainter &painter);
+    void updateHover(const QPointF &p);
+    void openInEditor(int i);                   ///< 在对应类型的编辑器窗口中打开第 i 条曲线的文件
+    QPointF toWorld(const QPointF &p) const;
+    static bool loadInto(const QString &fileName, Scene &scene, QString *error);
+};
+
+#endif // SCENEVIEWER_H
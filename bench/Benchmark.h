@@ -0,0 +1,90 @@
+/**
+ * @file Benchmark.h
+ * @brief 轻量微基准框架（不依赖 Qt）
+ *
+ * 每个用例先倍增迭代次数直到单批耗时超过 minTime 的十分之一，再按估算的迭代次数
+ * 重复测量 repetitions 批，报告每次迭代的最小、中位与平均耗时。
+ * JSON 输出与 Google Benchmark 的格式兼容，可直接用其 compare.py 对比两次结果。
+ */
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace bench {
+
+/**
+ * @brief 阻止编译器把基准结果当作无用计算删除
+ */
+template <typename T>
+inline void doNotOptimize(const T &value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const T *sink;
+    sink = &value;
+#endif
+}
+
+/**
+ * @struct Case
+ * @brief 一个基准用例
+ */
+struct Case {
+    std::string name;                                  ///< 形如 "nurbs/evaluate/degree:3/points:1000"
+    std::function<void(std::uint64_t)> body;           ///< 执行给定次数的迭代
+    double itemsPerIteration = 1.0;                    ///< 每次迭代处理的元素数（样本、点等）
+};
+
+/**
+ * @struct Result
+ * @brief 用例的测量结果，时间单位为纳秒 / 次迭代
+ */
+struct Result {
+    std::string name;
+    std::uint64_t iterations = 0;
+    double minTime = 0.0;
+    double medianTime = 0.0;
+    double meanTime = 0.0;
+    double itemsPerSecond = 0.0;
+};
+
+class Runner
+{
+public:
+    void add(const std::string &name, std::function<void(std::uint64_t)> body,
+             double itemsPerIteration = 1.0);
+
+    void setMinTime(double seconds) { m_minTime = seconds; }
+    void setRepetitions(int repetitions) { m_repetitions = repetitions < 1 ? 1 : repetitions; }
+    void setFilter(const std::string &filter) { m_filter = filter; }
+
+    /**
+     * @brief 运行名称包含过滤串的全部用例，每个用例完成后向标准输出打印一行
+     */
+    const std::vector<Result> &run();
+
+    /**
+     * @brief 写出 Google Benchmark 兼容的 JSON
+     * @param context 附加到 context 字段的键值对（如编译器、内核等）
+     */
+    bool writeJson(const std::string &path,
+                   const std::vector<std::pair<std::string, std::string> > &context) const;
+
+private:
+    Result measure(const Case &c) const;
+
+    std::vector<Case> m_cases;
+    std::vector<Result> m_results;
+    std::string m_filter;
+    double m_minTime = 0.2;
+    int m_repetitions = 5;
+};
+
+} // namespace bench
+
+#endif // BENCHMARK_H
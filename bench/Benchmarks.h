@@ -0,0 +1,13 @@
+/**
+ * @file Benchmarks.h
+ * @brief 各组基准用例的注册入口
+ */
+#ifndef BENCHMARKS_H
+#define BENCHMARKS_H
+
+#include "Benchmark.h"
+
+void registerCoreBenchmarks(bench::Runner &runner);   ///< curvecore 求值、节点、细分（不依赖 Qt）
+void registerPaintBenchmarks(bench::Runner &runner);  ///< 编辑器离屏绘制（需要 QApplication）
+
+#endif // BENCHMARKS_H
@@ -0,0 +1,33 @@
+QT       += core gui widgets
+
+CONFIG += c++11 console
+CONFIG -= app_bundle
+
+TARGET = curvebench
+
+DEFINES += QT_DEPRECATED_WARNINGS
+
+INCLUDEPATH += $$PWD/..
+
+SOURCES += \
+    benchmark.cpp \
+    corebenchmarks.cpp \
+    main.cpp \
+    paintbenchmarks.cpp \
+    ../curvesurface.cpp \
+    ../hermiteeditor.cpp \
+    ../nurbseditor.cpp \
+    ../pointgrid.cpp \
+    ../renderstats.cpp
+
+HEADERS += \
+    Benchmark.h \
+    Benchmarks.h \
+    ../CurveSurface.h \
+    ../HermiteEditor.h \
+    ../NurbsEditor.h \
+    ../PixmapLayer.h \
+    ../PointGrid.h \
+    ../RenderStats.h
+
+include(../curvecore/curvecore.pri)
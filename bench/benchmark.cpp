@@ -0,0 +1,127 @@
+/**
+ * @file benchmark.cpp
+ * @brief 微基准框架实现：迭代次数校准、重复测量与 JSON 输出
+ */
+#include "Benchmark.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+
+namespace bench {
+
+namespace {
+
+double elapsedSeconds(const std::function<void(std::uint64_t)> &body, std::uint64_t iterations)
+{
+    auto start = std::chrono::steady_clock::now();
+    body(iterations);
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(end - start).count();
+}
+
+/**
+ * @brief JSON 字符串转义（名称只含可打印 ASCII，仍处理引号与反斜杠）
+ */
+std::string quoted(const std::string &s)
+{
+    std::string out = "\"";
+    for (char c : s) {
+        if (c == '"' || c == '\\') out += '\\';
+        out += c;
+    }
+    return out + "\"";
+}
+
+} // namespace
+
+void Runner::add(const std::string &name, std::function<void(std::uint64_t)> body,
+                 double itemsPerIteration)
+{
+    Case c;
+    c.name = name;
+    c.body = body;
+    c.itemsPerIteration = itemsPerIteration;
+    m_cases.push_back(c);
+}
+
+const std::vector<Result> &Runner::run()
+{
+    m_results.clear();
+    for (const Case &c : m_cases) {
+        if (!m_filter.empty() && c.name.find(m_filter) == std::string::npos) continue;
+
+        Result r = measure(c);
+        m_results.push_back(r);
+        std::printf("%-60s %12.1f ns %12.1f ns %12llu %14.4g items/s\n", r.name.c_str(),
+                    r.medianTime, r.minTime, static_cast<unsigned long long>(r.iterations),
+                    r.itemsPerSecond);
+        std::fflush(stdout);
+    }
+    return m_results;
+}
+
+Result Runner::measure(const Case &c) const
+{
+    // 校准：倍增迭代次数，直到单批耗时足以压过计时误差
+    std::uint64_t iterations = 1;
+    double seconds = elapsedSeconds(c.body, iterations);
+    const double batchTarget = m_minTime / m_repetitions;
+    while (seconds < batchTarget * 0.1 && iterations < (std::uint64_t(1) << 40)) {
+        iterations *= 10;
+        seconds = elapsedSeconds(c.body, iterations);
+    }
+    if (seconds > 0.0 && seconds < batchTarget)
+        iterations = std::max<std::uint64_t>(1, static_cast<std::uint64_t>(iterations * batchTarget / seconds));
+
+    std::vector<double> perIteration;
+    for (int k = 0; k < m_repetitions; ++k)
+        perIteration.push_back(elapsedSeconds(c.body, iterations) * 1e9 / iterations);
+    std::sort(perIteration.begin(), perIteration.end());
+
+    Result r;
+    r.name = c.name;
+    r.iterations = iterations;
+    r.minTime = perIteration.front();
+    r.medianTime = perIteration[perIteration.size() / 2];
+    double sum = 0.0;
+    for (double t : perIteration) sum += t;
+    r.meanTime = sum / perIteration.size();
+    r.itemsPerSecond = r.medianTime > 0.0 ? c.itemsPerIteration * 1e9 / r.medianTime : 0.0;
+    return r;
+}
+
+bool Runner::writeJson(const std::string &path,
+                       const std::vector<std::pair<std::string, std::string> > &context) const
+{
+    std::FILE *f = std::fopen(path.c_str(), "w");
+    if (!f) return false;
+
+    char date[64];
+    std::time_t now = std::time(nullptr);
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+
+    std::fprintf(f, "{\n  \"context\": {\n    \"date\": %s", quoted(date).c_str());
+    for (const auto &kv : context)
+        std::fprintf(f, ",\n    %s: %s", quoted(kv.first).c_str(), quoted(kv.second).c_str());
+    std::fprintf(f, "\n  },\n  \"benchmarks\": [");
+
+    for (size_t i = 0; i < m_results.size(); ++i) {
+        const Result &r = m_results[i];
+        std::fprintf(f, "%s\n    {\n", i ? "," : "");
+        std::fprintf(f, "      \"name\": %s,\n", quoted(r.name).c_str());
+        std::fprintf(f, "      \"run_type\": \"iteration\",\n");
+        std::fprintf(f, "      \"iterations\": %llu,\n", static_cast<unsigned long long>(r.iterations));
+        std::fprintf(f, "      \"real_time\": %.3f,\n", r.medianTime);
+        std::fprintf(f, "      \"cpu_time\": %.3f,\n", r.medianTime);
+        std::fprintf(f, "      \"min_time\": %.3f,\n", r.minTime);
+        std::fprintf(f, "      \"mean_time\": %.3f,\n", r.meanTime);
+        std::fprintf(f, "      \"time_unit\": \"ns\",\n");
+        std::fprintf(f, "      \"items_per_second\": %.6g\n    }", r.itemsPerSecond);
+    }
+    std::fprintf(f, "\n  ]\n}\n");
+    return std::fclose(f) == 0;
+}
+
+} // namespace bench
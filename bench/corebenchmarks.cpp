@@ -0,0 +1,577 @@
+/**
+ * @file corebenchmarks.cpp
+ * @brief curvecore 内核基准：单点 / 批量求值、节点向量生成、定阶与通用路径、Bézier 分解、细分
+ */
+#include "Benchmarks.h"
+
+#include <cmath>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "curvecore/CurveCore.h"
+
+namespace {
+
+typedef curvecore::NurbsCurve<double, 2> Nurbs;
+typedef curvecore::HermiteSpline<double, 2> Hermite;
+
+const int DEGREES[] = {1, 2, 3, 4, 5};
+const int CURVE_SIZES[] = {16, 256, 4096};
+const int RESOLUTIONS[] = {100, 1000, 10000};
+
+/**
+ * @brief 在 1000 x 800 画布上生成确定性的波浪形控制点，权重在 [0.5, 1.5] 内变化
+ */
+Nurbs makeNurbs(int count, int degree)
+{
+    Nurbs curve(degree);
+    std::vector<double> x(count), y(count), w(count);
+    for (int i = 0; i < count; ++i) {
+        x[i] = 1000.0 * i / (count - 1);
+        y[i] = 400.0 + 300.0 * std::sin(i * 0.7) * std::cos(i * 0.13);
+        w[i] = 1.0 + 0.5 * std::sin(i * 1.3);
+    }
+    const double *coords[2] = {x.data(), y.data()};
+    curve.assign(coords, w.data(), count);
+    return curve;
+}
+
+/**
+ * @brief 与 makeNurbs 同形的 Hermite 样条，每隔一个点给出自定义切线
+ */
+Hermite makeHermite(int count)
+{
+    Hermite spline;
+    spline.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        double p[2] = {1000.0 * i / (count - 1), 400.0 + 300.0 * std::sin(i * 0.7) * std::cos(i * 0.13)};
+        double t[2] = {40.0, 120.0 * std::cos(i * 0.7)};
+        spline.append(p, t, i % 2 == 0);
+    }
+    return spline;
+}
+
+std::vector<double> uniformParams(size_t n, double t0, double t1)
+{
+    std::vector<double> t(n);
+    for (size_t k = 0; k < n; ++k) t[k] = t0 + (t1 - t0) * k / (n - 1);
+    return t;
+}
+
+/**
+ * @brief 画布上确定性的测量点（SoA），模拟曲线附近的扫描数据
+ */
+struct Queries {
+    std::vector<double> x, y;
+};
+
+Queries makeQueries(size_t n)
+{
+    Queries q;
+    q.x.resize(n);
+    q.y.resize(n);
+    for (size_t k = 0; k < n; ++k) {
+        q.x[k] = 1000.0 * k / (n - 1);
+        q.y[k] = 400.0 + 350.0 * std::sin(k * 0.37);
+    }
+    return q;
+}
+
+/**
+ * @brief 放大 4 倍看画布中央，约四分之三的曲线落在视口外，用于视口细分的剔除路径
+ */
+curvecore::Viewport lodViewport()
+{
+    curvecore::Viewport view;
+    view.scale = 4.0;
+    view.offset[0] = -1500.0;
+    view.offset[1] = -1200.0;
+    view.width = 1000.0;
+    view.height = 800.0;
+    return view;
+}
+
+std::string label(const char *group, const char *name, const char *key, int value)
+{
+    return std::string(group) + "/" + name + "/" + key + ":" + std::to_string(value);
+}
+
+//----------------------------------------
+// NURBS
+//----------------------------------------
+
+void registerNurbs(bench::Runner &runner)
+{
+    const size_t BATCH = 4096;
+
+    for (int p : DEGREES) {
+        for (int count : CURVE_SIZES) {
+            const std::string suffix = "/degree:" + std::to_string(p) + "/points:" + std::to_string(count);
+            auto curve = std::make_shared<Nurbs>(makeNurbs(count, p));
+            auto params = std::make_shared<std::vector<double> >(
+                uniformParams(BATCH, curve->view().domainBegin(), curve->view().domainEnd()));
+
+            // 单点求值：每次调用都重新查找区间、计算基函数
+            runner.add("nurbs/evaluate" + suffix, [curve, params](std::uint64_t iterations) {
+                const curvecore::NurbsView<double, 2> v = curve->view();
+                double out[2];
+                for (std::uint64_t i = 0; i < iterations; ++i) {
+                    curvecore::evaluate(v, (*params)[i % params->size()], out);
+                    bench::doNotOptimize(out);
+                }
+            });
+
+            // 批量求值（按阶分派到定阶实现）
+            auto x = std::make_shared<std::vector<double> >(BATCH);
+            auto y = std::make_shared<std::vector<double> >(BATCH);
+            runner.add("nurbs/evaluateMany" + suffix, [curve, params, x, y](std::uint64_t iterations) {
+                double *out[2] = {x->data(), y->data()};
+                for (std::uint64_t i = 0; i < iterations; ++i) {
+                    curvecore::evaluateMany(curve->view(), params->data(), params->size(), out);
+                    bench::doNotOptimize(x->front());
+                }
+            }, BATCH);
+
+            // 解析一、二阶导数（基函数导数 + 有理求导）
+            runner.add("nurbs/evaluateDerivatives" + suffix, [curve, params](std::uint64_t iterations) {
+                const curvecore::NurbsView<double, 2> v = curve->view();
+                double out[6];
+                for (std::uint64_t i = 0; i < iterations; ++i) {
+                    curvecore::evaluateDerivatives(v, (*params)[i % params->size()], 2, out);
+                    bench::doNotOptimize(out);
+                }
+            });
+
+            // 先分解为有理 Bézier 段，每个样本只做一次 Horner；分解本身单独计时
+            runner.add("nurbs/decomposeBezier" + suffix, [curve](std::uint64_t iterations) {
+                curvecore::BezierSegments<double, 2> segments;
+                for (std::uint64_t i = 0; i < iterations; ++i) {
+                    curvecore::decomposeBezier(curve->view(), segments);
+                    bench::doNotOptimize(segments.point(0, 0)[0]);
+                }
+            }, count);
+            auto segments = std::make_shared<curvecore::BezierSegments<double, 2> >();
+            curvecore::decomposeBezier(curve->view(), *segments);
+            runner.add("nurbs/bezierEvaluateMany" + suffix, [segments, params, x, y](std::uint64_t iterations) {
+                double *out[2] = {x->data(), y->data()};
+                for (std::uint64_t i = 0; i < iterations; ++i) {
+                    segments->evaluateMany(params->data(), params->size(), out);
+                    bench::doNotOptimize(x->front());
+                }
+            }, BATCH);
+
+            // 同一批参数走通用（运行时阶数）路径，作为定阶展开的对照
+            runner.add("nurbs/evaluateManyGeneric" + suffix, [curve, params, x, y](std::uint64_t iterations) {
+                double *out[2] = {x->data(), y->data()};
+                for (std::uint64_t i = 0; i < iterations; ++i) {
+                    curvecore::evaluateManyGeneric(curve->view(), params->data(), params->size(), out);
+                    bench::doNotOptimize(x->front());
+                }
+            }, BATCH);
+        }
+    }
+
+    for (int count : CURVE_SIZES) {
+        runner.add(label("nurbs", "openUniformKnots", "points", count), [count](std::uint64_t iterations) {
+            std::vector<double> knots;
+            for (std::uint64_t i = 0; i < iterations; ++i) {
+                curvecore::openUniformKnots(count, 3, knots);
+                bench::doNotOptimize(knots.back());
+            }
+        }, count + 4);
+    }
+
+    // 基函数表：构建一次，之后每帧只做控制点组合
+    for (int res : RESOLUTIONS) {
+        auto curve = std::make_shared<Nurbs>(makeNurbs(256, 3));
+        runner.add(label("nurbs", "basisTableBuild", "resolution", res), [curve, res](std::uint64_t iterations) {
+            curvecore::BasisTable<double> table;
+            for (std::uint64_t i = 0; i < iterations; ++i) {
+                table.build(curve->view(), res);
+                bench::doNotOptimize(table.values(0)[0]);
+            }
+        }, res + 1);
+
+        auto table = std::make_shared<curvecore::BasisTable<double> >();
+        table->build(curve->view(), res);
+        auto x = std::make_shared<std::vector<double> >(res + 1);
+        auto y = std::make_shared<std::vector<double> >(res + 1);
+        runner.add(label("nurbs", "basisTableEvaluate", "resolution", res),
+                   [curve, table, x, y, res](std::uint64_t iterations) {
+            double *out[2] = {x->data(), y->data()};
+            for (std::uint64_t i = 0; i < iterations; ++i) {
+                table->evaluate(curve->view(), 0, res + 1, out);
+                bench::doNotOptimize(x->front());
+            }
+        }, res + 1);
+
+        // 编辑器默认的绘制路径：float 表 + 控制点 float 副本，输出 float 缓冲
+        auto floatTable = std::make_shared<curvecore::BasisTable<float> >();
+        floatTable->build(curve->view(), res);
+        auto mixed = std::make_shared<curvecore::MixedNurbs<2> >();
+        mixed->assign(curve->view(), curvecore::PrecisionSettings(), false);
+        auto fx = std::make_shared<std::vector<float> >(res + 1);
+        auto fy = std::make_shared<std::vector<float> >(res + 1);
+        runner.add(label("nurbs", "basisTableEvaluateMixed", "resolution", res),
+                   [curve, floatTable, mixed, fx, fy, res](std::uint64_t iterations) {
+            float *out[2] = {fx->data(), fy->data()};
+            for (std::uint64_t i = 0; i < iterations; ++i) {
+                mixed->evaluateTable(curve->view(), *floatTable, 0, res + 1, out);
+                bench::doNotOptimize(fx->front());
+            }
+        }, res + 1);
+    }
+
+    // 细分：均匀采样与按弦偏差自适应
+    for (int count : CURVE_SIZES) {
+        auto curve = std::make_shared<Nurbs>(makeNurbs(count, 3));
+        for (int res : RESOLUTIONS) {
+            runner.add(label("nurbs", "tessellateUniform", "points", count) + "/resolution:" + std::to_string(res),
+                       [curve, res](std::uint64_t iterations) {
+                curvecore::Polyline<double, 2> line;
+                for (std::uint64_t i = 0; i < iterations; ++i) {
+                    curvecore::tessellateUniform(curve->view(), res, line);
+                    bench::doNotOptimize(line.coords[0].back());
+                }
+            }, res + 1);
+        }
+        runner.add(label("nurbs", "tessellateAdaptive", "points", count), [curve](std::uint64_t iterations) {
+            curvecore::Polyline<double, 2> line;
+            curvecore::TessellationSettings settings;
+            for (std::uint64_t i = 0; i < iterations; ++i) {
+                curvecore::tessellateAdaptive(curve->view(), settings, line);
+                bench::doNotOptimize(line.coords[0].back());
+            }
+        });
+        runner.add(label("nurbs", "tessellateLod", "points", count), [curve](std::uint64_t iterations) {
+            curvecore::Polyline<double, 2> line;
+            curvecore::Viewport view = lodViewport();
+            curvecore::LodSettings settings;
+            curvecore::ScratchArena arena;      // 与编辑器相同：每帧重置的临时内存
+            for (std::uint64_t i = 0; i < iterations; ++i) {
+                curvecore::tessellateLod(curve->view(), view, settings, line, nullptr, &arena);
+                arena.reset();
+                bench::doNotOptimize(line.coords[0].back());
+            }
+        });
+        // 弧长表：建表（Gauss–Legendre 求积）与等弧长采样（每点一次查表）
+        runner.add(label("nurbs", "arcLengthBuild", "points", count), [curve](std::uint64_t iterations) {
+            curvecore::ArcLengthTable<double> table;
+            for (std::uint64_t i = 0; i < iterations; ++i) {
+                curvecore::buildArcLengthTable(curve->view(), table);
+                bench::doNotOptimize(table.length());
+            }
+        });
+        auto arcTable = std::make_shared<curvecore::ArcLengthTable<double> >();
+        curvecore::buildArcLengthTable(curve->view(), *arcTable);
+        auto arcParams = std::make_shared<std::vector<double> >(BATCH);
+        runner.add(label("nurbs", "arcLengthUniform", "points", count), [arcTable, arcParams](std::uint64_t iterations) {
+            for (std::uint64_t i = 0; i < iterations; ++i) {
+                arcTable->uniformParameters(arcParams->size(), arcParams->data());
+                bench::doNotOptimize(arcParams->front());
+            }
+        }, BATCH);
+        // 最近点投影：建索引、单点查询（半径 20）、整批查询（线程池并行，不限距离）
+        runner.add(label("nurbs", "closestPointBuild", "points", count), [curve](std::uint64_t iterations) {
+            curvecore::ClosestPointIndex<double, 2> index;
+            for (std::uint64_t i = 0; i < iterations; ++i) {
+                index.build(curve->view());
+                bench::doNotOptimize(index.vertexCount());
+            }
+        });
+        auto closestIndex = std::make_shared<curvecore::ClosestPointIndex<double, 2> >();
+        closestIndex->build(curve->view());
+        auto scanPoints = std::make_shared<Queries>(makeQueries(BATCH));
+        runner.add(label("nurbs", "closestPoint", "points", count), [curve, closestIndex, scanPoints](std::uint64_t iterations) {
+            const size_t n = scanPoints->x.size();
+            for (std::uint64_t i = 0; i < iterations; ++i) {
+                const double q[2] = {scanPoints->x[i % n], scanPoints->y[i % n]};
+                double t;
+                bench::doNotOptimize(closestIndex->closest(curve->view(), q, 20.0, t));
+                bench::doNotOptimize(t);
+            }
+        });
+        runner.add(label("nurbs", "closestMany", "points", count), [curve, closestIndex, scanPoints](std::uint64_t iterations) {
+            const double *queries[2] = {scanPoints->x.data(), scanPoints->y.data()};
+            std::vector<double> t(scanPoints->x.size());
+            for (std::uint64_t i = 0; i < iterations; ++i) {
+                closestIndex->closestMany(curve->view(), queries, t.size(), std::numeric_limits<double>::infinity(),
+                                       t.data(), nullptr, &curvecore::ThreadPool::instance());
+                bench::doNotOptimize(t.front());
+            }
+        }, BATCH);
+        // 编辑器缩放时的路径：分解结果已缓存，每次只做视口细分
+        runner.add(label("nurbs", "tessellateLodBezier", "points", count), [curve](std::uint64_t iterations) {
+            curvecore::BezierSegments<double, 2> segments;
+            curvecore::decomposeBezier(curve->view(), segments);
+            curvecore::Polyline<double, 2> line;
+            curvecore::Viewport view = lodViewport();
+            curvecore::LodSettings settings;
+            for (std::uint64_t i = 0; i < iterations; ++i) {
+                curvecore::tessellateLod(segments, view, settings, line);
+                bench::doNotOptimize(line.coords[0].back());
+            }
+        });
+    }
+}
+
+//----------------------------------------
+// Hermite
+//----------------------------------------
+
+void registerHermite(bench::Runner &runner)
+{
+    const size_t BATCH = 4096;
+    const double MAX_HERMITE_SAMPLES = 4e6;
+
+    for (int count : CURVE_SIZES) {
+        auto spline = std::make_shared<Hermite>(makeHermite(count));
+        auto params = std::make_shared<std::vector<double> >(uniformParams(BATCH, 0.0, 1.0));
+        auto x = std::make_shared<std::vector<double> >(BATCH);
+        auto y = std::make_shared<std::vector<double> >(BATCH);
+
+        runner.add(label("hermite", "evaluate", "points", count), [spline, params](std::uint64_t iterations) {
+            const curvecore::HermiteView<double, 2> v = spline->view();
+            double out[2];
+            for (std::uint64_t i = 0; i < iterations; ++i) {
+                curvecore::evaluate(v, (*params)[i % params->size()], out);
+                bench::doNotOptimize(out);
+            }
+        });
+
+        runner.add(label("hermite", "evaluateMany", "points", count), [spline, params, x, y](std::uint64_t iterations) {
+            double *out[2] = {x->data(), y->data()};
+            for (std::uint64_t i = 0; i < iterations; ++i) {
+                curvecore::evaluateMany(spline->view(), params->data(), params->size(), out);
+                bench::doNotOptimize(x->front());
+            }
+        }, BATCH);
+
+        runner.add(label("hermite", "evaluateDerivatives", "points", count), [spline, params](std::uint64_t iterations) {
+            const curvecore::HermiteView<double, 2> v = spline->view();
+            double out[6];
+            for (std::uint64_t i = 0; i < iterations; ++i) {
+                curvecore::evaluateDerivatives(v, (*params)[i % params->size()], 2, out);
+                bench::doNotOptimize(out);
+            }
+        });
+        runner.add(label("hermite", "arcLengthBuild", "points", count), [spline](std::uint64_t iterations) {
+            curvecore::ArcLengthTable<double> table;
+            for (std::uint64_t i = 0; i < iterations; ++i) {
+                curvecore::buildArcLengthTable(spline->view(), table);
+                bench::doNotOptimize(table.length());
+            }
+        });
+        auto arcTable = std::make_shared<curvecore::ArcLengthTable<double> >();
+        curvecore::buildArcLengthTable(spline->view(), *arcTable);
+        runner.add(label("hermite", "arcLengthUniform", "points", count), [arcTable, x](std::uint64_t iterations) {
+            for (std::uint64_t i = 0; i < iterations; ++i) {
+                arcTable->uniformParameters(x->size(), x->data());
+                bench::doNotOptimize(x->front());
+            }
+        }, BATCH);
+        // 最近点投影：建索引、单点查询（半径 20）、整批查询（线程池并行，不限距离）
+        runner.add(label("hermite", "closestPointBuild", "points", count), [spline](std::uint64_t iterations) {
+            curvecore::ClosestPointIndex<double, 2> index;
+            for (std::uint64_t i = 0; i < iterations; ++i) {
+                index.build(spline->view());
+                bench::doNotOptimize(index.vertexCount());
+            }
+        });
+        auto closestIndex = std::make_shared<curvecore::ClosestPointIndex<double, 2> >();
+        closestIndex->build(spline->view());
+        auto scanPoints = std::make_shared<Queries>(makeQueries(BATCH));
+        runner.add(label("hermite", "closestPoint", "points", count), [spline, closestIndex, scanPoints](std::uint64_t iterations) {
+            const size_t n = scanPoints->x.size();
+            for (std::uint64_t i = 0; i < iterations; ++i) {
+                const double q[2] = {scanPoints->x[i % n], scanPoints->y[i % n]};
+                double t;
+                bench::doNotOptimize(closestIndex->closest(spline->view(), q, 20.0, t));
+                bench::doNotOptimize(t);
+            }
+        });
+        runner.add(label("hermite", "closestMany", "points", count), [spline, closestIndex, scanPoints](std::uint64_t iterations) {
+            const double *queries[2] = {scanPoints->x.data(), scanPoints->y.data()};
+            std::vector<double> t(scanPoints->x.size());
+            for (std::uint64_t i = 0; i < iterations; ++i) {
+                closestIndex->closestMany(spline->view(), queries, t.size(), std::numeric_limits<double>::infinity(),
+                                       t.data(), nullptr, &curvecore::ThreadPool::instance());
+                bench::doNotOptimize(t.front());
+            }
+        }, BATCH);
+
+        for (int res : RESOLUTIONS) {
+            // 分辨率按段计，大曲线 × 高精度的组合（上千万样本）只会拖慢整套基准
+            if (double(res) * (count - 1) > MAX_HERMITE_SAMPLES) continue;
+            runner.add(label("hermite", "tessellateUniform", "points", count) + "/resolution:" + std::to_string(res),
+                       [spline, res](std::uint64_t iterations) {
+                curvecore::Polyline<double, 2> line;
+                for (std::uint64_t i = 0; i < iterations; ++i) {
+                    curvecore::tessellateUniform(spline->view(), res, line);
+                    bench::doNotOptimize(line.coords[0].back());
+                }
+            }, double(res) * (count - 1) + 1);
+        }
+        // 编辑器的段缓存路径：全部段按 double 与混合精度（输出 float）各采样一次
+        const int SEGMENT_RESOLUTION = 100;
+        auto segmentParams = std::make_shared<std::vector<double> >(uniformParams(SEGMENT_RESOLUTION + 1, 0.0, 1.0));
+        auto segmentList = std::make_shared<std::vector<int> >(count - 1);
+        for (int i = 0; i < count - 1; ++i) (*segmentList)[i] = i;
+        const size_t segmentSamples = size_t(count - 1) * SEGMENT_RESOLUTION + 1;
+        auto sx = std::make_shared<std::vector<double> >(segmentSamples);
+        auto sy = std::make_shared<std::vector<double> >(segmentSamples);
+        runner.add(label("hermite", "sampleSegments", "points", count) + "/precision:double",
+                   [spline, segmentParams, segmentList, sx, sy](std::uint64_t iterations) {
+            double *out[2] = {sx->data(), sy->data()};
+            for (std::uint64_t i = 0; i < iterations; ++i) {
+                curvecore::parallelSampleSegments(curvecore::ThreadPool::instance(), spline->view(),
+                                                  segmentList->data(), segmentList->size(),
+                                                  segmentParams->data(), SEGMENT_RESOLUTION, out);
+                bench::doNotOptimize(sx->front());
+            }
+        }, segmentSamples);
+        auto fx = std::make_shared<std::vector<float> >(segmentSamples);
+        auto fy = std::make_shared<std::vector<float> >(segmentSamples);
+        runner.add(label("hermite", "sampleSegments", "points", count) + "/precision:mixed",
+                   [spline, segmentParams, segmentList, fx, fy](std::uint64_t iterations) {
+            float *out[2] = {fx->data(), fy->data()};
+            const curvecore::PrecisionSettings settings;
+            for (std::uint64_t i = 0; i < iterations; ++i) {
+                curvecore::parallelSampleSegments(curvecore::ThreadPool::instance(), spline->view(),
+                                                  segmentList->data(), segmentList->size(),
+                                                  segmentParams->data(), SEGMENT_RESOLUTION, out, settings);
+                bench::doNotOptimize(fx->front());
+            }
+        }, segmentSamples);
+
+        runner.add(label("hermite", "tessellateAdaptive", "points", count), [spline](std::uint64_t iterations) {
+            curvecore::Polyline<double, 2> line;
+            curvecore::TessellationSettings settings;
+            for (std::uint64_t i = 0; i < iterations; ++i) {
+                curvecore::tessellateAdaptive(spline->view(), settings, line);
+                bench::doNotOptimize(line.coords[0].back());
+            }
+        });
+        runner.add(label("hermite", "tessellateLod", "points", count), [spline](std::uint64_t iterations) {
+            curvecore::Polyline<double, 2> line;
+            curvecore::Viewport view = lodViewport();
+            curvecore::LodSettings settings;
+            curvecore::ScratchArena arena;      // 与编辑器相同：每帧重置的临时内存
+            for (std::uint64_t i = 0; i < iterations; ++i) {
+                curvecore::tessellateLod(spline->view(), view, settings, line, nullptr, &arena);
+                arena.reset();
+                bench::doNotOptimize(line.coords[0].back());
+            }
+        });
+    }
+
+    // 单段三次多项式内核：运行时选择的 SIMD 实现与标量实现对照
+    const double coeffs[4] = {1.0, -2.5, 3.25, 0.75};
+    auto s = std::make_shared<std::vector<double> >(uniformParams(BATCH, 0.0, 1.0));
+    auto out = std::make_shared<std::vector<double> >(BATCH);
+    runner.add(std::string("hermite/sampleCubic/kernel:") + curvecore::cubicKernelName(),
+               [coeffs, s, out](std::uint64_t iterations) {
+        for (std::uint64_t i = 0; i < iterations; ++i) {
+            curvecore::sampleCubic(coeffs, s->data(), s->size(), out->data());
+            bench::doNotOptimize(out->front());
+        }
+    }, BATCH);
+    runner.add("hermite/sampleCubic/kernel:scalar", [coeffs, s, out](std::uint64_t iterations) {
+        for (std::uint64_t i = 0; i < iterations; ++i) {
+            curvecore::kernel::sampleCubicScalar(coeffs, s->data(), s->size(), out->data());
+            bench::doNotOptimize(out->front());
+        }
+    }, BATCH);
+
+    // float 内核：每条指令处理的样本数翻倍
+    const float floatCoeffs[4] = {1.0f, -2.5f, 3.25f, 0.75f};
+    auto fs = std::make_shared<std::vector<float> >(s->begin(), s->end());
+    auto fout = std::make_shared<std::vector<float> >(BATCH);
+    runner.add(std::string("hermite/sampleCubicFloat/kernel:") + curvecore::cubicKernelName(),
+               [floatCoeffs, fs, fout](std::uint64_t iterations) {
+        for (std::uint64_t i = 0; i < iterations; ++i) {
+            curvecore::sampleCubic(floatCoeffs, fs->data(), fs->size(), fout->data());
+            bench::doNotOptimize(fout->front());
+        }
+    }, BATCH);
+}
+
+//----------------------------------------
+// 场景
+//----------------------------------------
+
+/**
+ * @brief 在 100 x 100 网格上平铺 NURBS 与 Hermite 小曲线，每条 16 个点
+ */
+std::shared_ptr<curvecore::Scene<double> > makeScene(int curves)
+{
+    auto scene = std::make_shared<curvecore::Scene<double> >();
+    const Nurbs nurbs = makeNurbs(16, 3);
+    const Hermite hermite = makeHermite(16);
+    for (int c = 0; c < curves; ++c) {
+        const double offset[2] = {1000.0 * (c % 100), 1000.0 * (c / 100)};
+        if (c % 2 == 0) {
+            int i = scene->addNurbs(nurbs);
+            Nurbs &curve = scene->editNurbs(i);
+            for (int k = 0; k < curve.size(); ++k) {
+                double p[2] = {curve.coord(0, k) + offset[0], curve.coord(1, k) + offset[1]};
+                curve.setPoint(k, p);
+            }
+        } else {
+            int i = scene->addHermite(hermite);
+            Hermite &spline = scene->editHermite(i);
+            for (int k = 0; k < spline.size(); ++k) {
+                double p[2] = {spline.coord(0, k) + offset[0], spline.coord(1, k) + offset[1]};
+                spline.setPoint(k, p);
+            }
+        }
+    }
+    scene->update(curvecore::ThreadPool::instance());
+    return scene;
+}
+
+void registerScene(bench::Runner &runner)
+{
+    const int SCENE_SIZES[] = {100, 1000, 10000};
+    for (int curves : SCENE_SIZES) {
+        auto scene = makeScene(curves);
+        runner.add(label("scene", "updateAll", "curves", curves), [scene](std::uint64_t iterations) {
+            for (std::uint64_t i = 0; i < iterations; ++i) {
+                scene->markAllDirty();
+                bench::doNotOptimize(scene->update(curvecore::ThreadPool::instance()));
+            }
+        }, curves);
+        // 拖动单条曲线的典型帧：只重新细分一条曲线并重新拟合层次包围盒
+        runner.add(label("scene", "updateOne", "curves", curves), [scene](std::uint64_t iterations) {
+            for (std::uint64_t i = 0; i < iterations; ++i) {
+                scene->markDirty(static_cast<int>(i % scene->size()));
+                bench::doNotOptimize(scene->update(curvecore::ThreadPool::instance()));
+            }
+        });
+        runner.add(label("scene", "pick", "curves", curves), [scene](std::uint64_t iterations) {
+            double distance = 0.0;
+            for (std::uint64_t i = 0; i < iterations; ++i) {
+                double x = 137.0 * (i % 997), y = 71.0 * (i % 1409);
+                bench::doNotOptimize(scene->pick(x, y, 20.0, &distance));
+            }
+        });
+        runner.add(label("scene", "query", "curves", curves), [scene](std::uint64_t iterations) {
+            std::vector<int> hits;
+            const double lo[2] = {20000.0, 20000.0}, hi[2] = {21280.0, 20800.0};
+            for (std::uint64_t i = 0; i < iterations; ++i) {
+                scene->query(lo, hi, hits);
+                bench::doNotOptimize(hits.size());
+            }
+        });
+    }
+}
+
+} // namespace
+
+void registerCoreBenchmarks(bench::Runner &runner)
+{
+    registerNurbs(runner);
+    registerHermite(runner);
+    registerScene(runner);
+}
@@ -0,0 +1,85 @@
+/**
+ * @file main.cpp
+ * @brief curvebench：curvecore 内核与编辑器绘制的微基准
+ *
+ * 用法：
+ *   curvebench [--filter 子串] [--min-time 秒] [--repetitions 次数] [--json 结果.json] [--no-paint]
+ *
+ * 无显示环境下可设置 QT_QPA_PLATFORM=offscreen 运行绘制用例。
+ */
+#include <QApplication>
+#include <QCommandLineParser>
+
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "Benchmarks.h"
+#include "curvecore/CurveCore.h"
+
+int main(int argc, char *argv[])
+{
+    QApplication app(argc, argv);
+    QApplication::setApplicationName("curvebench");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Microbenchmarks for curvecore kernels and editor painting.");
+    parser.addHelpOption();
+
+    QCommandLineOption filterOption({"f", "filter"}, "Run only benchmarks whose name contains <text>.", "text");
+    QCommandLineOption minTimeOption({"t", "min-time"}, "Minimum measuring time per benchmark.", "seconds", "0.2");
+    QCommandLineOption repetitionsOption({"r", "repetitions"}, "Measured batches per benchmark.", "count", "5");
+    QCommandLineOption jsonOption("json", "Write results as Google Benchmark compatible JSON.", "file");
+    QCommandLineOption noPaintOption("no-paint", "Skip the offscreen editor painting benchmarks.");
+    parser.addOption(filterOption);
+    parser.addOption(minTimeOption);
+    parser.addOption(repetitionsOption);
+    parser.addOption(jsonOption);
+    parser.addOption(noPaintOption);
+    parser.process(app);
+
+    bool ok = true;
+    double minTime = parser.value(minTimeOption).toDouble(&ok);
+    if (!ok || minTime <= 0.0) {
+        std::fprintf(stderr, "invalid --min-time\n");
+        return 2;
+    }
+    int repetitions = parser.value(repetitionsOption).toInt(&ok);
+    if (!ok || repetitions < 1) {
+        std::fprintf(stderr, "invalid --repetitions\n");
+        return 2;
+    }
+
+    bench::Runner runner;
+    runner.setMinTime(minTime);
+    runner.setRepetitions(repetitions);
+    runner.setFilter(parser.value(filterOption).toStdString());
+
+    registerCoreBenchmarks(runner);
+    if (!parser.isSet(noPaintOption))
+        registerPaintBenchmarks(runner);
+
+    std::printf("%-60s %15s %15s %12s\n", "benchmark", "median", "min", "iterations");
+    runner.run();
+
+    if (parser.isSet(jsonOption)) {
+        std::vector<std::pair<std::string, std::string> > context;
+        context.push_back(std::make_pair("executable", std::string("curvebench")));
+        context.push_back(std::make_pair("qt_version", std::string(qVersion())));
+        context.push_back(std::make_pair("cubic_kernel", std::string(curvecore::cubicKernelName())));
+        context.push_back(std::make_pair("num_cpus", std::to_string(std::thread::hardware_concurrency())));
+#ifdef NDEBUG
+        context.push_back(std::make_pair("library_build_type", std::string("release")));
+#else
+        context.push_back(std::make_pair("library_build_type", std::string("debug")));
+#endif
+        const QString path = parser.value(jsonOption);
+        if (!runner.writeJson(path.toLocal8Bit().constData(), context)) {
+            std::fprintf(stderr, "cannot write %s\n", path.toLocal8Bit().constData());
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,113 @@
+/**
+ * @file paintbenchmarks.cpp
+ * @brief 端到端绘制基准：把编辑器渲染到离屏 QImage，覆盖 paintEvent 中的曲线采样与绘制
+ *
+ * 曲线经 .crv 文件加载到编辑器（与用户 Ctrl+O 的路径一致），控制点规模保持在后台细分
+ * 阈值以下，使测得的时间全部落在 GUI 线程的 drawNURBSCurve / drawHermiteCurve 上。
+ */
+#include "Benchmarks.h"
+
+#include <QImage>
+#include <QTemporaryDir>
+
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <string>
+
+#include "HermiteEditor.h"
+#include "NurbsEditor.h"
+
+namespace {
+
+const int PAINT_SIZES[] = {16, 256, 1024};
+const int CANVAS_WIDTH = 1280;
+const int CANVAS_HEIGHT = 800;
+
+/**
+ * @brief 生成与 corebenchmarks 同形的曲线并写入 .crv 文件
+ */
+bool writeCurveFile(const QString &path, bool hermite, int count)
+{
+    std::FILE *file = std::fopen(path.toLocal8Bit().constData(), "wb");
+    if (!file) return false;
+
+    bool ok;
+    if (hermite) {
+        curvecore::HermiteSpline<double, 2> spline;
+        for (int i = 0; i < count; ++i) {
+            double p[2] = {100.0 + 1000.0 * i / (count - 1), 400.0 + 300.0 * std::sin(i * 0.7)};
+            double t[2] = {40.0, 120.0 * std::cos(i * 0.7)};
+            spline.append(p, t, i % 2 == 0);
+        }
+        ok = curvecore::writeHermite(spline.view(), curvecore::FileSink{file});
+    } else {
+        curvecore::NurbsCurve<double, 2> curve(3);
+        for (int i = 0; i < count; ++i) {
+            double p[2] = {100.0 + 1000.0 * i / (count - 1), 400.0 + 300.0 * std::sin(i * 0.7)};
+            curve.append(p, 1.0 + 0.5 * std::sin(i * 1.3));
+        }
+        ok = curvecore::writeNurbs(curve.view(), curvecore::FileSink{file});
+    }
+    return std::fclose(file) == 0 && ok;
+}
+
+/**
+ * @brief 注册一种编辑器的三类绘制用例
+ *
+ * - repaint：缓存已热，对应拖动之外的普通重绘
+ * - adaptive：开启自适应细分后的重绘
+ * - loadAndPaint：每次迭代重新加载文件再绘制，对应缓存全部失效后的首帧
+ */
+template <typename Editor>
+void registerEditor(bench::Runner &runner, const std::shared_ptr<QTemporaryDir> &dir,
+                    const char *name, bool hermite)
+{
+    for (int count : PAINT_SIZES) {
+        const QString path = dir->filePath(QString("%1-%2.crv").arg(name).arg(count));
+        if (!writeCurveFile(path, hermite, count)) {
+            std::fprintf(stderr, "cannot write %s\n", path.toLocal8Bit().constData());
+            continue;
+        }
+
+        auto image = std::make_shared<QImage>(CANVAS_WIDTH, CANVAS_HEIGHT, QImage::Format_ARGB32_Premultiplied);
+        const std::string suffix = "/points:" + std::to_string(count);
+
+        std::shared_ptr<Editor> uniform(new Editor);
+        uniform->resize(CANVAS_WIDTH, CANVAS_HEIGHT);
+        uniform->loadCurve(path);
+        runner.add(std::string("paint/") + name + "/repaint" + suffix, [uniform, image](std::uint64_t iterations) {
+            for (std::uint64_t i = 0; i < iterations; ++i) uniform->render(image.get());
+        });
+
+        std::shared_ptr<Editor> adaptive(new Editor);
+        adaptive->resize(CANVAS_WIDTH, CANVAS_HEIGHT);
+        adaptive->setAdaptiveTessellation(true);
+        adaptive->loadCurve(path);
+        runner.add(std::string("paint/") + name + "/adaptive" + suffix, [adaptive, image](std::uint64_t iterations) {
+            for (std::uint64_t i = 0; i < iterations; ++i) adaptive->render(image.get());
+        });
+
+        runner.add(std::string("paint/") + name + "/loadAndPaint" + suffix,
+                   [uniform, image, path, dir](std::uint64_t iterations) {
+            for (std::uint64_t i = 0; i < iterations; ++i) {
+                uniform->loadCurve(path);
+                uniform->render(image.get());
+            }
+        });
+    }
+}
+
+} // namespace
+
+void registerPaintBenchmarks(bench::Runner &runner)
+{
+    // 临时目录由 loadAndPaint 用例持有，随 Runner 一起释放
+    auto dir = std::make_shared<QTemporaryDir>();
+    if (!dir->isValid()) {
+        std::fprintf(stderr, "cannot create temporary directory, paint benchmarks skipped\n");
+        return;
+    }
+    registerEditor<NURBSEditor>(runner, dir, "nurbs", false);
+    registerEditor<HermiteEditor>(runner, dir, "hermite", true);
+}
@@ -0,0 +1,272 @@
+/**
+ * @file ArcLength.h
+ * @brief 弧长参数化：Gauss–Legendre 求积建表，按弧长反查参数
+ *
+ * 表中每个节点保存参数 t_i、累计弧长 s_i 与速度 |C'(t_i)|。相邻节点之间用三次 Hermite
+ * 插值 s(t)（端点值为 s_i，端点导数为速度），建表时在区间中点检查插值与求积的偏差，
+ * 超过容差就二分加密。之后：
+ * - lengthAt(t)：一次二分查找 + 一次三次多项式求值
+ * - parameterAt(s)：一次二分查找 + 几步 Newton（只解插值多项式，不再求曲线）
+ * - parametersAt / uniformParameters：单调输入沿表顺序推进，每点接近一次查表
+ *
+ * 建表只需要速度函数；NURBS 与 Hermite 的速度来自解析一阶导数（evaluateDerivatives）。
+ * 节点区间 / 曲线段的端点总是表中节点，导数不连续处不会落在插值区间内部。
+ */
+#ifndef CURVECORE_ARCLENGTH_H
+#define CURVECORE_ARCLENGTH_H
+
+#include "HermiteSpline.h"
+#include "NurbsCurve.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+namespace curvecore {
+
+/**
+ * @struct ArcLengthSettings
+ * @brief 弧长表参数
+ */
+struct ArcLengthSettings {
+    double tolerance = 1e-3;    ///< 每个表区间允许的弧长误差（曲线坐标单位）
+    int initialSplits = 1;      ///< 每个节点区间 / 曲线段的初始等分数
+    int maxDepth = 12;          ///< 每个初始子区间的最大二分深度
+};
+
+/**
+ * @brief [a, b] 上速度的 5 点 Gauss–Legendre 求积，对 9 次多项式精确
+ */
+template <typename T, typename Speed>
+inline T gaussLegendre5(const Speed &speed, T a, T b)
+{
+    static const T NODES[5] = { T(0), T(0.5384693101056831), T(-0.5384693101056831),
+                                T(0.9061798459386640), T(-0.9061798459386640) };
+    static const T WEIGHTS[5] = { T(0.5688888888888889), T(0.4786286704993665), T(0.4786286704993665),
+                                  T(0.2369268850561891), T(0.2369268850561891) };
+    const T half = (b - a) / 2, mid = (a + b) / 2;
+    T sum = T(0);
+    for (int i = 0; i < 5; ++i) sum += WEIGHTS[i] * speed(mid + half * NODES[i]);
+    return sum * half;
+}
+
+/**
+ * @class ArcLengthTable
+ * @brief 参数 ↔ 弧长的查找表
+ */
+template <typename T>
+class ArcLengthTable
+{
+public:
+    bool isValid() const { return m_params.size() >= 2; }
+    T length() const { return m_lengths.empty() ? T(0) : m_lengths.back(); }
+    size_t nodeCount() const { return m_params.size(); }
+    T domainBegin() const { return m_params.front(); }
+    T domainEnd() const { return m_params.back(); }
+
+    void clear()
+    {
+        m_params.clear();
+        m_lengths.clear();
+        m_speeds.clear();
+    }
+
+    /**
+     * @brief 按分段端点建表
+     * @param breaks 单调递增的分段端点（节点区间 / 曲线段），count 个
+     * @param speed  速度函数 T(T t) = |C'(t)|
+     */
+    template <typename Speed>
+    void build(const T *breaks, int count, const Speed &speed, const ArcLengthSettings &settings)
+    {
+        clear();
+        if (count < 2) return;
+
+        const T tolerance = static_cast<T>(settings.tolerance);
+        const int splits = std::max(settings.initialSplits, 1);
+        append(breaks[0], T(0), speed(breaks[0]));
+        for (int i = 0; i + 1 < count; ++i) {
+            const T a = breaks[i], b = breaks[i + 1];
+            if (!(b > a)) continue;
+            for (int k = 0; k < splits; ++k) {
+                T x0 = m_params.back();
+                T x1 = k + 1 == splits ? b : a + (b - a) * (k + 1) / splits;
+                refine(speed, x0, x1, m_speeds.back(), speed(x1), gaussLegendre5(speed, x0, x1),
+                       tolerance, settings.maxDepth);
+            }
+        }
+        if (m_params.size() < 2) clear();
+    }
+
+    /**
+     * @brief 参数 t 处的累计弧长，t 截断到定义域
+     */
+    T lengthAt(T t) const
+    {
+        if (!isValid()) return T(0);
+        t = std::min(std::max(t, domainBegin()), domainEnd());
+        size_t i = std::upper_bound(m_params.begin() + 1, m_params.end() - 1, t) - m_params.begin() - 1;
+        T h = m_params[i + 1] - m_params[i];
+        return interpolate(i, (t - m_params[i]) / h);
+    }
+
+    /**
+     * @brief 累计弧长 s 对应的参数，s 截断到 [0, length()]
+     */
+    T parameterAt(T s) const
+    {
+        if (!isValid()) return T(0);
+        s = std::min(std::max(s, T(0)), length());
+        size_t i = findInterval(s);
+        return parameterIn(i, s);
+    }
+
+    /**
+     * @brief 批量反查；s 单调递增时沿表顺序推进，不做二分查找
+     */
+    void parametersAt(const T *s, size_t n, T *out) const
+    {
+        if (!isValid()) {
+            std::fill(out, out + n, T(0));
+            return;
+        }
+        size_t i = 0;
+        const size_t last = m_lengths.size() - 2;
+        for (size_t k = 0; k < n; ++k) {
+            T target = std::min(std::max(s[k], T(0)), length());
+            if (target < m_lengths[i]) i = findInterval(target);
+            while (i < last && target > m_lengths[i + 1]) ++i;
+            out[k] = parameterIn(i, target);
+        }
+    }
+
+    /**
+     * @brief n 个弧长等距的参数（含两端）
+     */
+    void uniformParameters(size_t n, T *out) const
+    {
+        if (n == 0) return;
+        if (n == 1) {
+            out[0] = isValid() ? domainBegin() : T(0);
+            return;
+        }
+        const T total = length();
+        for (size_t k = 0; k < n; ++k) out[k] = total * static_cast<T>(k) / static_cast<T>(n - 1);
+        parametersAt(out, n, out);
+        if (isValid()) out[n - 1] = domainEnd();
+    }
+
+private:
+    void append(T t, T s, T v)
+    {
+        m_params.push_back(t);
+        m_lengths.push_back(s);
+        m_speeds.push_back(v);
+    }
+
+    /**
+     * @brief [x0, x1] 的弧长为 total；半区间求积之和与整体一致、且 Hermite 插值在中点的误差
+     *        都在容差内时接受为一个表区间，否则二分
+     */
+    template <typename Speed>
+    void refine(const Speed &speed, T x0, T x1, T v0, T v1, T total, T tolerance, int depth)
+    {
+        const T mid = (x0 + x1) / 2, h = x1 - x0;
+        const T left = gaussLegendre5(speed, x0, mid), right = gaussLegendre5(speed, mid, x1);
+        const T predicted = total / 2 + h * (v0 - v1) / 8;     // 三次 Hermite 在中点的值
+        const T error = std::max(std::abs(left + right - total), std::abs(predicted - left));
+        if (error <= tolerance || depth <= 0) {
+            append(x1, m_lengths.back() + left + right, v1);
+            return;
+        }
+        const T vm = speed(mid);
+        refine(speed, x0, mid, v0, vm, left, tolerance, depth - 1);
+        refine(speed, mid, x1, vm, v1, right, tolerance, depth - 1);
+    }
+
+    size_t findInterval(T s) const
+    {
+        size_t i = std::upper_bound(m_lengths.begin() + 1, m_lengths.end() - 1, s) - m_lengths.begin() - 1;
+        return std::min(i, m_lengths.size() - 2);
+    }
+
+    /// 区间 i 内局部参数 x ∈ [0,1] 处的三次 Hermite 弧长
+    T interpolate(size_t i, T x) const
+    {
+        const T h = m_params[i + 1] - m_params[i];
+        const T s0 = m_lengths[i], s1 = m_lengths[i + 1];
+        const T m0 = m_speeds[i] * h, m1 = m_speeds[i + 1] * h;
+        const T x2 = x * x, x3 = x2 * x;
+        return (2 * x3 - 3 * x2 + 1) * s0 + (x3 - 2 * x2 + x) * m0 + (-2 * x3 + 3 * x2) * s1 + (x3 - x2) * m1;
+    }
+
+    /**
+     * @brief 在区间 i 内解 interpolate(i, x) = s：线性插值作初值，Newton 迭代，越界时退回二分
+     */
+    T parameterIn(size_t i, T s) const
+    {
+        const T t0 = m_params[i], h = m_params[i + 1] - t0;
+        const T s0 = m_lengths[i], s1 = m_lengths[i + 1];
+        if (!(s1 > s0)) return t0;
+
+        T lo = T(0), hi = T(1);
+        T x = (s - s0) / (s1 - s0);
+        for (int iteration = 0; iteration < 8; ++iteration) {
+            const T f = interpolate(i, x) - s;
+            if (f == T(0)) break;
+            if (f > T(0)) hi = x;
+            else lo = x;
+
+            const T x2 = x * x;
+            const T derivative = (6 * x2 - 6 * x) * s0 + (3 * x2 - 4 * x + 1) * m_speeds[i] * h
+                               + (-6 * x2 + 6 * x) * s1 + (3 * x2 - 2 * x) * m_speeds[i + 1] * h;
+            T next = derivative > T(0) ? x - f / derivative : (lo + hi) / 2;
+            if (!(next >= lo && next <= hi)) next = (lo + hi) / 2;
+            if (std::abs(next - x) < T(1e-12)) {
+                x = next;
+                break;
+            }
+            x = next;
+        }
+        return t0 + h * x;
+    }
+
+    std::vector<T> m_params;    ///< 节点参数
+    std::vector<T> m_lengths;   ///< 累计弧长
+    std::vector<T> m_speeds;    ///< 节点处速度 |C'(t)|
+};
+
+/**
+ * @brief 速度 |C'(t)|，由解析一阶导数得到
+ */
+template <typename T, int Dim, typename View>
+inline T curveSpeed(const View &v, T t)
+{
+    T d[2 * Dim];
+    evaluateDerivatives(v, t, 1, d);
+    T sum = T(0);
+    for (int k = 0; k < Dim; ++k) sum += d[Dim + k] * d[Dim + k];
+    return std::sqrt(sum);
+}
+
+/**
+ * @brief 曲线弧长表：以 spanBreaks 给出的节点区间 / 曲线段端点为分段端点
+ * @tparam View NurbsView 或 HermiteView
+ */
+template <typename T, int Dim, template <typename, int> class View>
+inline void buildArcLengthTable(const View<T, Dim> &v, ArcLengthTable<T> &table,
+                                const ArcLengthSettings &settings = ArcLengthSettings())
+{
+    table.clear();
+    if (!v.isValid()) return;
+
+    std::vector<T> breaks;
+    spanBreaks(v, breaks);
+    auto speed = [&v](T t) { return curveSpeed<T, Dim>(v, t); };
+    table.build(breaks.data(), static_cast<int>(breaks.size()), speed, settings);
+}
+
+} // namespace curvecore
+
+#endif // CURVECORE_ARCLENGTH_H
@@ -0,0 +1,205 @@
+/**
+ * @file BackgroundTessellator.h
+ * @brief 后台细分线程与无锁结果发布
+ *
+ * - TripleBuffer：单生产者 / 单消费者的无锁发布缓冲。生产者写后台槽位，
+ *   发布时与中间槽位原子交换；消费者取用时再与中间槽位交换。双方从不
+ *   等待对方，读取方拿到的总是最近一次完整发布的结果。
+ * - BackgroundTessellator：接收不可变输入快照，在工作线程上构建结果并发布。
+ *   工作线程忙碌期间提交的多个快照只保留最新一个（拖动时自动合并过期请求）。
+ * - SnapshotPool：复用工作线程已释放的快照对象，拖动时每帧提交快照不再分配内存。
+ */
+#ifndef CURVECORE_BACKGROUNDTESSELLATOR_H
+#define CURVECORE_BACKGROUNDTESSELLATOR_H
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace curvecore {
+
+template <typename T>
+class TripleBuffer
+{
+public:
+    /**
+     * @brief 生产者当前可写的槽位
+     */
+    T &back() { return m_slots[m_back]; }
+
+    /**
+     * @brief 发布 back()：与中间槽位交换并打上新数据标记
+     */
+    void publish()
+    {
+        int previous = m_middle.exchange(m_back | FRESH, std::memory_order_acq_rel);
+        m_back = previous & INDEX_MASK;
+    }
+
+    /**
+     * @brief 消费者取用最新发布的数据
+     * @return 有新数据时返回 true，front() 随之更新
+     */
+    bool acquire()
+    {
+        if (!(m_middle.load(std::memory_order_acquire) & FRESH)) return false;
+        int previous = m_middle.exchange(m_front, std::memory_order_acq_rel);
+        m_front = previous & INDEX_MASK;
+        return true;
+    }
+
+    /**
+     * @brief 消费者当前持有的槽位（仅消费者线程访问）
+     */
+    const T &front() const { return m_slots[m_front]; }
+
+private:
+    enum { INDEX_MASK = 3, FRESH = 4 };
+
+    T m_slots[3];
+    std::atomic<int> m_middle{1};
+    int m_front = 0;       ///< 仅消费者访问
+    int m_back = 2;        ///< 仅生产者访问
+};
+
+/**
+ * @class SnapshotPool
+ * @brief 输入快照的对象池（仅提交方线程访问）
+ *
+ * 同一时刻最多有三个快照存活：工作线程正在处理的、等待处理的、提交方正在填写的。
+ * 引用计数为 1 表示只有池本身持有，工作线程已不再读取，可以就地覆盖；
+ * 覆盖已有对象时容器成员沿用原有容量，稳定拖动中不再分配内存。
+ */
+template <typename Input>
+class SnapshotPool
+{
+public:
+    /**
+     * @brief 取一个可写的快照，调用方填写后交给 BackgroundTessellator::submit
+     */
+    std::shared_ptr<Input> acquire()
+    {
+        for (std::shared_ptr<Input> &slot : m_slots) {
+            if (slot && slot.use_count() == 1) {
+                // 与工作线程释放引用时的递减配对，保证其读取先于此后的覆盖
+                std::atomic_thread_fence(std::memory_order_acquire);
+                return slot;
+            }
+        }
+        for (std::shared_ptr<Input> &slot : m_slots) {
+            if (!slot) {
+                slot = std::make_shared<Input>();
+                return slot;
+            }
+        }
+        return std::make_shared<Input>();
+    }
+
+private:
+    std::shared_ptr<Input> m_slots[3];
+};
+
+/**
+ * @class BackgroundTessellator
+ * @tparam Input  输入快照类型，提交后不再修改
+ * @tparam Output 结果类型，须含 serial 成员
+ */
+template <typename Input, typename Output>
+class BackgroundTessellator
+{
+public:
+    typedef std::function<void(const Input &, Output &)> BuildFn;
+    typedef std::function<void()> NotifyFn;
+
+    /**
+     * @param build     在工作线程上把快照构建为结果
+     * @param published 每次发布后在工作线程上调用，通常用于通知 GUI 线程重绘
+     */
+    BackgroundTessellator(BuildFn build, NotifyFn published)
+        : m_build(build), m_published(published)
+    {
+    }
+
+    ~BackgroundTessellator()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+        }
+        m_wake.notify_one();
+        if (m_thread.joinable()) m_thread.join();
+    }
+
+    /**
+     * @brief 提交新快照，覆盖尚未开始处理的旧快照；首次调用时启动工作线程
+     * @return 分配给该快照的序号，结果的 serial 与之对应
+     */
+    unsigned long long submit(std::shared_ptr<const Input> input)
+    {
+        unsigned long long serial;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_pending = input;
+            serial = ++m_submitted;
+            if (!m_thread.joinable())
+                m_thread = std::thread(&BackgroundTessellator::workerLoop, this);
+        }
+        m_wake.notify_one();
+        return serial;
+    }
+
+    /**
+     * @brief 取用最新结果（GUI 线程调用）
+     */
+    bool acquire() { return m_buffer.acquire(); }
+    const Output &front() const { return m_buffer.front(); }
+
+    unsigned long long submittedSerial() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_submitted;
+    }
+
+private:
+    BackgroundTessellator(const BackgroundTessellator &);
+    BackgroundTessellator &operator=(const BackgroundTessellator &);
+
+    void workerLoop()
+    {
+        for (;;) {
+            std::shared_ptr<const Input> input;
+            unsigned long long serial;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_wake.wait(lock, [this] { return m_stop || m_pending; });
+                if (m_stop) return;
+                input.swap(m_pending);
+                serial = m_submitted;
+            }
+
+            Output &out = m_buffer.back();
+            m_build(*input, out);
+            out.serial = serial;
+            m_buffer.publish();
+            if (m_published) m_published();
+        }
+    }
+
+    BuildFn m_build;
+    NotifyFn m_published;
+    TripleBuffer<Output> m_buffer;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::shared_ptr<const Input> m_pending;     ///< 最新的待处理快照，处理前被覆盖即为合并
+    unsigned long long m_submitted = 0;
+    bool m_stop = false;
+    std::thread m_thread;
+};
+
+} // namespace curvecore
+
+#endif // CURVECORE_BACKGROUNDTESSELLATOR_H
@@ -0,0 +1,161 @@
+/**
+ * @file BasisTable.h
+ * @brief 均匀采样网格上的稀疏 NURBS 基函数表
+ *
+ * 每个样本记录节点区间及 p+1 个非零基函数值。基函数只取决于节点向量、
+ * 阶数与采样密度，拖动控制点或修改权重时可直接复用，只需重新加权求和。
+ * 表保存建表时的节点向量，matches() 逐个比较，调用方无需在节点变化时手动清表。
+ * 表可以由另一标量类型的曲线建立：BasisTable<float> 由 double 曲线建表时，
+ * 节点区间与基函数在 double 中求得后再存为 float，没有参数与节点的舍入误差。
+ */
+#ifndef CURVECORE_BASISTABLE_H
+#define CURVECORE_BASISTABLE_H
+
+#include "NurbsCurve.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace curvecore {
+
+template <typename T>
+class BasisTable
+{
+public:
+    int degree() const { return m_degree; }
+    int pointCount() const { return m_pointCount; }
+    int resolution() const { return m_resolution; }
+    int sampleCount() const { return static_cast<int>(m_spans.size()); }
+    int span(int k) const { return m_spans[k]; }
+    const T *values(int k) const { return &m_values[static_cast<size_t>(k) * (m_degree + 1)]; }
+    /// 样本 k 的参数（建表时定义域上的等分网格，以 double 计算）
+    double parameter(int k) const { return uniformParameter(m_domainBegin, m_domainEnd, k, m_resolution); }
+
+    /**
+     * @brief 表是否与曲线的控制点数 / 阶数 / 节点向量及给定采样密度一致
+     */
+    template <typename S, int Dim>
+    bool matches(const NurbsView<S, Dim> &v, int resolution) const
+    {
+        if (m_pointCount != v.count || m_degree != v.degree || m_resolution != resolution) return false;
+        if (!v.isValid()) return m_knots.empty();
+        const size_t knotCount = static_cast<size_t>(v.count + v.degree + 1);
+        return m_knots.size() == knotCount
+            && std::equal(m_knots.begin(), m_knots.end(), v.knots,
+                          [](double a, S b) { return a == static_cast<double>(b); });
+    }
+
+    void clear()
+    {
+        m_degree = -1;
+        m_pointCount = 0;
+        m_resolution = 0;
+        m_knots.clear();
+        m_spans.clear();
+        m_values.clear();
+    }
+
+    /**
+     * @brief 在定义域的 resolution 等分网格 t_k（k = 0..resolution）上建表
+     * @tparam S 曲线的标量类型，计算在 S 中进行，结果转换为 T 存储
+     */
+    template <typename S, int Dim>
+    void build(const NurbsView<S, Dim> &v, int resolution)
+    {
+        m_degree = v.degree;
+        m_pointCount = v.count;
+        m_resolution = resolution;
+        m_knots.clear();
+        m_spans.clear();
+        m_values.clear();
+        if (!v.isValid()) return;
+        m_knots.assign(v.knots, v.knots + v.count + v.degree + 1);
+        if (resolution < 1) return;
+        m_domainBegin = static_cast<double>(v.domainBegin());
+        m_domainEnd = static_cast<double>(v.domainEnd());
+
+        const int samples = resolution + 1;
+        const int stride = v.degree + 1;
+        m_spans.resize(samples);
+        m_values.resize(static_cast<size_t>(samples) * stride);
+
+        int span = v.degree;
+        S N[MAX_NURBS_DEGREE + 1];
+        for (int k = 0; k < samples; ++k) {
+            S t = uniformParameter(v.domainBegin(), v.domainEnd(), k, resolution);
+            if (t < v.knots[span] || t >= v.knots[span + 1])
+                span = findSpan(v.knots, v.count - 1, v.degree, t);
+            m_spans[k] = span;
+            basisFunctions(v.knots, span, v.degree, t, N);
+            std::copy(N, N + stride, &m_values[static_cast<size_t>(k) * stride]);
+        }
+    }
+
+    /**
+     * @brief 用表中的基函数对样本 [begin, end) 重新加权求和
+     *        v 须与建表时的控制点数、阶数一致；1..5 阶使用展开的特化版本
+     */
+    template <int Dim>
+    void evaluate(const NurbsView<T, Dim> &v, int begin, int end, T *const *out) const
+    {
+        DegreeDispatch<T, Dim>::combineTable(v.degree)(v, m_spans.data(), m_values.data(),
+                                                       begin, end, out);
+    }
+
+    /**
+     * @brief 输出类型与表不同（如 double 表写入 float 绘制缓冲）：分块求和到栈上临时缓冲后转换
+     */
+    template <int Dim, typename Out>
+    void evaluate(const NurbsView<T, Dim> &v, int begin, int end, Out *const *out) const
+    {
+        const int BLOCK = 256;
+        T block[Dim][BLOCK];
+        T *scratch[Dim];
+        for (int d = 0; d < Dim; ++d) scratch[d] = block[d];
+        for (int k = begin; k < end; k += BLOCK) {
+            const int m = std::min(BLOCK, end - k);
+            evaluateBlock(v, k, k + m, scratch);
+            for (int d = 0; d < Dim; ++d) std::copy(block[d], block[d] + m, out[d] + k);
+        }
+    }
+
+    /**
+     * @brief 与 evaluate 相同，但样本 k 写入 out[d][k - begin]，用于写入分块的临时缓冲
+     */
+    template <int Dim>
+    void evaluateBlock(const NurbsView<T, Dim> &v, int begin, int end, T *const *out) const
+    {
+        const size_t offset = static_cast<size_t>(begin);
+        DegreeDispatch<T, Dim>::combineTable(v.degree)(v, m_spans.data() + offset,
+                                                       m_values.data() + offset * (m_degree + 1),
+                                                       0, end - begin, out);
+    }
+
+    /**
+     * @brief 控制点 i 的支撑区间 [u_i, u_{i+p+1}) 覆盖的样本范围 [begin, end)
+     *        样本 k 受点 i 影响当且仅当 span(k) ∈ [i, i+p]
+     */
+    void supportRange(int i, int &begin, int &end) const
+    {
+        std::vector<int>::const_iterator first =
+            std::lower_bound(m_spans.begin(), m_spans.end(), i);
+        std::vector<int>::const_iterator last =
+            std::upper_bound(first, m_spans.end(), i + m_degree);
+        begin = static_cast<int>(first - m_spans.begin());
+        end = static_cast<int>(last - m_spans.begin());
+    }
+
+private:
+    int m_degree = -1;              ///< 建表时的实际阶数
+    int m_pointCount = 0;           ///< 建表时的控制点数（决定节点向量）
+    int m_resolution = 0;           ///< 建表时的采样密度
+    std::vector<double> m_knots;    ///< 建表时的节点向量，曲线无效时为空
+    double m_domainBegin = 0.0;     ///< 建表时的定义域 [u_p, u_n+1]
+    double m_domainEnd = 1.0;
+    std::vector<int> m_spans;       ///< 每个样本所在节点区间
+    std::vector<T> m_values;        ///< 每个样本的 p+1 个基函数值，按样本连续存放
+};
+
+} // namespace curvecore
+
+#endif // CURVECORE_BASISTABLE_H
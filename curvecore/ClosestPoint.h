@@ -0,0 +1,389 @@
+/**
+ * @file ClosestPoint.h
+ * @brief 点到曲线的最近点投影：折线层次包围盒粗查 + Newton 精化
+ *
+ * build() 在每个节点区间 / 曲线段内按参数等距采样，缓存顶点及其参数，
+ * 再把相邻的 leafSegments 条折线段归为一个叶节点，按曲线顺序二分建立层次包围盒。
+ * 建立时同时记录折线相对曲线的最大弦偏差 e（以各段中点估计）。查询分两步：
+ * - 粗查：按包围盒距离剪枝遍历，先访问较近的子节点；折线距离不超过最近折线距离 + 2e 的段
+ *   都可能含有真正的最近点，全部作为候选
+ * - 精化：下标连续的候选段合为一组，以组内折线距离最近处的参数为初值，用解析一、二阶导数
+ *   对 |C(t) - p|² 做 Newton 迭代，参数限制在该组两侧各延伸一段的区间内，取各组中最近的结果
+ *
+ * 同一份索引只对应建立时的曲线数据，曲线变化后须重新 build()。
+ * closestMany() 在线程池上并行处理大批查询点，各查询之间只读共享索引。
+ */
+#ifndef CURVECORE_CLOSESTPOINT_H
+#define CURVECORE_CLOSESTPOINT_H
+
+#include "HermiteSpline.h"
+#include "NurbsCurve.h"
+#include "Tessellation.h"
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+namespace curvecore {
+
+/**
+ * @struct ClosestPointSettings
+ * @brief 投影索引参数
+ */
+struct ClosestPointSettings {
+    int samplesPerSpan = 16;        ///< 每个节点区间 / 曲线段的折线段数
+    int leafSegments = 8;           ///< 每个叶节点包含的折线段数
+    int newtonIterations = 8;       ///< Newton 精化的最大迭代次数
+};
+
+/**
+ * @class ClosestPointIndex
+ * @brief 单条曲线的最近点查询结构；查询时传入建立索引时的同一个视图（NurbsView / HermiteView）
+ */
+template <typename T, int Dim>
+class ClosestPointIndex
+{
+public:
+    bool isValid() const { return !m_nodes.empty(); }
+    size_t vertexCount() const { return m_params.size(); }
+
+    void clear()
+    {
+        m_params.clear();
+        for (int d = 0; d < Dim; ++d) m_coords[d].clear();
+        m_nodes.clear();
+        m_slack = T(0);
+    }
+
+    /**
+     * @brief 采样曲线并建立层次包围盒
+     */
+    template <template <typename, int> class View>
+    void build(const View<T, Dim> &v, const ClosestPointSettings &settings = ClosestPointSettings())
+    {
+        clear();
+        if (!v.isValid()) return;
+        m_settings = settings;
+        m_settings.samplesPerSpan = std::max(m_settings.samplesPerSpan, 1);
+        m_settings.leafSegments = std::max(m_settings.leafSegments, 1);
+
+        std::vector<T> breaks;
+        spanBreaks(v, breaks);
+        const int per = m_settings.samplesPerSpan;
+        m_params.reserve((breaks.size() - 1) * per + 1);
+        m_params.push_back(breaks.front());
+        for (size_t i = 0; i + 1 < breaks.size(); ++i) {
+            const T a = breaks[i], b = breaks[i + 1];
+            for (int k = 1; k < per; ++k) m_params.push_back(a + (b - a) * k / per);
+            m_params.push_back(b);
+        }
+        if (m_params.size() < 2) {
+            clear();
+            return;
+        }
+
+        T *out[Dim];
+        for (int d = 0; d < Dim; ++d) {
+            m_coords[d].resize(m_params.size());
+            out[d] = m_coords[d].data();
+        }
+        evaluateMany(v, m_params.data(), m_params.size(), out);
+
+        // 各段中点到弦的距离，取最大值作为折线的弦偏差
+        const size_t segmentCount = m_params.size() - 1;
+        std::vector<T> mid(segmentCount), midCoords[Dim];
+        for (size_t k = 0; k < segmentCount; ++k) mid[k] = (m_params[k] + m_params[k + 1]) / 2;
+        for (int d = 0; d < Dim; ++d) {
+            midCoords[d].resize(segmentCount);
+            out[d] = midCoords[d].data();
+        }
+        evaluateMany(v, mid.data(), segmentCount, out);
+        T deviation2 = T(0);
+        for (size_t k = 0; k < segmentCount; ++k) {
+            T a[Dim], b[Dim], m[Dim];
+            for (int d = 0; d < Dim; ++d) {
+                a[d] = m_coords[d][k];
+                b[d] = m_coords[d][k + 1];
+                m[d] = midCoords[d][k];
+            }
+            deviation2 = std::max(deviation2, chordDeviation2<T, Dim>(m, a, b));
+        }
+        m_slack = 2 * std::sqrt(deviation2);
+
+        const int segments = static_cast<int>(m_params.size()) - 1;
+        m_nodes.reserve(2 * (segments / m_settings.leafSegments + 1));
+        buildNode(0, segments);
+    }
+
+    /**
+     * @brief 曲线上距 p 最近的点
+     * @param maxDistance 只接受距离不超过此值的结果，同时用于剪枝
+     * @param t           输出最近点的参数
+     * @param point       非空时输出最近点坐标
+     * @param distance    非空时输出距离
+     * @return 在 maxDistance 内找到最近点时返回 true
+     */
+    template <template <typename, int> class View>
+    bool closest(const View<T, Dim> &v, const T *p, T maxDistance, T &t, T *point = nullptr,
+                 T *distance = nullptr) const
+    {
+        if (m_nodes.empty()) return false;
+
+        // 曲线与折线相差不超过弦偏差，剪枝半径放宽 m_slack，避免漏掉半径边缘的曲线
+        const T limit = maxDistance + m_slack;
+        Candidate candidates[MAX_CANDIDATES];
+        const int count = collectCandidates(p, limit * limit, candidates);
+
+        std::sort(candidates, candidates + count, [](const Candidate &a, const Candidate &b) {
+            return a.segment < b.segment;
+        });
+
+        const int last = static_cast<int>(m_params.size()) - 1;
+        T best2 = std::numeric_limits<T>::infinity(), bestT = T(0), best[Dim] = {};
+        for (int i = 0; i < count;) {
+            // 连续的候选段 [first, end) 为一组，组内只做一次精化
+            int end = i + 1, nearest = i;
+            while (end < count && candidates[end].segment == candidates[end - 1].segment + 1) {
+                if (candidates[end].dist2 < candidates[nearest].dist2) nearest = end;
+                ++end;
+            }
+            const int first = candidates[i].segment, k = candidates[nearest].segment;
+            const T lo = m_params[std::max(first - 1, 0)];
+            const T hi = m_params[std::min(candidates[end - 1].segment + 2, last)];
+            i = end;
+
+            const T start = m_params[k] + (m_params[k + 1] - m_params[k]) * candidates[nearest].u;
+            const T refined = refine(v, p, start, lo, hi);
+
+            T c[Dim];
+            evaluate(v, refined, c);
+            T dist2 = distance2(c, p), where = refined;
+            T initial[Dim];
+            evaluate(v, start, initial);
+            if (distance2(initial, p) < dist2) {        // 精化不如初值时保留初值
+                dist2 = distance2(initial, p);
+                where = start;
+                std::copy(initial, initial + Dim, c);
+            }
+            if (dist2 < best2) {
+                best2 = dist2;
+                bestT = where;
+                std::copy(c, c + Dim, best);
+            }
+        }
+
+        if (count == 0 || best2 > maxDistance * maxDistance) return false;
+        t = bestT;
+        if (point) std::copy(best, best + Dim, point);
+        if (distance) *distance = std::sqrt(best2);
+        return true;
+    }
+
+    /**
+     * @brief 批量投影：queries[d][k] 为第 k 个查询点的第 d 维坐标
+     *        找不到时 params[k] 为定义域起点、distances[k] 为无穷大；pool 非空时并行执行
+     * @param distances 可为空
+     */
+    template <template <typename, int> class View>
+    void closestMany(const View<T, Dim> &v, const T *const *queries, size_t n, T maxDistance,
+                     T *params, T *distances = nullptr, ThreadPool *pool = nullptr) const
+    {
+        const T miss = m_params.empty() ? T(0) : m_params.front();
+        auto body = [&](size_t b, size_t e) {
+            T p[Dim];
+            for (size_t k = b; k < e; ++k) {
+                for (int d = 0; d < Dim; ++d) p[d] = queries[d][k];
+                T dist;
+                if (!closest(v, p, maxDistance, params[k], nullptr, &dist)) {
+                    params[k] = miss;
+                    dist = std::numeric_limits<T>::infinity();
+                }
+                if (distances) distances[k] = dist;
+            }
+        };
+        if (pool) pool->parallelFor(0, n, 256, body);
+        else body(0, n);
+    }
+
+private:
+    static const int STACK_SIZE = 64;       ///< 按曲线顺序二分，树深约 log2(段数)，64 层足够
+    static const int MAX_CANDIDATES = 16;   ///< 候选段上限，超出时保留折线距离最近的
+
+    struct Candidate {
+        int segment;
+        T u;                            ///< 段内最近位置 ∈ [0,1]
+        T dist2;                        ///< 到折线段的距离平方
+    };
+
+    /**
+     * @struct Node
+     * @brief 层次包围盒节点，按前序存放：左子节点紧随父节点；count > 0 为叶节点
+     */
+    struct Node {
+        T lo[Dim], hi[Dim];
+        int right;                      ///< 内部节点的右子节点下标
+        int first, count;               ///< 叶节点覆盖的折线段 [first, first + count)
+    };
+
+    int buildNode(int first, int last)
+    {
+        int index = static_cast<int>(m_nodes.size());
+        m_nodes.push_back(Node());
+        Node &node = m_nodes[index];
+        for (int d = 0; d < Dim; ++d) {
+            auto range = std::minmax_element(m_coords[d].begin() + first, m_coords[d].begin() + last + 1);
+            node.lo[d] = *range.first;
+            node.hi[d] = *range.second;
+        }
+
+        int count = last - first;
+        if (count <= m_settings.leafSegments) {
+            node.first = first;
+            node.count = count;
+            node.right = -1;
+            return index;
+        }
+
+        // push_back 可能使引用失效，子节点建好后再按下标写回
+        int mid = first + count / 2;
+        buildNode(first, mid);
+        int right = buildNode(mid, last);
+        m_nodes[index].right = right;
+        m_nodes[index].first = 0;
+        m_nodes[index].count = 0;
+        return index;
+    }
+
+    /**
+     * @brief 收集折线距离不超过 min(limit, 最近折线距离 + m_slack) 的段，返回候选数
+     * @param limit2 剪枝半径的平方
+     */
+    int collectCandidates(const T *p, T limit2, Candidate *out) const
+    {
+        int count = 0;
+        T bound2 = limit2;
+        int stack[STACK_SIZE];
+        int top = 0;
+        stack[top++] = 0;
+        while (top > 0) {
+            const int index = stack[--top];
+            const Node &node = m_nodes[index];
+            if (boxDistance2(node.lo, node.hi, p) > bound2) continue;
+            if (node.count > 0) {
+                for (int k = node.first; k < node.first + node.count; ++k) {
+                    T s;
+                    T d2 = segmentDistance2(k, p, s);
+                    if (d2 > bound2) continue;
+
+                    Candidate c = { k, s, d2 };
+                    if (count < MAX_CANDIDATES) {
+                        out[count++] = c;
+                    } else {
+                        Candidate *worst = std::max_element(out, out + count, [](const Candidate &a, const Candidate &b) {
+                            return a.dist2 < b.dist2;
+                        });
+                        if (d2 < worst->dist2) *worst = c;
+                    }
+                    const T reach = std::sqrt(d2) + m_slack;
+                    bound2 = std::min(bound2, reach * reach);
+                }
+                continue;
+            }
+            // 较近的子节点后入栈、先访问，尽早收紧剪枝半径
+            const int left = index + 1, right = node.right;
+            const T dl = boxDistance2(m_nodes[left].lo, m_nodes[left].hi, p);
+            const T dr = boxDistance2(m_nodes[right].lo, m_nodes[right].hi, p);
+            stack[top++] = dl <= dr ? right : left;
+            stack[top++] = dl <= dr ? left : right;
+        }
+
+        // 剪枝半径在遍历中逐步收紧，早先加入的候选可能已超出最终半径
+        int kept = 0;
+        for (int i = 0; i < count; ++i)
+            if (out[i].dist2 <= bound2) out[kept++] = out[i];
+        return kept;
+    }
+
+    /**
+     * @brief 点 p 到第 k 条折线段的距离平方，s ∈ [0,1] 为段内最近位置
+     */
+    T segmentDistance2(int k, const T *p, T &s) const
+    {
+        T len2 = T(0), dot = T(0);
+        for (int d = 0; d < Dim; ++d) {
+            T ab = m_coords[d][k + 1] - m_coords[d][k];
+            len2 += ab * ab;
+            dot += (p[d] - m_coords[d][k]) * ab;
+        }
+        s = len2 > T(0) ? std::min(std::max(dot / len2, T(0)), T(1)) : T(0);
+
+        T dist2 = T(0);
+        for (int d = 0; d < Dim; ++d) {
+            T e = p[d] - m_coords[d][k] - s * (m_coords[d][k + 1] - m_coords[d][k]);
+            dist2 += e * e;
+        }
+        return dist2;
+    }
+
+    /**
+     * @brief 对 f(t) = |C(t) - p|² / 2 做 Newton 迭代：t -= C'·(C-p) / (C''·(C-p) + |C'|²)
+     *        二阶项非正（p 在曲率中心外侧附近）时改用 Gauss–Newton 分母 |C'|²
+     */
+    template <template <typename, int> class View>
+    T refine(const View<T, Dim> &v, const T *p, T t, T lo, T hi) const
+    {
+        const T tolerance = (hi - lo) * std::numeric_limits<T>::epsilon() * 16;
+        for (int iteration = 0; iteration < m_settings.newtonIterations; ++iteration) {
+            T der[3 * Dim];
+            evaluateDerivatives(v, t, 2, der);
+            T gradient = T(0), speed2 = T(0), curvature = T(0);
+            for (int d = 0; d < Dim; ++d) {
+                T e = der[d] - p[d];
+                gradient += der[Dim + d] * e;
+                speed2 += der[Dim + d] * der[Dim + d];
+                curvature += der[2 * Dim + d] * e;
+            }
+            T hessian = speed2 + curvature;
+            if (!(hessian > T(0))) hessian = speed2;
+            if (!(hessian > T(0))) break;
+
+            T next = std::min(std::max(t - gradient / hessian, lo), hi);
+            if (std::abs(next - t) <= tolerance) {
+                t = next;
+                break;
+            }
+            t = next;
+        }
+        return t;
+    }
+
+    static T distance2(const T *a, const T *b)
+    {
+        T sum = T(0);
+        for (int d = 0; d < Dim; ++d) sum += (a[d] - b[d]) * (a[d] - b[d]);
+        return sum;
+    }
+
+    static T boxDistance2(const T *lo, const T *hi, const T *p)
+    {
+        T dist2 = T(0);
+        for (int d = 0; d < Dim; ++d) {
+            T e = p[d] < lo[d] ? lo[d] - p[d] : (p[d] > hi[d] ? p[d] - hi[d] : T(0));
+            dist2 += e * e;
+        }
+        return dist2;
+    }
+
+    ClosestPointSettings m_settings;
+    T m_slack = T(0);                   ///< 两倍弦偏差：折线距离与曲线距离之差的上界
+    std::vector<T> m_params;            ///< 折线顶点的曲线参数
+    std::vector<T> m_coords[Dim];       ///< 折线顶点（SoA）
+    std::vector<Node> m_nodes;
+};
+
+} // namespace curvecore
+
+#endif // CURVECORE_CLOSESTPOINT_H
@@ -0,0 +1,30 @@
+/**
+ * @file CurveCore.h
+ * @brief curvecore 库总头文件
+ *
+ * curvecore 是不依赖 Qt 的纯头文件曲线库，可被编辑器、命令行工具与基准程序共用。
+ */
+#ifndef CURVECORE_CURVECORE_H
+#define CURVECORE_CURVECORE_H
+
+#include "NurbsCurve.h"
+#include "BasisTable.h"
+#include "HermiteKernel.h"
+#include "HermiteSpline.h"
+#include "Tessellation.h"
+#include "ThreadPool.h"
+#include "ParallelSampling.h"
+#include "CurveTessellation.h"
+#include "KnotInsertion.h"
+#include "ArcLength.h"
+#include "Precision.h"
+#include "ClosestPoint.h"
+#include "LevelOfDetail.h"
+#include "BackgroundTessellator.h"
+#include "CurveFile.h"
+#include "DeltaJournal.h"
+#include "ScratchArena.h"
+#include "PolylineExporter.h"
+#include "Scene.h"
+
+#endif // CURVECORE_CURVECORE_H
@@ -0,0 +1,679 @@
+/**
+ * @file CurveFile.h
+ * @brief 分块二进制曲线文件格式（.crv）
+ *
+ * 布局（小端，所有块按 8 字节对齐）：
+ *
+ *     FileHeader (32B)
+ *     ChunkHeader (32B) + payload      ← 'KNOT' / 'COOR' / 'WGHT' / 'TANG' / 'FLAG'
+ *     ...
+ *     ChunkHeader 'END '
+ *
+ * - 每列数据（如第 d 维坐标）可以是一个块，也可以按 [first, first+count) 拆成多个块，
+ *   写入端可以边生成边输出，读取端可以逐块渐进加载
+ * - 每列只有一个块时，CurveFileView 可以直接返回指向映射内存的 NurbsView / HermiteView，
+ *   无需解析或拷贝即可求值
+ * - 读取端跳过未知块类型；版本号高于 CURVE_FILE_VERSION 的文件拒绝读取
+ * - 读取端不信任文件内容：块长度必须与元素个数一致，每列必须被完整覆盖，
+ *   NURBS 的节点向量与权重在求值前检查
+ */
+#ifndef CURVECORE_CURVEFILE_H
+#define CURVECORE_CURVEFILE_H
+
+#include "HermiteSpline.h"
+#include "NurbsCurve.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <new>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace curvecore {
+
+static const std::uint16_t CURVE_FILE_VERSION = 1;
+static const std::uint16_t CURVE_FILE_BYTE_ORDER = 0x0102;   ///< 按本机字节序写入，读取端据此识别字节序
+static const std::uint64_t CURVE_FILE_CHUNK_POINTS = 1 << 20; ///< 默认每块点数
+
+enum CurveKind {
+    CURVE_NURBS = 1,
+    CURVE_HERMITE = 2
+};
+
+inline std::uint32_t makeChunkTag(char a, char b, char c, char d)
+{
+    return std::uint32_t(std::uint8_t(a)) | std::uint32_t(std::uint8_t(b)) << 8
+         | std::uint32_t(std::uint8_t(c)) << 16 | std::uint32_t(std::uint8_t(d)) << 24;
+}
+
+static const std::uint32_t CHUNK_KNOTS = makeChunkTag('K', 'N', 'O', 'T');     ///< 节点向量
+static const std::uint32_t CHUNK_COORDS = makeChunkTag('C', 'O', 'O', 'R');    ///< 第 component 维坐标
+static const std::uint32_t CHUNK_WEIGHTS = makeChunkTag('W', 'G', 'H', 'T');   ///< 权重
+static const std::uint32_t CHUNK_TANGENTS = makeChunkTag('T', 'A', 'N', 'G');  ///< 第 component 维切线
+static const std::uint32_t CHUNK_FLAGS = makeChunkTag('F', 'L', 'A', 'G');     ///< 自定义切线标志（uint8）
+static const std::uint32_t CHUNK_END = makeChunkTag('E', 'N', 'D', ' ');
+
+/**
+ * @struct FileHeader
+ * @brief 文件头，32 字节
+ */
+struct FileHeader {
+    char magic[4];              ///< "CRVF"
+    std::uint16_t version;
+    std::uint16_t byteOrder;    ///< CURVE_FILE_BYTE_ORDER
+    std::uint8_t kind;          ///< CurveKind
+    std::uint8_t dimension;
+    std::uint8_t scalarBytes;   ///< 4 = float，8 = double
+    std::uint8_t reserved0;
+    std::int32_t degree;        ///< NURBS 实际阶数，Hermite 为 3
+    std::uint64_t count;        ///< 控制点 / 插值点数
+    std::uint64_t reserved1;
+};
+
+/**
+ * @struct ChunkHeader
+ * @brief 块头，32 字节，payload 紧随其后，长度补齐到 8 的倍数
+ */
+struct ChunkHeader {
+    std::uint32_t tag;
+    std::uint16_t component;    ///< 维度下标（COOR / TANG）
+    std::uint16_t reserved;
+    std::uint64_t first;        ///< 本块第一个元素在整列中的下标
+    std::uint64_t count;        ///< 本块元素个数
+    std::uint64_t payloadBytes; ///< payload 字节数（含补齐）
+};
+
+static_assert(sizeof(FileHeader) == 32, "FileHeader layout");
+static_assert(sizeof(ChunkHeader) == 32, "ChunkHeader layout");
+
+inline std::uint64_t paddedSize(std::uint64_t bytes) { return (bytes + 7) & ~std::uint64_t(7); }
+
+//----------------------------------------
+// 写入
+//----------------------------------------
+
+/**
+ * @class CurveWriter
+ * @brief 顺序写出文件头与数据块
+ * @tparam Sink 输出函数，签名 bool(const void *data, size_t bytes)
+ */
+template <typename Sink>
+class CurveWriter
+{
+public:
+    explicit CurveWriter(Sink sink) : m_sink(sink) {}
+
+    bool ok() const { return m_ok; }
+
+    void writeHeader(CurveKind kind, int dimension, int scalarBytes, int degree, std::uint64_t count)
+    {
+        FileHeader h;
+        std::memset(&h, 0, sizeof(h));
+        std::memcpy(h.magic, "CRVF", 4);
+        h.version = CURVE_FILE_VERSION;
+        h.byteOrder = CURVE_FILE_BYTE_ORDER;
+        h.kind = static_cast<std::uint8_t>(kind);
+        h.dimension = static_cast<std::uint8_t>(dimension);
+        h.scalarBytes = static_cast<std::uint8_t>(scalarBytes);
+        h.degree = degree;
+        h.count = count;
+        write(&h, sizeof(h));
+    }
+
+    void writeChunk(std::uint32_t tag, int component, std::uint64_t first, std::uint64_t count,
+                    const void *data, size_t elementBytes)
+    {
+        std::uint64_t bytes = count * elementBytes;
+        ChunkHeader c;
+        std::memset(&c, 0, sizeof(c));
+        c.tag = tag;
+        c.component = static_cast<std::uint16_t>(component);
+        c.first = first;
+        c.count = count;
+        c.payloadBytes = paddedSize(bytes);
+        write(&c, sizeof(c));
+        write(data, static_cast<size_t>(bytes));
+
+        static const char zeros[8] = { 0 };
+        write(zeros, static_cast<size_t>(c.payloadBytes - bytes));
+    }
+
+    /**
+     * @brief 把一列数据按 chunkPoints 拆块写出
+     */
+    template <typename T>
+    void writeColumn(std::uint32_t tag, int component, const T *data, std::uint64_t count,
+                     std::uint64_t chunkPoints)
+    {
+        if (chunkPoints == 0) chunkPoints = count ? count : 1;
+        for (std::uint64_t first = 0; first < count; first += chunkPoints) {
+            std::uint64_t n = std::min(chunkPoints, count - first);
+            writeChunk(tag, component, first, n, data + first, sizeof(T));
+        }
+    }
+
+    void writeEnd() { writeChunk(CHUNK_END, 0, 0, 0, nullptr, 1); }
+
+private:
+    void write(const void *data, size_t bytes)
+    {
+        if (m_ok && bytes > 0) m_ok = m_sink(data, bytes);
+    }
+
+    Sink m_sink;
+    bool m_ok = true;
+};
+
+template <typename Sink>
+inline CurveWriter<Sink> makeCurveWriter(Sink sink) { return CurveWriter<Sink>(sink); }
+
+/**
+ * @brief 写出 NURBS 曲线
+ * @param chunkPoints 每块点数，0 表示每列一个块（可零拷贝映射）
+ */
+template <typename T, int Dim, typename Sink>
+inline bool writeNurbs(const NurbsView<T, Dim> &v, Sink sink, std::uint64_t chunkPoints = 0)
+{
+    CurveWriter<Sink> w(sink);
+    std::uint64_t count = static_cast<std::uint64_t>(v.count);
+    w.writeHeader(CURVE_NURBS, Dim, sizeof(T), v.degree, count);
+    if (v.isValid())    // 少于两个点时没有节点向量，读取端按开放均匀节点处理
+        w.writeColumn(CHUNK_KNOTS, 0, v.knots, count + v.degree + 1, 0);
+    for (int d = 0; d < Dim; ++d)
+        w.writeColumn(CHUNK_COORDS, d, v.coords[d], count, chunkPoints);
+    w.writeColumn(CHUNK_WEIGHTS, 0, v.weights, count, chunkPoints);
+    w.writeEnd();
+    return w.ok();
+}
+
+/**
+ * @brief 写出 Hermite 样条
+ */
+template <typename T, int Dim, typename Sink>
+inline bool writeHermite(const HermiteView<T, Dim> &v, Sink sink, std::uint64_t chunkPoints = 0)
+{
+    CurveWriter<Sink> w(sink);
+    std::uint64_t count = static_cast<std::uint64_t>(v.count);
+    w.writeHeader(CURVE_HERMITE, Dim, sizeof(T), 3, count);
+    for (int d = 0; d < Dim; ++d)
+        w.writeColumn(CHUNK_COORDS, d, v.coords[d], count, chunkPoints);
+    for (int d = 0; d < Dim; ++d)
+        w.writeColumn(CHUNK_TANGENTS, d, v.tangents[d], count, chunkPoints);
+    w.writeColumn(CHUNK_FLAGS, 0, v.hasTangent, count, chunkPoints);
+    w.writeEnd();
+    return w.ok();
+}
+
+/**
+ * @brief 写入 stdio 文件的输出函数
+ */
+struct FileSink {
+    std::FILE *file;
+    bool operator()(const void *data, size_t bytes) const
+    {
+        return std::fwrite(data, 1, bytes, file) == bytes;
+    }
+};
+
+//----------------------------------------
+// 读取
+//----------------------------------------
+
+/**
+ * @brief 检查文件头，失败时写入 error
+ */
+inline bool checkHeader(const FileHeader &h, std::string *error)
+{
+    const char *message = nullptr;
+    if (std::memcmp(h.magic, "CRVF", 4) != 0) message = "not a curve file";
+    else if (h.byteOrder != CURVE_FILE_BYTE_ORDER) message = "unsupported byte order";
+    else if (h.version == 0 || h.version > CURVE_FILE_VERSION) message = "unsupported file version";
+    else if (h.kind != CURVE_NURBS && h.kind != CURVE_HERMITE) message = "unknown curve kind";
+    else if (h.dimension == 0 || (h.scalarBytes != 4 && h.scalarBytes != 8)) message = "bad dimension or scalar size";
+    else if (h.count > 0x7fffffff || h.degree < 0 || (h.kind == CURVE_NURBS && h.degree > MAX_NURBS_DEGREE))
+        message = "bad point count or degree";
+
+    if (message && error) *error = message;
+    return !message;
+}
+
+/**
+ * @brief 块的元素大小；未知块返回 0
+ */
+inline size_t chunkElementBytes(const FileHeader &h, std::uint32_t tag)
+{
+    if (tag == CHUNK_FLAGS) return 1;
+    if (tag == CHUNK_KNOTS || tag == CHUNK_COORDS || tag == CHUNK_WEIGHTS || tag == CHUNK_TANGENTS)
+        return h.scalarBytes;
+    return 0;
+}
+
+/**
+ * @brief 整列的元素个数
+ */
+inline std::uint64_t columnLength(const FileHeader &h, std::uint32_t tag)
+{
+    return tag == CHUNK_KNOTS ? h.count + h.degree + 1 : h.count;
+}
+
+/**
+ * @brief 必需列的数据至少占用的字节数（不含块头与补齐，节点向量可省略故不计入），
+ *        用于在分配内存前核对点数与文件大小
+ */
+inline std::uint64_t minimumPayloadBytes(const FileHeader &h)
+{
+    if (h.kind == CURVE_NURBS)
+        return (h.dimension + std::uint64_t(1)) * h.count * h.scalarBytes;
+    return 2 * std::uint64_t(h.dimension) * h.count * h.scalarBytes + h.count;
+}
+
+/**
+ * @brief 检查块头与文件头是否相容（下标范围、元素大小、维度）
+ *        任何块的 payload 都须补齐到 8 字节，已知块的长度须恰好为补齐后的数据长度，
+ *        否则随后的块头与列指针都会失去对齐
+ */
+inline bool checkChunk(const FileHeader &h, const ChunkHeader &c, std::string *error)
+{
+    size_t element = chunkElementBytes(h, c.tag);
+    bool ok = c.payloadBytes % 8 == 0;
+    if (ok && element > 0) {    // 未知块只检查对齐，由调用方跳过
+        ok = c.first <= columnLength(h, c.tag) && c.count <= columnLength(h, c.tag) - c.first
+          && c.payloadBytes == paddedSize(c.count * element)
+          && ((c.tag != CHUNK_COORDS && c.tag != CHUNK_TANGENTS) || c.component < h.dimension);
+    }
+    if (!ok && error) *error = "corrupt chunk";
+    return ok;
+}
+
+/**
+ * @brief 节点向量是否可用于求值：有限、非递减、每个节点重数不超过 p+1、定义域非空
+ * @param count 控制点数，节点个数为 count + p + 1
+ */
+template <typename T>
+inline bool validKnots(const T *knots, int count, int p)
+{
+    const int m = count + p + 1;
+    int multiplicity = 1;
+    for (int i = 0; i < m; ++i) {
+        if (!std::isfinite(knots[i])) return false;
+        if (i == 0) continue;
+        if (knots[i] < knots[i - 1]) return false;
+        multiplicity = knots[i] == knots[i - 1] ? multiplicity + 1 : 1;
+        if (multiplicity > p + 1) return false;
+    }
+    return knots[p] < knots[count];
+}
+
+/**
+ * @brief 权重是否全部为有限正数（零或负权重使有理求值的分母失效）
+ */
+template <typename T>
+inline bool validWeights(const T *weights, int count)
+{
+    for (int i = 0; i < count; ++i)
+        if (!(std::isfinite(weights[i]) && weights[i] > T(0))) return false;
+    return true;
+}
+
+/**
+ * @class CurveFileView
+ * @brief 对整块内存（通常是内存映射的文件）的只读解析结果，不拷贝数据
+ */
+class CurveFileView
+{
+public:
+    struct Chunk {
+        ChunkHeader header;
+        const unsigned char *payload;
+    };
+
+    /**
+     * @param data 文件内容，按 8 字节对齐（内存映射满足此条件）
+     */
+    bool open(const void *data, size_t size, std::string *error = nullptr)
+    {
+        m_chunks.clear();
+        const unsigned char *base = static_cast<const unsigned char *>(data);
+        if (size < sizeof(FileHeader)) {
+            if (error) *error = "file too small";
+            return false;
+        }
+        std::memcpy(&m_header, base, sizeof(FileHeader));
+        if (!checkHeader(m_header, error)) return false;
+        // 点数由文件头给出，后续会按它分配内存，先确认各列放得进文件
+        if (minimumPayloadBytes(m_header) > size - sizeof(FileHeader)) {
+            if (error) *error = "point count exceeds file size";
+            return false;
+        }
+
+        size_t offset = sizeof(FileHeader);
+        for (;;) {
+            if (size - offset < sizeof(ChunkHeader)) {
+                if (error) *error = "truncated file";
+                return false;
+            }
+            Chunk chunk;
+            std::memcpy(&chunk.header, base + offset, sizeof(ChunkHeader));
+            offset += sizeof(ChunkHeader);
+            if (chunk.header.tag == CHUNK_END) return true;
+
+            if (chunk.header.payloadBytes > size - offset) {
+                if (error) *error = "truncated chunk";
+                return false;
+            }
+            if (!checkChunk(m_header, chunk.header, error)) return false;
+
+            chunk.payload = base + offset;
+            offset += static_cast<size_t>(chunk.header.payloadBytes);
+            if (chunkElementBytes(m_header, chunk.header.tag) > 0)
+                m_chunks.push_back(chunk);
+        }
+    }
+
+    const FileHeader &header() const { return m_header; }
+    CurveKind kind() const { return static_cast<CurveKind>(m_header.kind); }
+    int count() const { return static_cast<int>(m_header.count); }
+    int degree() const { return m_header.degree; }
+    const std::vector<Chunk> &chunks() const { return m_chunks; }
+
+    /**
+     * @brief 整列只有一个块时返回其 payload（零拷贝），否则返回 nullptr
+     */
+    const void *contiguousColumn(std::uint32_t tag, int component) const
+    {
+        const Chunk *found = nullptr;
+        for (size_t i = 0; i < m_chunks.size(); ++i) {
+            const ChunkHeader &c = m_chunks[i].header;
+            if (c.tag != tag || c.component != component) continue;
+            if (found || c.first != 0 || c.count != columnLength(m_header, tag)) return nullptr;
+            found = &m_chunks[i];
+        }
+        return found ? found->payload : nullptr;
+    }
+
+    /**
+     * @brief 直接指向映射内存的 NURBS 视图
+     * @return 类型/维度不符或某列被拆成多块时返回 false，可改用 load() 拷贝；
+     *         节点向量或权重不可用时同样返回 false，由 load() 报告具体错误
+     */
+    template <typename T, int Dim>
+    bool nurbsView(NurbsView<T, Dim> &v) const
+    {
+        if (!matches(CURVE_NURBS, sizeof(T), Dim)) return false;
+        v.knots = static_cast<const T *>(contiguousColumn(CHUNK_KNOTS, 0));
+        v.weights = static_cast<const T *>(contiguousColumn(CHUNK_WEIGHTS, 0));
+        bool ok = v.knots && v.weights;
+        for (int d = 0; d < Dim; ++d) {
+            v.coords[d] = static_cast<const T *>(contiguousColumn(CHUNK_COORDS, d));
+            ok = ok && v.coords[d];
+        }
+        v.count = count();
+        v.degree = degree();
+        return ok && v.isValid() && validKnots(v.knots, v.count, v.degree) && validWeights(v.weights, v.count);
+    }
+
+    /**
+     * @brief 直接指向映射内存的 Hermite 视图
+     */
+    template <typename T, int Dim>
+    bool hermiteView(HermiteView<T, Dim> &v) const
+    {
+        if (!matches(CURVE_HERMITE, sizeof(T), Dim)) return false;
+        v.hasTangent = static_cast<const unsigned char *>(contiguousColumn(CHUNK_FLAGS, 0));
+        bool ok = v.hasTangent != nullptr;
+        for (int d = 0; d < Dim; ++d) {
+            v.coords[d] = static_cast<const T *>(contiguousColumn(CHUNK_COORDS, d));
+            v.tangents[d] = static_cast<const T *>(contiguousColumn(CHUNK_TANGENTS, d));
+            ok = ok && v.coords[d] && v.tangents[d];
+        }
+        v.count = count();
+        return ok;
+    }
+
+    bool matches(CurveKind kind, size_t scalarBytes, int dimension) const
+    {
+        return m_header.kind == kind && m_header.scalarBytes == scalarBytes
+            && m_header.dimension == dimension;
+    }
+
+private:
+    FileHeader m_header;
+    std::vector<Chunk> m_chunks;
+};
+
+/**
+ * @class CurveAssembler
+ * @brief 把逐块到达的数据拼装为 NurbsCurve / HermiteSpline，供内存映射与流式读取共用
+ */
+template <typename T, int Dim>
+class CurveAssembler
+{
+public:
+    bool begin(const FileHeader &h, std::string *error)
+    {
+        if (h.scalarBytes != sizeof(T) || h.dimension != Dim) {
+            if (error) *error = "scalar type or dimension mismatch";
+            return false;
+        }
+        m_header = h;
+        for (int c = 0; c < COLUMN_COUNT; ++c) m_ranges[c].clear();
+
+        // 流式输入无法预先核对文件大小，点数过大时报错而不是让异常逃出
+        size_t n = static_cast<size_t>(h.count);
+        try {
+            for (int d = 0; d < Dim; ++d) {
+                m_coords[d].assign(n, T(0));
+                m_tangents[d].assign(n, T(0));
+            }
+            m_weights.assign(n, T(1));
+            m_flags.assign(n, 0);
+            m_knots.assign(h.kind == CURVE_NURBS ? n + h.degree + 1 : 0, T(0));
+        } catch (const std::bad_alloc &) {
+            if (error) *error = "point count too large";
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief 接收一个已通过 checkChunk 的块
+     */
+    void add(const ChunkHeader &c, const void *payload)
+    {
+        size_t first = static_cast<size_t>(c.first), n = static_cast<size_t>(c.count);
+        if (n > 0) m_ranges[columnIndex(c.tag, c.component)].push_back(Range(c.first, c.count));
+        if (c.tag == CHUNK_KNOTS) {
+            std::memcpy(m_knots.data() + first, payload, n * sizeof(T));
+        } else if (c.tag == CHUNK_COORDS) {
+            std::memcpy(m_coords[c.component].data() + first, payload, n * sizeof(T));
+        } else if (c.tag == CHUNK_WEIGHTS) {
+            std::memcpy(m_weights.data() + first, payload, n * sizeof(T));
+        } else if (c.tag == CHUNK_TANGENTS) {
+            std::memcpy(m_tangents[c.component].data() + first, payload, n * sizeof(T));
+        } else if (c.tag == CHUNK_FLAGS) {
+            std::memcpy(m_flags.data() + first, payload, n);
+        }
+    }
+
+    bool finish(NurbsCurve<T, Dim> &curve, std::string *error) const
+    {
+        if (m_header.kind != CURVE_NURBS) {
+            if (error) *error = "not a NURBS curve";
+            return false;
+        }
+        bool complete = isComplete(CHUNK_WEIGHTS, 0);
+        for (int d = 0; d < Dim; ++d) complete = complete && isComplete(CHUNK_COORDS, d);
+        if (!complete) {
+            if (error) *error = "missing or incomplete curve data";
+            return false;
+        }
+        const int count = static_cast<int>(m_header.count);
+        if (!validWeights(m_weights.data(), count)) {
+            if (error) *error = "invalid weights";
+            return false;
+        }
+
+        // 节点向量可以省略（使用开放均匀节点），给出时必须完整且可用于求值
+        const bool haveKnots = !m_ranges[columnIndex(CHUNK_KNOTS, 0)].empty();
+        if (haveKnots && !(isComplete(CHUNK_KNOTS, 0) && count > m_header.degree
+                           && validKnots(m_knots.data(), count, m_header.degree))) {
+            if (error) *error = "invalid knot vector";
+            return false;
+        }
+
+        const T *coords[Dim];
+        for (int d = 0; d < Dim; ++d) coords[d] = m_coords[d].data();
+
+        curve.setDegree(m_header.degree);
+        curve.assign(coords, m_weights.data(), count);
+        if (haveKnots && !curve.setKnots(m_knots.data(), static_cast<int>(m_knots.size()))) {
+            if (error) *error = "degree does not fit point count";
+            return false;
+        }
+        return true;
+    }
+
+    bool finish(HermiteSpline<T, Dim> &spline, std::string *error) const
+    {
+        if (m_header.kind != CURVE_HERMITE) {
+            if (error) *error = "not a Hermite spline";
+            return false;
+        }
+        bool complete = isComplete(CHUNK_FLAGS, 0);
+        for (int d = 0; d < Dim; ++d)
+            complete = complete && isComplete(CHUNK_COORDS, d) && isComplete(CHUNK_TANGENTS, d);
+        if (!complete) {
+            if (error) *error = "missing or incomplete curve data";
+            return false;
+        }
+
+        const T *coords[Dim], *tangents[Dim];
+        for (int d = 0; d < Dim; ++d) {
+            coords[d] = m_coords[d].data();
+            tangents[d] = m_tangents[d].data();
+        }
+        spline.assign(coords, tangents, m_flags.data(), static_cast<int>(m_header.count));
+        return true;
+    }
+
+private:
+    typedef std::pair<std::uint64_t, std::uint64_t> Range;    ///< 块覆盖的 [first, first+count)
+    enum { COLUMN_COUNT = 3 + 2 * Dim };
+
+    /// 列编号：KNOT、WGHT、FLAG，之后是各维 COOR 与 TANG
+    static int columnIndex(std::uint32_t tag, int component)
+    {
+        if (tag == CHUNK_KNOTS) return 0;
+        if (tag == CHUNK_WEIGHTS) return 1;
+        if (tag == CHUNK_FLAGS) return 2;
+        return (tag == CHUNK_COORDS ? 3 : 3 + Dim) + component;
+    }
+
+    /**
+     * @brief 收到的块是否恰好覆盖整列：按起点排序后首尾相接，既无空洞也无重叠
+     */
+    bool isComplete(std::uint32_t tag, int component) const
+    {
+        std::vector<Range> ranges = m_ranges[columnIndex(tag, component)];
+        std::sort(ranges.begin(), ranges.end());
+        std::uint64_t next = 0;
+        for (size_t i = 0; i < ranges.size(); ++i) {
+            if (ranges[i].first != next) return false;
+            next += ranges[i].second;
+        }
+        return next == columnLength(m_header, tag);
+    }
+
+    FileHeader m_header;
+    std::vector<T> m_coords[Dim];
+    std::vector<T> m_tangents[Dim];
+    std::vector<T> m_weights;
+    std::vector<T> m_knots;
+    std::vector<unsigned char> m_flags;
+    std::vector<Range> m_ranges[COLUMN_COUNT];
+};
+
+/**
+ * @brief 从已解析的映射内存拷贝出可编辑的曲线（NurbsCurve 或 HermiteSpline）
+ */
+template <typename Curve>
+inline bool loadCurve(const CurveFileView &file, Curve &curve, std::string *error = nullptr)
+{
+    CurveAssembler<typename Curve::Scalar, Curve::Dimension> assembler;
+    if (!assembler.begin(file.header(), error)) return false;
+    for (size_t i = 0; i < file.chunks().size(); ++i)
+        assembler.add(file.chunks()[i].header, file.chunks()[i].payload);
+    return assembler.finish(curve, error);
+}
+
+/**
+ * @brief 流式读取：逐块读入并交给 handler，适合不便映射的输入（管道、网络）
+ * @param read    输入函数，签名 size_t(void *buffer, size_t bytes)，返回实际读取字节数
+ * @param onHeader 签名 bool(const FileHeader &)，返回 false 时中止
+ * @param onChunk  签名 bool(const ChunkHeader &, const void *payload)，每块到达后调用
+ */
+template <typename Read, typename OnHeader, typename OnChunk>
+inline bool streamChunks(Read read, OnHeader onHeader, OnChunk onChunk, std::string *error = nullptr)
+{
+    FileHeader h;
+    if (read(&h, sizeof(h)) != sizeof(h)) {
+        if (error) *error = "file too small";
+        return false;
+    }
+    if (!checkHeader(h, error) || !onHeader(h)) return false;
+
+    std::vector<std::uint64_t> buffer;   // 按 8 字节对齐
+    for (;;) {
+        ChunkHeader c;
+        if (read(&c, sizeof(c)) != sizeof(c)) {
+            if (error) *error = "truncated file";
+            return false;
+        }
+        if (c.tag == CHUNK_END) return true;
+        if (!checkChunk(h, c, error)) return false;
+
+        buffer.resize(static_cast<size_t>((c.payloadBytes + 7) / 8));
+        if (read(buffer.data(), static_cast<size_t>(c.payloadBytes)) != c.payloadBytes) {
+            if (error) *error = "truncated chunk";
+            return false;
+        }
+        if (chunkElementBytes(h, c.tag) > 0 && !onChunk(c, buffer.data())) return false;
+    }
+}
+
+/**
+ * @brief 流式读取整条曲线
+ * @param progress 签名 void(uint64_t loadedElements)，每块后调用，用于显示进度
+ */
+template <typename Curve, typename Read, typename Progress>
+inline bool streamCurve(Read read, Curve &curve, Progress progress, std::string *error = nullptr)
+{
+    CurveAssembler<typename Curve::Scalar, Curve::Dimension> assembler;
+    std::uint64_t loaded = 0;
+    bool ok = streamChunks(read,
+        [&](const FileHeader &h) { return assembler.begin(h, error); },
+        [&](const ChunkHeader &c, const void *payload) {
+            assembler.add(c, payload);
+            loaded += c.count;
+            progress(loaded);
+            return true;
+        }, error);
+    return ok && assembler.finish(curve, error);
+}
+
+/**
+ * @brief 从 stdio 文件读取的输入函数
+ */
+struct FileSource {
+    std::FILE *file;
+    size_t operator()(void *data, size_t bytes) const { return std::fread(data, 1, bytes, file); }
+};
+
+} // namespace curvecore
+
+#endif // CURVECORE_CURVEFILE_H
@@ -0,0 +1,149 @@
+/**
+ * @file CurveTessellation.h
+ * @brief 把整条 NURBS / Hermite 曲线离散为折线
+ *
+ * 均匀采样与 Tessellation.h 中的自适应细分，输出到 Polyline（SoA）。
+ * 与编辑器的增量缓存不同，这里每次都完整重建，供后台线程、导出等使用。
+ */
+#ifndef CURVECORE_CURVETESSELLATION_H
+#define CURVECORE_CURVETESSELLATION_H
+
+#include "HermiteSpline.h"
+#include "NurbsCurve.h"
+#include "Tessellation.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace curvecore {
+
+/**
+ * @struct Polyline
+ * @brief 折线顶点（SoA）
+ */
+template <typename T, int Dim>
+struct Polyline {
+    std::vector<T> coords[Dim];     ///< 各维顶点坐标
+    unsigned long long serial = 0;  ///< 生成该折线的输入序号，由调用方设置
+
+    size_t size() const { return coords[0].size(); }
+    bool isEmpty() const { return coords[0].empty(); }
+    void clear()
+    {
+        for (int d = 0; d < Dim; ++d) coords[d].clear();
+    }
+    void resize(size_t n)
+    {
+        for (int d = 0; d < Dim; ++d) coords[d].resize(n);
+    }
+    void append(const T *p)
+    {
+        for (int d = 0; d < Dim; ++d) coords[d].push_back(p[d]);
+    }
+};
+
+/**
+ * @brief NURBS 均匀采样：定义域 [u_p, u_n+1] 等分为 res 段，k = 0..res
+ */
+template <typename T, int Dim>
+inline void tessellateUniform(const NurbsView<T, Dim> &v, int res, Polyline<T, Dim> &out)
+{
+    out.clear();
+    if (!v.isValid() || res < 1) return;
+
+    std::vector<T> t(res + 1);
+    const T begin = v.domainBegin(), end = v.domainEnd();
+    for (int k = 0; k <= res; ++k) t[k] = uniformParameter(begin, end, k, res);
+
+    out.resize(t.size());
+    T *dst[Dim];
+    for (int d = 0; d < Dim; ++d) dst[d] = out.coords[d].data();
+    evaluateMany(v, t.data(), t.size(), dst);
+}
+
+/**
+ * @brief NURBS 自适应细分：以定义域 [u_p, u_n+1] 内互不相同的节点值为初始分段
+ *        eval(t, p) 求曲线点，sink(p) 接收顶点；调用方可借 eval 统计求值次数
+ */
+template <typename T, int Dim, typename Eval, typename Sink>
+inline void tessellateAdaptive(const NurbsView<T, Dim> &v, const TessellationSettings &settings,
+                               const Eval &eval, const Sink &sink)
+{
+    if (!v.isValid()) return;
+
+    T p0[Dim];
+    eval(v.domainBegin(), p0);
+    sink(p0);
+
+    for (int i = v.degree + 1; i <= v.count; ++i) {
+        T a = v.knots[i - 1], b = v.knots[i];
+        if (b > a)
+            adaptiveTessellateInterval<T, Dim>(eval, sink, a, b, settings);
+    }
+}
+
+template <typename T, int Dim>
+inline void tessellateAdaptive(const NurbsView<T, Dim> &v, const TessellationSettings &settings,
+                               Polyline<T, Dim> &out)
+{
+    out.clear();
+    tessellateAdaptive(v, settings,
+                       [&v](T t, T *p) { evaluate(v, t, p); },
+                       [&out](const T *p) { out.append(p); });
+}
+
+/**
+ * @brief Hermite 均匀采样：每段 res 个样本，共 segments*res+1 个
+ */
+template <typename T, int Dim>
+inline void tessellateUniform(const HermiteView<T, Dim> &v, int res, Polyline<T, Dim> &out)
+{
+    out.clear();
+    if (!v.isValid() || res < 1) return;
+
+    std::vector<T> s(res + 1);
+    for (int j = 0; j <= res; ++j) s[j] = static_cast<T>(j) / res;
+
+    const int segments = v.segmentCount();
+    out.resize(static_cast<size_t>(segments) * res + 1);
+    for (int i = 0; i < segments; ++i) {
+        T c[Dim][4];
+        segmentCoeffs(v, i, c);
+
+        T *dst[Dim];
+        for (int d = 0; d < Dim; ++d) dst[d] = out.coords[d].data() + static_cast<size_t>(i) * res;
+        sampleSegment<T, Dim>(c, s.data(), i == segments - 1 ? res + 1 : res, dst);
+    }
+}
+
+/**
+ * @brief Hermite 自适应细分：每段在局部参数 [0,1] 上独立细分
+ */
+template <typename T, int Dim>
+inline void tessellateAdaptive(const HermiteView<T, Dim> &v, const TessellationSettings &settings,
+                               Polyline<T, Dim> &out)
+{
+    out.clear();
+    if (!v.isValid()) return;
+
+    auto sink = [&out](const T *p) { out.append(p); };
+
+    T p0[Dim];
+    for (int d = 0; d < Dim; ++d) p0[d] = v.coords[d][0];
+    sink(p0);
+
+    for (int i = 0; i < v.segmentCount(); ++i) {
+        T c[Dim][4];
+        segmentCoeffs(v, i, c);
+
+        auto eval = [&c](T s, T *p) {
+            for (int d = 0; d < Dim; ++d)
+                p[d] = ((c[d][0] * s + c[d][1]) * s + c[d][2]) * s + c[d][3];
+        };
+        adaptiveTessellateInterval<T, Dim>(eval, sink, T(0), T(1), settings);
+    }
+}
+
+} // namespace curvecore
+
+#endif // CURVECORE_CURVETESSELLATION_H
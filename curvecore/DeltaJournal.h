@@ -0,0 +1,97 @@
+/**
+ * @file DeltaJournal.h
+ * @brief 撤销 / 重做日志：只记录变化的字段，连续拖动合并为一条，容量固定的环形缓冲
+ *
+ * Delta 由调用方定义，只需可拷贝并提供 void merge(const Delta &newer)：
+ * 保留自己的“修改前”，取 newer 的“修改后”。日志本身不知道如何应用 Delta，
+ * undo() / redo() 返回需要撤销 / 重做的那一条，由调用方执行。
+ *
+ * 记录新条目会丢弃所有可重做的条目；条目数达到容量时覆盖最旧的一条，
+ * 因此内存占用与编辑次数无关，只与容量和单条 Delta 的大小有关。
+ */
+#ifndef CURVECORE_DELTAJOURNAL_H
+#define CURVECORE_DELTAJOURNAL_H
+
+#include <cstddef>
+#include <vector>
+
+namespace curvecore {
+
+static const size_t DELTA_JOURNAL_CAPACITY = 256;   ///< 默认保留的撤销步数
+
+template <typename Delta>
+class DeltaJournal
+{
+public:
+    static const int NO_MERGE = -1;
+
+    explicit DeltaJournal(size_t capacity = DELTA_JOURNAL_CAPACITY)
+        : m_ring(capacity > 0 ? capacity : 1) {}
+
+    size_t capacity() const { return m_ring.size(); }
+    size_t size() const { return m_count; }
+    bool canUndo() const { return m_cursor > 0; }
+    bool canRedo() const { return m_cursor < m_count; }
+
+    /**
+     * @brief 记录一次修改
+     * @param mergeKey 与上一条记录的 mergeKey 相同且合并未被 close() 打断时，并入上一条；
+     *                 NO_MERGE 表示不参与合并。调用方用它区分“拖动第 i 个点”之类的连续操作
+     */
+    void record(const Delta &delta, int mergeKey = NO_MERGE)
+    {
+        if (mergeKey != NO_MERGE && mergeKey == m_openKey && m_cursor == m_count && m_cursor > 0) {
+            at(m_cursor - 1).merge(delta);
+            return;
+        }
+
+        m_count = m_cursor;                 // 丢弃可重做的条目
+        if (m_count == m_ring.size()) {
+            m_begin = (m_begin + 1) % m_ring.size();
+            --m_count;
+        }
+        at(m_count) = delta;
+        m_cursor = ++m_count;
+        m_openKey = mergeKey;
+    }
+
+    /// 结束当前的合并（如松开鼠标），下一条记录总是新条目
+    void close() { m_openKey = NO_MERGE; }
+
+    /**
+     * @brief 需要撤销的条目，没有时返回 nullptr；返回的指针在下一次 record() 前有效
+     */
+    const Delta *undo()
+    {
+        m_openKey = NO_MERGE;
+        if (!canUndo()) return nullptr;
+        return &at(--m_cursor);
+    }
+
+    const Delta *redo()
+    {
+        m_openKey = NO_MERGE;
+        if (!canRedo()) return nullptr;
+        return &at(m_cursor++);
+    }
+
+    void clear()
+    {
+        for (Delta &d : m_ring) d = Delta();
+        m_begin = m_count = m_cursor = 0;
+        m_openKey = NO_MERGE;
+    }
+
+private:
+    Delta &at(size_t k) { return m_ring[(m_begin + k) % m_ring.size()]; }
+
+    std::vector<Delta> m_ring;
+    size_t m_begin = 0;         ///< 最旧条目在环中的位置
+    size_t m_count = 0;         ///< 有效条目数（含可重做的）
+    size_t m_cursor = 0;        ///< 可撤销的条目数，[cursor, count) 为可重做
+    int m_openKey = NO_MERGE;   ///< 最新条目仍可合并时的 mergeKey
+};
+
+} // namespace curvecore
+
+#endif // CURVECORE_DELTAJOURNAL_H
@@ -0,0 +1,250 @@
+/**
+ * @file HermiteKernel.h
+ * @brief 三次幂基多项式批量求值内核
+ *
+ * Hermite 曲线段预先转换为幂基系数 P(s) = ((c0*s + c1)*s + c2)*s + c3 后，
+ * 每个样本只需一次 Horner 求值。double 与 float 版本在运行时根据 CPU 特性选择
+ * AVX2/FMA、NEON 或标量实现（float 每条指令处理的样本数是 double 的两倍）；
+ * 其他标量类型使用通用标量实现。
+ */
+#ifndef CURVECORE_HERMITEKERNEL_H
+#define CURVECORE_HERMITEKERNEL_H
+
+#include <cstddef>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#  define CURVECORE_KERNEL_X86 1
+#  include <immintrin.h>
+#  if defined(_MSC_VER) && !defined(__clang__)
+#    include <intrin.h>
+#    define CURVECORE_TARGET_AVX2
+#  else
+#    define CURVECORE_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#  endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#  define CURVECORE_KERNEL_NEON 1
+#  include <arm_neon.h>
+#endif
+
+namespace curvecore {
+namespace kernel {
+
+/**
+ * @brief 标量 Horner 实现，适用于任意标量类型
+ */
+template <typename T>
+inline void sampleCubicScalar(const T *c, const T *s, size_t n, T *out)
+{
+    const T c0 = c[0], c1 = c[1], c2 = c[2], c3 = c[3];
+    for (size_t k = 0; k < n; ++k) {
+        T v = s[k];
+        out[k] = ((c0 * v + c1) * v + c2) * v + c3;
+    }
+}
+
+#ifdef CURVECORE_KERNEL_X86
+
+inline bool cpuHasAvx2Fma()
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) return false;
+
+    __cpuid(info, 1);
+    bool fma = (info[2] & (1 << 12)) != 0;
+    bool osxsave = (info[2] & (1 << 27)) != 0;
+    bool avx = (info[2] & (1 << 28)) != 0;
+    if (!fma || !osxsave || !avx) return false;
+
+    // 操作系统需保存 YMM 寄存器状态
+    if ((_xgetbv(0) & 0x6) != 0x6) return false;
+
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#endif
+}
+
+/**
+ * @brief AVX2 + FMA：一次 4 个 double，循环展开为 8 个以掩盖 FMA 延迟
+ */
+CURVECORE_TARGET_AVX2
+inline void sampleCubicAvx2(const double *c, const double *s, size_t n, double *out)
+{
+    const __m256d c0 = _mm256_set1_pd(c[0]), c1 = _mm256_set1_pd(c[1]);
+    const __m256d c2 = _mm256_set1_pd(c[2]), c3 = _mm256_set1_pd(c[3]);
+
+    size_t k = 0;
+    for (; k + 8 <= n; k += 8) {
+        __m256d v0 = _mm256_loadu_pd(s + k);
+        __m256d v1 = _mm256_loadu_pd(s + k + 4);
+        __m256d r0 = _mm256_fmadd_pd(c0, v0, c1);
+        __m256d r1 = _mm256_fmadd_pd(c0, v1, c1);
+        r0 = _mm256_fmadd_pd(r0, v0, c2);
+        r1 = _mm256_fmadd_pd(r1, v1, c2);
+        r0 = _mm256_fmadd_pd(r0, v0, c3);
+        r1 = _mm256_fmadd_pd(r1, v1, c3);
+        _mm256_storeu_pd(out + k, r0);
+        _mm256_storeu_pd(out + k + 4, r1);
+    }
+    for (; k + 4 <= n; k += 4) {
+        __m256d v = _mm256_loadu_pd(s + k);
+        __m256d r = _mm256_fmadd_pd(_mm256_fmadd_pd(_mm256_fmadd_pd(c0, v, c1), v, c2), v, c3);
+        _mm256_storeu_pd(out + k, r);
+    }
+    sampleCubicScalar(c, s + k, n - k, out + k);
+}
+
+/**
+ * @brief AVX2 + FMA：一次 8 个 float，循环展开为 16 个
+ */
+CURVECORE_TARGET_AVX2
+inline void sampleCubicAvx2(const float *c, const float *s, size_t n, float *out)
+{
+    const __m256 c0 = _mm256_set1_ps(c[0]), c1 = _mm256_set1_ps(c[1]);
+    const __m256 c2 = _mm256_set1_ps(c[2]), c3 = _mm256_set1_ps(c[3]);
+
+    size_t k = 0;
+    for (; k + 16 <= n; k += 16) {
+        __m256 v0 = _mm256_loadu_ps(s + k);
+        __m256 v1 = _mm256_loadu_ps(s + k + 8);
+        __m256 r0 = _mm256_fmadd_ps(c0, v0, c1);
+        __m256 r1 = _mm256_fmadd_ps(c0, v1, c1);
+        r0 = _mm256_fmadd_ps(r0, v0, c2);
+        r1 = _mm256_fmadd_ps(r1, v1, c2);
+        r0 = _mm256_fmadd_ps(r0, v0, c3);
+        r1 = _mm256_fmadd_ps(r1, v1, c3);
+        _mm256_storeu_ps(out + k, r0);
+        _mm256_storeu_ps(out + k + 8, r1);
+    }
+    for (; k + 8 <= n; k += 8) {
+        __m256 v = _mm256_loadu_ps(s + k);
+        __m256 r = _mm256_fmadd_ps(_mm256_fmadd_ps(_mm256_fmadd_ps(c0, v, c1), v, c2), v, c3);
+        _mm256_storeu_ps(out + k, r);
+    }
+    sampleCubicScalar(c, s + k, n - k, out + k);
+}
+
+#endif // CURVECORE_KERNEL_X86
+
+#ifdef CURVECORE_KERNEL_NEON
+
+/**
+ * @brief NEON（AArch64 必备特性）：一次 2 个 double，循环展开为 4 个
+ */
+inline void sampleCubicNeon(const double *c, const double *s, size_t n, double *out)
+{
+    const float64x2_t c0 = vdupq_n_f64(c[0]), c1 = vdupq_n_f64(c[1]);
+    const float64x2_t c2 = vdupq_n_f64(c[2]), c3 = vdupq_n_f64(c[3]);
+
+    size_t k = 0;
+    for (; k + 4 <= n; k += 4) {
+        float64x2_t v0 = vld1q_f64(s + k);
+        float64x2_t v1 = vld1q_f64(s + k + 2);
+        // vfmaq_f64(acc, a, b) = acc + a*b
+        float64x2_t r0 = vfmaq_f64(c1, c0, v0);
+        float64x2_t r1 = vfmaq_f64(c1, c0, v1);
+        r0 = vfmaq_f64(c2, r0, v0);
+        r1 = vfmaq_f64(c2, r1, v1);
+        r0 = vfmaq_f64(c3, r0, v0);
+        r1 = vfmaq_f64(c3, r1, v1);
+        vst1q_f64(out + k, r0);
+        vst1q_f64(out + k + 2, r1);
+    }
+    sampleCubicScalar(c, s + k, n - k, out + k);
+}
+
+/**
+ * @brief NEON：一次 4 个 float，循环展开为 8 个
+ */
+inline void sampleCubicNeon(const float *c, const float *s, size_t n, float *out)
+{
+    const float32x4_t c0 = vdupq_n_f32(c[0]), c1 = vdupq_n_f32(c[1]);
+    const float32x4_t c2 = vdupq_n_f32(c[2]), c3 = vdupq_n_f32(c[3]);
+
+    size_t k = 0;
+    for (; k + 8 <= n; k += 8) {
+        float32x4_t v0 = vld1q_f32(s + k);
+        float32x4_t v1 = vld1q_f32(s + k + 4);
+        float32x4_t r0 = vfmaq_f32(c1, c0, v0);
+        float32x4_t r1 = vfmaq_f32(c1, c0, v1);
+        r0 = vfmaq_f32(c2, r0, v0);
+        r1 = vfmaq_f32(c2, r1, v1);
+        r0 = vfmaq_f32(c3, r0, v0);
+        r1 = vfmaq_f32(c3, r1, v1);
+        vst1q_f32(out + k, r0);
+        vst1q_f32(out + k + 4, r1);
+    }
+    sampleCubicScalar(c, s + k, n - k, out + k);
+}
+
+#endif // CURVECORE_KERNEL_NEON
+
+typedef void (*SampleCubicFn)(const double *, const double *, size_t, double *);
+typedef void (*SampleCubicFloatFn)(const float *, const float *, size_t, float *);
+
+struct KernelEntry {
+    SampleCubicFn fn;
+    SampleCubicFloatFn floatFn;
+    const char *name;
+};
+
+inline KernelEntry resolveKernel()
+{
+#ifdef CURVECORE_KERNEL_X86
+    if (cpuHasAvx2Fma()) {
+        KernelEntry e = { sampleCubicAvx2, sampleCubicAvx2, "avx2" };
+        return e;
+    }
+#endif
+#ifdef CURVECORE_KERNEL_NEON
+    KernelEntry e = { sampleCubicNeon, sampleCubicNeon, "neon" };
+#else
+    KernelEntry e = { sampleCubicScalar<double>, sampleCubicScalar<float>, "scalar" };
+#endif
+    return e;
+}
+
+inline const KernelEntry &selectedKernel()
+{
+    // 函数内静态变量的初始化是线程安全的（C++11）
+    static const KernelEntry entry = resolveKernel();
+    return entry;
+}
+
+} // namespace kernel
+
+/**
+ * @brief 对 s[0..n) 求三次多项式 c[0]s³ + c[1]s² + c[2]s + c[3]
+ *        double 版本首次调用时完成 CPU 派发
+ */
+inline void sampleCubic(const double *c, const double *s, size_t n, double *out)
+{
+    kernel::selectedKernel().fn(c, s, n, out);
+}
+
+inline void sampleCubic(const float *c, const float *s, size_t n, float *out)
+{
+    kernel::selectedKernel().floatFn(c, s, n, out);
+}
+
+template <typename T>
+inline void sampleCubic(const T *c, const T *s, size_t n, T *out)
+{
+    kernel::sampleCubicScalar(c, s, n, out);
+}
+
+/**
+ * @brief 当前派发到的内核名称（"avx2"、"neon" 或 "scalar"），double 与 float 相同
+ */
+inline const char *cubicKernelName()
+{
+    return kernel::selectedKernel().name;
+}
+
+} // namespace curvecore
+
+#endif // CURVECORE_HERMITEKERNEL_H
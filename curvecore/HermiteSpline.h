@@ -0,0 +1,332 @@
+/**
+ * @file HermiteSpline.h
+ * @brief 不依赖 Qt 的三次 Hermite 样条核心
+ *
+ * - HermiteView：对外部 SoA 数据（位置、切线、自定义切线标志）的只读视图
+ * - 自动切线：未自定义切线的点用相邻点差分估算，只依赖 i-1、i、i+1
+ * - 每段转换为幂基系数后由 HermiteKernel 批量求值
+ * - 导数由同一组幂基系数（即 h 多项式组合）逐项求导得到
+ *
+ * 全局参数 t ∈ [0,1] 均匀映射到 count-1 段，段内局部参数 s ∈ [0,1]。
+ */
+#ifndef CURVECORE_HERMITESPLINE_H
+#define CURVECORE_HERMITESPLINE_H
+
+#include "HermiteKernel.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace curvecore {
+
+/**
+ * @struct HermiteView
+ * @brief Hermite 样条数据的只读视图（SoA）
+ */
+template <typename T, int Dim>
+struct HermiteView {
+    const T *coords[Dim];               ///< 各维位置数组
+    const T *tangents[Dim];             ///< 各维切线数组
+    const unsigned char *hasTangent;    ///< 非零表示使用自定义切线
+    int count;                          ///< 插值点数
+
+    bool isValid() const { return count >= 2; }
+    int segmentCount() const { return count - 1; }
+};
+
+/**
+ * @brief 第 i 个点实际使用的切线
+ */
+template <typename T, int Dim>
+inline void tangentAt(const HermiteView<T, Dim> &v, int i, T *out)
+{
+    if (v.hasTangent[i]) {
+        for (int d = 0; d < Dim; ++d) out[d] = v.tangents[d][i];
+        return;
+    }
+
+    int a = i > 0 ? i - 1 : i;
+    int b = i < v.count - 1 ? i + 1 : i;
+    for (int d = 0; d < Dim; ++d)
+        out[d] = T(0.5) * (v.coords[d][b] - v.coords[d][a]);
+}
+
+/**
+ * @brief 各段在全局参数下的端点 i / segments（共 segments + 1 个）
+ */
+template <typename T, int Dim>
+inline void spanBreaks(const HermiteView<T, Dim> &v, std::vector<T> &out)
+{
+    const int segments = v.segmentCount();
+    out.resize(segments + 1);
+    for (int i = 0; i < segments; ++i) out[i] = static_cast<T>(i) / segments;
+    out[segments] = T(1);
+}
+
+/**
+ * @brief 第 i 段的幂基系数 c[d][0..3]（s³、s²、s、常数项）
+ *        h00 = 2s³-3s²+1, h10 = s³-2s²+s, h01 = -2s³+3s², h11 = s³-s²
+ */
+template <typename T, int Dim>
+inline void segmentCoeffs(const HermiteView<T, Dim> &v, int i, T (*c)[4])
+{
+    T t0[Dim], t1[Dim];
+    tangentAt(v, i, t0);
+    tangentAt(v, i + 1, t1);
+
+    for (int d = 0; d < Dim; ++d) {
+        T p0 = v.coords[d][i], p1 = v.coords[d][i + 1];
+        c[d][0] = 2 * p0 + t0[d] - 2 * p1 + t1[d];
+        c[d][1] = -3 * p0 - 2 * t0[d] + 3 * p1 - t1[d];
+        c[d][2] = t0[d];
+        c[d][3] = p0;
+    }
+}
+
+/**
+ * @brief 第 i 段的包围盒
+ *        该段等价于控制点 p0、p0 + m0/3、p1 - m1/3、p1 的三次 Bézier 曲线，位于其凸包内
+ */
+template <typename T, int Dim>
+inline void segmentBounds(const HermiteView<T, Dim> &v, int i, T *lo, T *hi)
+{
+    T t0[Dim], t1[Dim];
+    tangentAt(v, i, t0);
+    tangentAt(v, i + 1, t1);
+
+    for (int d = 0; d < Dim; ++d) {
+        T b[4] = { v.coords[d][i], v.coords[d][i] + t0[d] / 3,
+                   v.coords[d][i + 1] - t1[d] / 3, v.coords[d][i + 1] };
+        lo[d] = std::min(std::min(b[0], b[1]), std::min(b[2], b[3]));
+        hi[d] = std::max(std::max(b[0], b[1]), std::max(b[2], b[3]));
+    }
+}
+
+/**
+ * @brief 用幂基系数对一段曲线批量采样，s[0..n) 为段内局部参数
+ */
+template <typename T, int Dim>
+inline void sampleSegment(const T (*c)[4], const T *s, size_t n, T *const *out)
+{
+    for (int d = 0; d < Dim; ++d)
+        sampleCubic(c[d], s, n, out[d]);
+}
+
+/**
+ * @brief 全局参数批量求值，连续落在同一段的参数成批交给内核
+ */
+template <typename T, int Dim>
+inline void evaluateMany(const HermiteView<T, Dim> &v, const T *t, size_t n, T *const *out)
+{
+    if (!v.isValid()) {
+        for (int d = 0; d < Dim; ++d) std::fill(out[d], out[d] + n, T(0));
+        return;
+    }
+
+    const int segments = v.segmentCount();
+    const size_t BLOCK = 256;
+    T local[BLOCK];
+    T c[Dim][4];
+    int coeffSegment = -1;
+
+    size_t k = 0;
+    while (k < n) {
+        T u = std::min(std::max(t[k], T(0)), T(1)) * segments;
+        int i = std::min(static_cast<int>(u), segments - 1);
+
+        size_t m = 0;
+        local[m++] = u - i;
+        while (k + m < n && m < BLOCK) {
+            T w = std::min(std::max(t[k + m], T(0)), T(1)) * segments;
+            if (std::min(static_cast<int>(w), segments - 1) != i) break;
+            local[m++] = w - i;
+        }
+
+        if (i != coeffSegment) {
+            segmentCoeffs(v, i, c);
+            coeffSegment = i;
+        }
+
+        T *dst[Dim];
+        for (int d = 0; d < Dim; ++d) dst[d] = out[d] + k;
+        sampleSegment<T, Dim>(c, local, m, dst);
+        k += m;
+    }
+}
+
+/**
+ * @brief 单点求值（全局参数）
+ */
+template <typename T, int Dim>
+inline void evaluate(const HermiteView<T, Dim> &v, T t, T *out)
+{
+    T *dst[Dim];
+    for (int d = 0; d < Dim; ++d) dst[d] = out + d;
+    evaluateMany(v, &t, 1, dst);
+}
+
+/**
+ * @brief 全局参数 t 处的 0..order 阶导数（order ≤ 3），out[k * Dim + d]
+ *        段内 dC/ds 由幂基系数逐项求导；全局参数 t = (i + s) / segments，故 d/dt = segments · d/ds
+ *        段端点处取所在段（t = 1 时为末段）的单侧导数
+ */
+template <typename T, int Dim>
+inline void evaluateDerivatives(const HermiteView<T, Dim> &v, T t, int order, T *out)
+{
+    order = std::max(0, std::min(order, 3));
+    std::fill(out, out + (order + 1) * Dim, T(0));
+    if (!v.isValid()) return;
+
+    const int segments = v.segmentCount();
+    const T u = std::min(std::max(t, T(0)), T(1)) * segments;
+    const int i = std::min(static_cast<int>(u), segments - 1);
+    const T s = u - i;
+
+    T c[Dim][4];
+    segmentCoeffs(v, i, c);
+    const T scale = static_cast<T>(segments);
+    for (int d = 0; d < Dim; ++d) {
+        const T *a = c[d];
+        const T values[4] = { ((a[0] * s + a[1]) * s + a[2]) * s + a[3],
+                              ((3 * a[0] * s + 2 * a[1]) * s + a[2]) * scale,
+                              (6 * a[0] * s + 2 * a[1]) * scale * scale,
+                              6 * a[0] * scale * scale * scale };
+        for (int k = 0; k <= order; ++k) out[k * Dim + d] = values[k];
+    }
+}
+
+/**
+ * @class HermiteSpline
+ * @brief 持有 SoA 数据的三次 Hermite 样条
+ */
+template <typename T, int Dim>
+class HermiteSpline
+{
+public:
+    typedef T Scalar;
+    enum { Dimension = Dim };
+
+    int size() const { return static_cast<int>(m_hasTangent.size()); }
+    bool isEmpty() const { return m_hasTangent.empty(); }
+    int segmentCount() const { return std::max(size() - 1, 0); }
+
+    T coord(int d, int i) const { return m_coords[d][i]; }
+    T tangentCoord(int d, int i) const { return m_tangents[d][i]; }
+    bool hasTangent(int i) const { return m_hasTangent[i] != 0; }
+    const T *coords(int d) const { return m_coords[d].data(); }
+    const T *tangents(int d) const { return m_tangents[d].data(); }
+    const unsigned char *tangentFlags() const { return m_hasTangent.data(); }
+
+    void point(int i, T *out) const
+    {
+        for (int d = 0; d < Dim; ++d) out[d] = m_coords[d][i];
+    }
+    void tangent(int i, T *out) const
+    {
+        for (int d = 0; d < Dim; ++d) out[d] = m_tangents[d][i];
+    }
+    void setPoint(int i, const T *p)
+    {
+        for (int d = 0; d < Dim; ++d) m_coords[d][i] = p[d];
+    }
+
+    /**
+     * @brief 设置切线向量；hasTangent 为 false 时仅保存，求值仍用自动切线
+     */
+    void setTangent(int i, const T *t, bool hasTangent)
+    {
+        for (int d = 0; d < Dim; ++d) m_tangents[d][i] = t[d];
+        m_hasTangent[i] = hasTangent ? 1 : 0;
+    }
+
+    void reserve(int n)
+    {
+        for (int d = 0; d < Dim; ++d) {
+            m_coords[d].reserve(n);
+            m_tangents[d].reserve(n);
+        }
+        m_hasTangent.reserve(n);
+    }
+
+    void append(const T *p, const T *t, bool hasTangent = false)
+    {
+        insert(size(), p, t, hasTangent);
+    }
+
+    void insert(int i, const T *p, const T *t, bool hasTangent = false)
+    {
+        for (int d = 0; d < Dim; ++d) {
+            m_coords[d].insert(m_coords[d].begin() + i, p[d]);
+            m_tangents[d].insert(m_tangents[d].begin() + i, t[d]);
+        }
+        m_hasTangent.insert(m_hasTangent.begin() + i, hasTangent ? 1 : 0);
+    }
+
+    void remove(int i)
+    {
+        for (int d = 0; d < Dim; ++d) {
+            m_coords[d].erase(m_coords[d].begin() + i);
+            m_tangents[d].erase(m_tangents[d].begin() + i);
+        }
+        m_hasTangent.erase(m_hasTangent.begin() + i);
+    }
+
+    void clear()
+    {
+        for (int d = 0; d < Dim; ++d) {
+            m_coords[d].clear();
+            m_tangents[d].clear();
+        }
+        m_hasTangent.clear();
+    }
+
+    /**
+     * @brief 整体替换数据（批量加载）
+     * @param flags 自定义切线标志，为空时全部使用自动切线
+     */
+    void assign(const T *const *coords, const T *const *tangents,
+                const unsigned char *flags, int count)
+    {
+        for (int d = 0; d < Dim; ++d) {
+            m_coords[d].assign(coords[d], coords[d] + count);
+            m_tangents[d].assign(tangents[d], tangents[d] + count);
+        }
+        if (flags) m_hasTangent.assign(flags, flags + count);
+        else m_hasTangent.assign(count, 0);
+    }
+
+    HermiteView<T, Dim> view() const
+    {
+        HermiteView<T, Dim> v;
+        for (int d = 0; d < Dim; ++d) {
+            v.coords[d] = m_coords[d].data();
+            v.tangents[d] = m_tangents[d].data();
+        }
+        v.hasTangent = m_hasTangent.data();
+        v.count = size();
+        return v;
+    }
+
+    void tangentAt(int i, T *out) const { curvecore::tangentAt(view(), i, out); }
+    void segmentCoeffs(int i, T (*c)[4]) const { curvecore::segmentCoeffs(view(), i, c); }
+    void segmentBounds(int i, T *lo, T *hi) const { curvecore::segmentBounds(view(), i, lo, hi); }
+    void evaluate(T t, T *out) const { curvecore::evaluate(view(), t, out); }
+    void evaluateDerivatives(T t, int order, T *out) const
+    {
+        curvecore::evaluateDerivatives(view(), t, order, out);
+    }
+    void evaluateMany(const T *t, size_t n, T *const *out) const
+    {
+        curvecore::evaluateMany(view(), t, n, out);
+    }
+
+private:
+    std::vector<T> m_coords[Dim];
+    std::vector<T> m_tangents[Dim];
+    std::vector<unsigned char> m_hasTangent;
+};
+
+} // namespace curvecore
+
+#endif // CURVECORE_HERMITESPLINE_H
@@ -0,0 +1,336 @@
+/**
+ * @file KnotInsertion.h
+ * @brief 节点插入与有理 Bézier 分解
+ *
+ * - insertKnot：Boehm 节点插入（The NURBS Book 算法 A5.1），曲线形状不变
+ * - decomposeBezier：把端点夹紧的 NURBS 分解为逐区间的有理 Bézier 段（算法 A5.6）
+ * - BezierSegments：分解结果，每段同时保存齐次 Bézier 控制点与局部参数 [0,1] 上的幂基系数；
+ *   求值只需定位段后做一次 Horner，省去每个样本的区间查找与 Cox–de Boor 三角形。
+ *
+ * 同一条曲线反复采样（导出、不同缩放下的视口细分）时先分解一次，之后各段互不依赖，可直接分块并行。
+ * 所有运算在齐次坐标 (w·P, w) 上进行，结果除以权重分量得到笛卡尔坐标。
+ */
+#ifndef CURVECORE_KNOTINSERTION_H
+#define CURVECORE_KNOTINSERTION_H
+
+#include "NurbsCurve.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace curvecore {
+
+/**
+ * @brief 节点 u 在节点向量中的重数
+ */
+template <typename T>
+inline int knotMultiplicity(const T *knots, int knotCount, T u)
+{
+    return static_cast<int>(std::count(knots, knots + knotCount, u));
+}
+
+/**
+ * @brief 把控制点转换为齐次坐标 (w·P, w)，按点连续存放，每点 Dim+1 个分量
+ */
+template <typename T, int Dim>
+inline void homogeneousPoints(const NurbsView<T, Dim> &v, std::vector<T> &out)
+{
+    out.resize(static_cast<size_t>(v.count) * (Dim + 1));
+    for (int i = 0; i < v.count; ++i) {
+        T *q = &out[static_cast<size_t>(i) * (Dim + 1)];
+        for (int d = 0; d < Dim; ++d) q[d] = v.coords[d][i] * v.weights[i];
+        q[Dim] = v.weights[i];
+    }
+}
+
+/**
+ * @brief 在定义域内插入节点 u 共 times 次，结果写入 out（阶数与 v 相同，使用自定义节点向量）
+ * @return u 超出定义域、times < 1 或插入后重数超过阶数时返回 false 且不修改 out
+ *
+ * 只有节点区间 k-p..k 的控制点参与重新组合，代价 O(times·p)，再加 O(n) 的拷贝。
+ */
+template <typename T, int Dim>
+inline bool insertKnot(const NurbsView<T, Dim> &v, T u, int times, NurbsCurve<T, Dim> &out)
+{
+    if (!v.isValid() || times < 1 || u < v.domainBegin() || u > v.domainEnd()) return false;
+
+    const int p = v.degree, n = v.count - 1, m = n + p + 1;
+    const int s = knotMultiplicity(v.knots, m + 1, u);
+    if (s + times > p) return false;
+    const int k = findSpan(v.knots, n, p, u);
+    const int stride = Dim + 1;
+
+    std::vector<T> pw;
+    homogeneousPoints(v, pw);
+
+    // 新节点向量：u_0..u_k, u × times, u_{k+1}..u_m
+    std::vector<T> knots(m + 1 + times);
+    std::copy(v.knots, v.knots + k + 1, knots.begin());
+    std::fill(knots.begin() + k + 1, knots.begin() + k + 1 + times, u);
+    std::copy(v.knots + k + 1, v.knots + m + 1, knots.begin() + k + 1 + times);
+
+    // 不受影响的控制点原样保留，前段不动、后段后移 times 位
+    std::vector<T> qw(static_cast<size_t>(n + 1 + times) * stride);
+    std::copy(pw.begin(), pw.begin() + (k - p + 1) * stride, qw.begin());
+    std::copy(pw.begin() + (k - s) * stride, pw.end(), qw.begin() + (k - s + times) * stride);
+
+    std::vector<T> rw(pw.begin() + (k - p) * stride, pw.begin() + (k - s + 1) * stride);
+    int L = k - p;
+    for (int j = 1; j <= times; ++j) {
+        L = k - p + j;
+        for (int i = 0; i <= p - j - s; ++i) {
+            const T alpha = (u - v.knots[L + i]) / (v.knots[i + k + 1] - v.knots[L + i]);
+            for (int c = 0; c < stride; ++c)
+                rw[i * stride + c] = alpha * rw[(i + 1) * stride + c] + (T(1) - alpha) * rw[i * stride + c];
+        }
+        std::copy(rw.begin(), rw.begin() + stride, qw.begin() + L * stride);
+        std::copy(rw.begin() + (p - j - s) * stride, rw.begin() + (p - j - s + 1) * stride,
+                  qw.begin() + (k + times - j - s) * stride);
+    }
+    for (int i = L + 1; i < k - s; ++i)
+        std::copy(rw.begin() + (i - L) * stride, rw.begin() + (i - L + 1) * stride, qw.begin() + i * stride);
+
+    // 回到笛卡尔坐标
+    const int count = n + 1 + times;
+    std::vector<T> coords[Dim], weights(count);
+    const T *columns[Dim];
+    for (int d = 0; d < Dim; ++d) {
+        coords[d].resize(count);
+        columns[d] = coords[d].data();
+    }
+    for (int i = 0; i < count; ++i) {
+        const T *q = &qw[static_cast<size_t>(i) * stride];
+        weights[i] = q[Dim];
+        for (int d = 0; d < Dim; ++d) coords[d][i] = q[Dim] != T(0) ? q[d] / q[Dim] : T(0);
+    }
+
+    out.setDegree(p);
+    out.assign(columns, weights.data(), count);
+    return out.setKnots(knots.data(), static_cast<int>(knots.size()));
+}
+
+/**
+ * @class BezierSegments
+ * @brief NURBS 的逐区间有理 Bézier 表示
+ *
+ * 第 s 段覆盖参数 [breaks[s], breaks[s+1]]，局部参数 x = (t - breaks[s]) / (breaks[s+1] - breaks[s])。
+ * points 与 power 的布局相同：段 s、第 j 个系数、分量 c 位于 ((s·(p+1)) + j)·(Dim+1) + c，
+ * 分量 Dim 为权重。power 为幂基系数（升幂），与 points 描述同一条曲线。
+ */
+template <typename T, int Dim>
+class BezierSegments
+{
+public:
+    int degree() const { return m_degree; }
+    int segmentCount() const { return m_breaks.empty() ? 0 : static_cast<int>(m_breaks.size()) - 1; }
+    bool isValid() const { return segmentCount() > 0; }
+
+    T domainBegin() const { return m_breaks.front(); }
+    T domainEnd() const { return m_breaks.back(); }
+    const std::vector<T> &breaks() const { return m_breaks; }
+
+    /// 第 s 段第 j 个齐次 Bézier 控制点（Dim+1 个分量）
+    const T *point(int s, int j) const { return &m_points[index(s, j)]; }
+
+    void clear()
+    {
+        m_degree = 0;
+        m_breaks.clear();
+        m_points.clear();
+        m_power.clear();
+    }
+
+    /**
+     * @brief 第 s 段的包围盒（权重为正时曲线位于 Bézier 控制点凸包内）
+     */
+    void segmentBounds(int s, T *lo, T *hi) const
+    {
+        for (int j = 0; j <= m_degree; ++j) {
+            const T *q = point(s, j);
+            for (int d = 0; d < Dim; ++d) {
+                T x = q[d] / q[Dim];
+                lo[d] = j == 0 ? x : std::min(lo[d], x);
+                hi[d] = j == 0 ? x : std::max(hi[d], x);
+            }
+        }
+    }
+
+    /**
+     * @brief 第 s 段在局部参数 x ∈ [0,1] 处的点：每个齐次分量一次 Horner，再除以权重
+     */
+    void evaluateSegment(int s, T x, T *out) const
+    {
+        const int stride = Dim + 1;
+        const T *c = &m_power[index(s, m_degree)];
+        T acc[Dim + 1];
+        for (int k = 0; k < stride; ++k) acc[k] = c[k];
+        for (int j = m_degree - 1; j >= 0; --j) {
+            c -= stride;
+            for (int k = 0; k < stride; ++k) acc[k] = acc[k] * x + c[k];
+        }
+        for (int d = 0; d < Dim; ++d)
+            out[d] = acc[Dim] != T(0) ? acc[d] / acc[Dim] : T(0);
+    }
+
+    /**
+     * @brief 参数 t 所在的段，超出定义域时取首 / 末段
+     */
+    int findSegment(T t) const
+    {
+        int s = static_cast<int>(std::upper_bound(m_breaks.begin() + 1, m_breaks.end() - 1, t)
+                                 - m_breaks.begin()) - 1;
+        return std::max(0, std::min(s, segmentCount() - 1));
+    }
+
+    /**
+     * @brief 批量求值，结果按维度写入 out[d][0..n)；参数单调时复用上一次的段，只在跨段时查找
+     */
+    void evaluateMany(const T *t, size_t n, T *const *out) const
+    {
+        if (!isValid()) {
+            for (int d = 0; d < Dim; ++d) std::fill(out[d], out[d] + n, T(0));
+            return;
+        }
+
+        int s = 0;
+        T a = m_breaks[0], b = m_breaks[1], scale = T(1) / (b - a);
+        T p[Dim];
+        for (size_t k = 0; k < n; ++k) {
+            T u = std::min(std::max(t[k], domainBegin()), domainEnd());
+            if (u < a || u > b) {
+                s = findSegment(u);
+                a = m_breaks[s];
+                b = m_breaks[s + 1];
+                scale = T(1) / (b - a);
+            }
+            evaluateSegment(s, (u - a) * scale, p);
+            for (int d = 0; d < Dim; ++d) out[d][k] = p[d];
+        }
+    }
+
+    void evaluate(T t, T *out) const
+    {
+        T *dst[Dim];
+        for (int d = 0; d < Dim; ++d) dst[d] = out + d;
+        evaluateMany(&t, 1, dst);
+    }
+
+private:
+    template <typename U, int D>
+    friend bool decomposeBezier(const NurbsView<U, D> &v, BezierSegments<U, D> &out);
+
+    size_t index(int s, int j) const
+    {
+        return (static_cast<size_t>(s) * (m_degree + 1) + j) * (Dim + 1);
+    }
+
+    /**
+     * @brief 由 Bézier 控制点求幂基系数：a_k = C(p,k) Σ_{i≤k} (-1)^{k-i} C(k,i) b_i
+     */
+    void buildPowerBasis()
+    {
+        const int p = m_degree, stride = Dim + 1;
+        T binomial[MAX_NURBS_DEGREE + 1][MAX_NURBS_DEGREE + 1];
+        for (int r = 0; r <= p; ++r) {
+            binomial[r][0] = binomial[r][r] = T(1);
+            for (int c = 1; c < r; ++c) binomial[r][c] = binomial[r - 1][c - 1] + binomial[r - 1][c];
+        }
+
+        m_power.assign(m_points.size(), T(0));
+        for (int s = 0; s < segmentCount(); ++s) {
+            for (int k = 0; k <= p; ++k) {
+                T *a = &m_power[index(s, k)];
+                for (int i = 0; i <= k; ++i) {
+                    const T f = binomial[p][k] * binomial[k][i] * ((k - i) % 2 ? T(-1) : T(1));
+                    const T *b = point(s, i);
+                    for (int c = 0; c < stride; ++c) a[c] += f * b[c];
+                }
+            }
+        }
+    }
+
+    int m_degree = 0;
+    std::vector<T> m_breaks;    ///< 段端点参数，segmentCount()+1 个
+    std::vector<T> m_points;    ///< 齐次 Bézier 控制点
+    std::vector<T> m_power;     ///< 齐次幂基系数
+};
+
+/**
+ * @brief 端点夹紧的节点向量（两端各 p+1 重）才能直接分解
+ */
+template <typename T, int Dim>
+inline bool isClamped(const NurbsView<T, Dim> &v)
+{
+    const int p = v.degree, m = v.count + p;
+    for (int i = 1; i <= p; ++i)
+        if (v.knots[i] != v.knots[0] || v.knots[m - i] != v.knots[m]) return false;
+    return true;
+}
+
+/**
+ * @brief 把 NURBS 分解为逐区间的有理 Bézier 段（算法 A5.6）
+ *        每个内部节点被插入到 p 重，每段的 p+1 个控制点即该区间的 Bézier 点；O(n·p²)
+ * @return 曲线无效（含阶数超过 MAX_NURBS_DEGREE）或节点向量未夹紧时返回 false，out 被清空
+ */
+template <typename T, int Dim>
+inline bool decomposeBezier(const NurbsView<T, Dim> &v, BezierSegments<T, Dim> &out)
+{
+    out.clear();
+    if (!v.isValid() || !isClamped(v)) return false;
+
+    const int p = v.degree, n = v.count - 1, m = n + p + 1;
+    const int stride = Dim + 1, block = (p + 1) * stride;
+    const T *U = v.knots;
+
+    std::vector<T> pw;
+    homogeneousPoints(v, pw);
+
+    // 段数不超过不同内部节点数 + 1
+    out.m_degree = p;
+    out.m_points.resize(static_cast<size_t>(n - p + 1) * block);
+    out.m_breaks.push_back(U[p]);
+
+    T alphas[MAX_NURBS_DEGREE];
+    int a = p, b = p + 1, nb = 0;
+    std::copy(pw.begin(), pw.begin() + block, out.m_points.begin());
+    while (b < m) {
+        const int i = b;
+        while (b < m && U[b + 1] == U[b]) ++b;
+        const int mult = b - i + 1;
+
+        T *Q = &out.m_points[static_cast<size_t>(nb) * block];
+        if (mult < p) {
+            const T numer = U[b] - U[a];
+            for (int j = p; j > mult; --j) alphas[j - mult - 1] = numer / (U[a + j] - U[a]);
+            const int r = p - mult;
+            for (int j = 1; j <= r; ++j) {
+                const int save = r - j, s = mult + j;
+                for (int k = p; k >= s; --k) {
+                    const T alpha = alphas[k - s];
+                    for (int c = 0; c < stride; ++c)
+                        Q[k * stride + c] = alpha * Q[k * stride + c] + (T(1) - alpha) * Q[(k - 1) * stride + c];
+                }
+                // 下一段的前 r 个点正是本段插入过程中依次产生的末点
+                if (b < m) std::copy(Q + p * stride, Q + block, Q + block + save * stride);
+            }
+        }
+        ++nb;
+        out.m_breaks.push_back(U[b]);
+        if (b < m) {
+            T *next = &out.m_points[static_cast<size_t>(nb) * block];
+            for (int j = p - mult; j <= p; ++j)
+                std::copy(&pw[(b - p + j) * stride], &pw[(b - p + j) * stride] + stride, next + j * stride);
+            a = b;
+            ++b;
+        }
+    }
+
+    out.m_points.resize(static_cast<size_t>(nb) * block);
+    out.buildPowerBasis();
+    return true;
+}
+
+} // namespace curvecore
+
+#endif // CURVECORE_KNOTINSERTION_H
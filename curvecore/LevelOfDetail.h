@@ -0,0 +1,255 @@
+/**
+ * @file LevelOfDetail.h
+ * @brief 按屏幕尺寸与曲率决定采样密度的视口细分（二维）
+ *
+ * 每个 Hermite 段 / NURBS 节点区间先把控制多边形投影到屏幕：
+ * - 包围盒与视口（含外扩）不相交：剔除，只保留一条弦
+ * - 包围盒小于一个像素：只保留一条弦
+ * - 否则按二阶差分估计的弦偏差与多边形长度取采样段数
+ *
+ * 曲线位于控制多边形凸包内，凸包在包围盒内，因此被剔除区间的弦同样不可见，
+ * 输出仍是一条连续折线。样本总数只与曲线在屏幕上的尺寸有关，与全局采样精度无关。
+ *
+ * 采样参数等临时数组从 scratch 分配；逐帧调用时传入每帧重置的 ScratchArena 即不再分配堆内存。
+ */
+#ifndef CURVECORE_LEVELOFDETAIL_H
+#define CURVECORE_LEVELOFDETAIL_H
+
+#include "CurveTessellation.h"
+#include "KnotInsertion.h"
+#include "ScratchArena.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace curvecore {
+
+/**
+ * @struct Viewport
+ * @brief 曲线坐标到屏幕像素的变换（等比缩放 + 平移）与可见区域
+ *        screen = world * scale + offset
+ */
+struct Viewport {
+    double scale = 1.0;
+    double offset[2] = { 0.0, 0.0 };
+    double width = 0.0;         ///< 可见区域宽（像素）
+    double height = 0.0;        ///< 可见区域高（像素）
+
+    bool operator==(const Viewport &o) const
+    {
+        return scale == o.scale && offset[0] == o.offset[0] && offset[1] == o.offset[1]
+            && width == o.width && height == o.height;
+    }
+    bool operator!=(const Viewport &o) const { return !(*this == o); }
+};
+
+/**
+ * @struct LodSettings
+ * @brief 视口细分参数（长度单位均为屏幕像素）
+ */
+struct LodSettings {
+    double tolerance = 0.25;        ///< 允许的弦偏差
+    double maxSegmentLength = 16.0; ///< 单个采样段的最大长度，权重悬殊时弥补曲率估计的不足
+    double cullMargin = 8.0;        ///< 视口外扩量，覆盖线宽
+    int maxSamples = 256;           ///< 每个区间的采样段数上限
+};
+
+/**
+ * @struct LodStats
+ * @brief 一次视口细分的统计
+ */
+struct LodStats {
+    int intervals = 0;          ///< 参与细分的区间数
+    int culled = 0;             ///< 位于视口外的区间数
+    int collapsed = 0;          ///< 小于一个像素的区间数
+    long long evaluations = 0;  ///< 曲线求值次数
+};
+
+/**
+ * @brief 区间的采样段数
+ * @param xs,ys 区间控制多边形（曲线坐标），n 个点
+ * @param degree 二阶差分放大系数 degree*(degree-1) 所用的阶数
+ * @return 0 表示被剔除（调用方只输出区间终点）；否则为采样段数（≥ 1）
+ *
+ * 对 m 次 Bézier 曲线，|C''| ≤ m(m-1)·max|Δ²b|，用 k 段等分时弦偏差不超过 |C''|/(8k²)。
+ * B 样条的控制点不是 Bézier 点，但均匀节点下 Bézier 点为 de Boor 点的仿射平均，估计偏保守。
+ */
+template <typename T>
+inline int lodSegmentCount(const T *xs, const T *ys, int n, int degree, const Viewport &view,
+                           const LodSettings &settings, LodStats *stats = nullptr)
+{
+    if (stats) ++stats->intervals;
+
+    double lo[2] = { xs[0] * view.scale + view.offset[0], ys[0] * view.scale + view.offset[1] };
+    double hi[2] = { lo[0], lo[1] };
+    double length = 0.0, bend = 0.0;
+    double prev[2] = { lo[0], lo[1] }, prevDelta[2] = { 0.0, 0.0 };
+    for (int i = 1; i < n; ++i) {
+        double p[2] = { xs[i] * view.scale + view.offset[0], ys[i] * view.scale + view.offset[1] };
+        for (int d = 0; d < 2; ++d) {
+            lo[d] = std::min(lo[d], p[d]);
+            hi[d] = std::max(hi[d], p[d]);
+        }
+        double delta[2] = { p[0] - prev[0], p[1] - prev[1] };
+        length += std::sqrt(delta[0] * delta[0] + delta[1] * delta[1]);
+        if (i > 1) {
+            double a = delta[0] - prevDelta[0], b = delta[1] - prevDelta[1];
+            bend = std::max(bend, std::sqrt(a * a + b * b));
+        }
+        prev[0] = p[0];
+        prev[1] = p[1];
+        prevDelta[0] = delta[0];
+        prevDelta[1] = delta[1];
+    }
+
+    const double margin = settings.cullMargin;
+    if (hi[0] < -margin || lo[0] > view.width + margin || hi[1] < -margin || lo[1] > view.height + margin) {
+        if (stats) ++stats->culled;
+        return 0;
+    }
+    if (hi[0] - lo[0] < 1.0 && hi[1] - lo[1] < 1.0) {
+        if (stats) ++stats->collapsed;
+        return 1;
+    }
+
+    double segments = 1.0;
+    if (degree > 1 && settings.tolerance > 0.0)
+        segments = std::sqrt(degree * (degree - 1) * bend / (8.0 * settings.tolerance));
+    if (settings.maxSegmentLength > 0.0)
+        segments = std::max(segments, length / settings.maxSegmentLength);
+    return std::max(1, std::min(settings.maxSamples, static_cast<int>(std::ceil(segments))));
+}
+
+/**
+ * @brief Hermite 视口细分：每段的控制多边形为其等价三次 Bézier 控制点
+ */
+template <typename T>
+inline void tessellateLod(const HermiteView<T, 2> &v, const Viewport &view, const LodSettings &settings,
+                          Polyline<T, 2> &out, LodStats *stats = nullptr, ScratchArena *scratch = nullptr)
+{
+    out.clear();
+    if (!v.isValid()) return;
+
+    T p0[2] = { v.coords[0][0], v.coords[1][0] };
+    out.append(p0);
+
+    ScratchArena local(0);
+    ScratchArena &arena = scratch ? *scratch : local;
+    T *s = arena.allocate<T>(std::max(settings.maxSamples, 1));
+    for (int i = 0; i < v.segmentCount(); ++i) {
+        T t0[2], t1[2];
+        tangentAt(v, i, t0);
+        tangentAt(v, i + 1, t1);
+        const T bx[4] = { v.coords[0][i], v.coords[0][i] + t0[0] / 3,
+                          v.coords[0][i + 1] - t1[0] / 3, v.coords[0][i + 1] };
+        const T by[4] = { v.coords[1][i], v.coords[1][i] + t0[1] / 3,
+                          v.coords[1][i + 1] - t1[1] / 3, v.coords[1][i + 1] };
+
+        int k = lodSegmentCount(bx, by, 4, 3, view, settings, stats);
+        if (k <= 1) {
+            T end[2] = { bx[3], by[3] };
+            out.append(end);
+            continue;
+        }
+
+        // 段内样本 s = 1/k .. 1，段首已由上一段输出
+        T c[2][4];
+        segmentCoeffs(v, i, c);
+        for (int j = 0; j < k; ++j) s[j] = static_cast<T>(j + 1) / k;
+
+        size_t base = out.size();
+        out.resize(base + k);
+        T *dst[2] = { out.coords[0].data() + base, out.coords[1].data() + base };
+        sampleSegment<T, 2>(c, s, k, dst);
+        if (stats) stats->evaluations += k;
+    }
+}
+
+/**
+ * @brief NURBS 视口细分：节点区间 [u_i, u_{i+1}) 上的曲线只受 P_{i-p}..P_i 影响
+ *        先为所有区间确定段数与参数，再一次批量求值
+ */
+template <typename T>
+inline void tessellateLod(const NurbsView<T, 2> &v, const Viewport &view, const LodSettings &settings,
+                          Polyline<T, 2> &out, LodStats *stats = nullptr, ScratchArena *scratch = nullptr)
+{
+    out.clear();
+    if (!v.isValid()) return;
+
+    ScratchArena local(0);
+    ScratchArena &arena = scratch ? *scratch : local;
+
+    // 第一遍：各区间段数（空区间为 0），得到参数总数
+    const int p = v.degree;
+    int *segments = arena.allocate<int>(v.count - p);
+    size_t total = 1;
+    for (int i = p; i < v.count; ++i) {
+        int &k = segments[i - p];
+        k = 0;
+        if (!(v.knots[i + 1] > v.knots[i])) continue;
+        k = lodSegmentCount(v.coords[0] + i - p, v.coords[1] + i - p, p + 1, p, view, settings, stats);
+        k = std::max(k, 1);
+        total += k;
+    }
+
+    // 第二遍：写出参数
+    T *t = arena.allocate<T>(total);
+    size_t n = 0;
+    t[n++] = v.domainBegin();
+    for (int i = p; i < v.count; ++i) {
+        const int k = segments[i - p];
+        const T a = v.knots[i], b = v.knots[i + 1];
+        for (int j = 1; j <= k; ++j)
+            t[n++] = j == k ? b : a + (b - a) * j / k;
+    }
+
+    out.resize(n);
+    T *dst[2] = { out.coords[0].data(), out.coords[1].data() };
+    evaluateMany(v, t, n, dst);
+    if (stats) stats->evaluations += static_cast<long long>(n);
+}
+
+/**
+ * @brief 已分解为有理 Bézier 段的 NURBS 视口细分
+ *        曲率估计直接用每段的 Bézier 控制点，比 de Boor 多边形更紧；求值为每样本一次 Horner。
+ *        曲线不变、只有视口变化（缩放、平移）时，调用方缓存分解结果即可省去所有基函数计算
+ */
+template <typename T>
+inline void tessellateLod(const BezierSegments<T, 2> &b, const Viewport &view, const LodSettings &settings,
+                          Polyline<T, 2> &out, LodStats *stats = nullptr)
+{
+    out.clear();
+    if (!b.isValid()) return;
+
+    const int p = b.degree();
+    T p0[2];
+    b.evaluateSegment(0, T(0), p0);
+    out.append(p0);
+    if (stats) ++stats->evaluations;
+
+    for (int s = 0; s < b.segmentCount(); ++s) {
+        T xs[MAX_NURBS_DEGREE + 1], ys[MAX_NURBS_DEGREE + 1];
+        for (int j = 0; j <= p; ++j) {
+            const T *q = b.point(s, j);
+            xs[j] = q[0] / q[2];
+            ys[j] = q[1] / q[2];
+        }
+
+        int k = lodSegmentCount(xs, ys, p + 1, p, view, settings, stats);
+        k = std::max(k, 1);
+        size_t base = out.size();
+        out.resize(base + k);
+        for (int j = 1; j <= k; ++j) {
+            T point[2];
+            b.evaluateSegment(s, static_cast<T>(j) / k, point);
+            out.coords[0][base + j - 1] = point[0];
+            out.coords[1][base + j - 1] = point[1];
+        }
+        if (stats) stats->evaluations += k;
+    }
+}
+
+} // namespace curvecore
+
+#endif // CURVECORE_LEVELOFDETAIL_H
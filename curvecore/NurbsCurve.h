@@ -0,0 +1,623 @@
+/**
+ * @file NurbsCurve.h
+ * @brief 不依赖 Qt 的 NURBS 曲线求值核心
+ *
+ * - NurbsView：对外部 SoA 数据（坐标、权重、节点）的只读视图，可直接指向内存映射文件
+ * - findSpan / basisFunctions：The NURBS Book 算法 A2.1 / A2.2
+ * - basisDerivatives / evaluateDerivatives：基函数导数（A2.3）与有理曲线导数（A4.2）
+ * - fixed::*：1..5 阶编译期展开的求值器，由 DegreeDispatch 按运行时阶数选择
+ * - NurbsCurve：持有数据的曲线对象，控制点数或阶数变化时自动重建开放均匀节点向量
+ *
+ * 标量类型 T（float/double）与维度 Dim 均为模板参数。
+ */
+#ifndef CURVECORE_NURBSCURVE_H
+#define CURVECORE_NURBSCURVE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace curvecore {
+
+static const int MAX_NURBS_DEGREE = 9;     ///< 栈上基函数工作区支持的最高阶数
+static const int MAX_DERIVATIVE_ORDER = 3; ///< evaluateDerivatives 支持的最高导数阶
+
+/**
+ * @struct NurbsView
+ * @brief NURBS 曲线数据的只读视图（SoA）
+ *        knots 含 count + degree + 1 个元素，degree 为实际使用的阶数
+ *        阶数超过 MAX_NURBS_DEGREE 的视图无效：各求值器的栈上工作区按该上限分配
+ */
+template <typename T, int Dim>
+struct NurbsView {
+    const T *coords[Dim];   ///< 各维坐标数组
+    const T *weights;       ///< 权重数组
+    const T *knots;         ///< 节点向量
+    int count;              ///< 控制点数
+    int degree;             ///< 阶数
+
+    bool isValid() const { return count >= 2 && degree >= 1 && degree <= MAX_NURBS_DEGREE && degree < count; }
+    T domainBegin() const { return knots[degree]; }
+    T domainEnd() const { return knots[count]; }
+};
+
+/**
+ * @brief 定义域 [begin, end] 上 res 等分网格的第 k 个参数，k = res 时精确等于 end
+ *        从文件加载的节点向量不一定在 [0,1] 上，均匀采样一律经此映射
+ */
+template <typename T>
+inline T uniformParameter(T begin, T end, int k, int res)
+{
+    return k == res ? end : begin + (end - begin) * static_cast<T>(k) / static_cast<T>(res);
+}
+
+/**
+ * @brief 二分查找参数 t 所在的节点区间 [u_span, u_span+1)
+ * @param n 最后一个控制点下标
+ * @param p 阶数
+ */
+template <typename T>
+inline int findSpan(const T *knots, int n, int p, T t)
+{
+    if (t >= knots[n + 1]) return n;
+    if (t <= knots[p]) return p;
+
+    int low = p, high = n + 1;
+    int mid = (low + high) / 2;
+    while (t < knots[mid] || t >= knots[mid + 1]) {
+        if (t < knots[mid]) high = mid;
+        else low = mid;
+        mid = (low + high) / 2;
+    }
+    return mid;
+}
+
+/**
+ * @brief 计算区间 span 上 p+1 个非零基函数 N[0..p] = N_{span-p..span, p}(t)
+ *        三角形迭代（Cox–de Boor），无递归，O(p²)
+ */
+template <typename T>
+inline void basisFunctions(const T *knots, int span, int p, T t, T *N)
+{
+    T left[MAX_NURBS_DEGREE + 1], right[MAX_NURBS_DEGREE + 1];
+
+    N[0] = T(1);
+    for (int j = 1; j <= p; ++j) {
+        left[j] = t - knots[span + 1 - j];
+        right[j] = knots[span + j] - t;
+        T saved = T(0);
+        for (int r = 0; r < j; ++r) {
+            T temp = N[r] / (right[r + 1] + left[j - r]);
+            N[r] = saved + right[r + 1] * temp;
+            saved = left[j - r] * temp;
+        }
+        N[j] = saved;
+    }
+}
+
+/**
+ * @brief 用已知节点区间与基函数值做有理加权求和
+ */
+template <typename T, int Dim>
+inline void combineBasis(const NurbsView<T, Dim> &v, int span, const T *N, T *out)
+{
+    T acc[Dim];
+    for (int d = 0; d < Dim; ++d) acc[d] = T(0);
+    T denominator = T(0);
+
+    for (int j = 0, i = span - v.degree; j <= v.degree; ++j, ++i) {
+        T basis = N[j] * v.weights[i];
+        for (int d = 0; d < Dim; ++d) acc[d] += v.coords[d][i] * basis;
+        denominator += basis;
+    }
+
+    for (int d = 0; d < Dim; ++d)
+        out[d] = denominator != T(0) ? acc[d] / denominator : T(0);
+}
+
+/**
+ * @brief 批量求值（任意阶数），结果按维度写入 out[d][0..n)
+ *        参数通常单调递增，先复用上一次的节点区间，命中失败才二分查找
+ */
+template <typename T, int Dim>
+inline void evaluateManyGeneric(const NurbsView<T, Dim> &v, const T *t, size_t n, T *const *out)
+{
+    const T begin = v.domainBegin(), end = v.domainEnd();
+    const int last = v.count - 1;
+    int span = v.degree;
+    T N[MAX_NURBS_DEGREE + 1];
+    T p[Dim];
+
+    for (size_t k = 0; k < n; ++k) {
+        T u = std::min(std::max(t[k], begin), end);
+        if (u < v.knots[span] || u >= v.knots[span + 1])
+            span = findSpan(v.knots, last, v.degree, u);
+        basisFunctions(v.knots, span, v.degree, u, N);
+        combineBasis(v, span, N, p);
+        for (int d = 0; d < Dim; ++d) out[d][k] = p[d];
+    }
+}
+
+/**
+ * @brief 用基函数表中的 [begin, end) 样本重新加权求和（任意阶数）
+ * @param spans  每个样本所在节点区间
+ * @param values 每个样本的 p+1 个基函数值，按样本连续存放
+ */
+template <typename T, int Dim>
+inline void combineTableGeneric(const NurbsView<T, Dim> &v, const int *spans, const T *values,
+                                int begin, int end, T *const *out)
+{
+    const int stride = v.degree + 1;
+    T p[Dim];
+    for (int k = begin; k < end; ++k) {
+        combineBasis(v, spans[k], values + static_cast<size_t>(k) * stride, p);
+        for (int d = 0; d < Dim; ++d) out[d][k] = p[d];
+    }
+}
+
+//----------------------------------------
+// 编译期固定阶数的求值器
+//----------------------------------------
+
+namespace fixed {
+
+/**
+ * @brief Cox–de Boor 三角形第 J 行第 R 项，模板递归展开，无循环
+ */
+template <typename T, int J, int R, bool Done = (R >= J)>
+struct BasisRow {
+    static inline void run(T *N, const T *left, const T *right, T &saved)
+    {
+        T temp = N[R] / (right[R + 1] + left[J - R]);
+        N[R] = saved + right[R + 1] * temp;
+        saved = left[J - R] * temp;
+        BasisRow<T, J, R + 1>::run(N, left, right, saved);
+    }
+};
+
+template <typename T, int J, int R>
+struct BasisRow<T, J, R, true> {
+    static inline void run(T *, const T *, const T *, T &) {}
+};
+
+/**
+ * @brief 三角形前 J 行，left/right 工作区与 N 都在调用方栈上
+ */
+template <typename T, int J>
+struct BasisTriangle {
+    static inline void run(const T *knots, int span, T t, T *N, T *left, T *right)
+    {
+        BasisTriangle<T, J - 1>::run(knots, span, t, N, left, right);
+        left[J] = t - knots[span + 1 - J];
+        right[J] = knots[span + J] - t;
+        T saved = T(0);
+        BasisRow<T, J, 0>::run(N, left, right, saved);
+        N[J] = saved;
+    }
+};
+
+template <typename T>
+struct BasisTriangle<T, 0> {
+    static inline void run(const T *, int, T, T *N, T *, T *) { N[0] = T(1); }
+};
+
+/**
+ * @brief P 阶基函数 N[0..P]，与 basisFunctions 结果一致
+ */
+template <int P, typename T>
+inline void basisFunctions(const T *knots, int span, T t, T *N)
+{
+    T left[P + 1], right[P + 1];
+    BasisTriangle<T, P>::run(knots, span, t, N, left, right);
+}
+
+/**
+ * @brief P 阶有理加权求和，循环次数为编译期常量
+ */
+template <int P, typename T, int Dim>
+inline void combineBasis(const NurbsView<T, Dim> &v, int span, const T *N, T *out)
+{
+    T acc[Dim];
+    for (int d = 0; d < Dim; ++d) acc[d] = T(0);
+    T denominator = T(0);
+
+    const int first = span - P;
+    for (int j = 0; j <= P; ++j) {
+        T basis = N[j] * v.weights[first + j];
+        for (int d = 0; d < Dim; ++d) acc[d] += v.coords[d][first + j] * basis;
+        denominator += basis;
+    }
+
+    for (int d = 0; d < Dim; ++d)
+        out[d] = denominator != T(0) ? acc[d] / denominator : T(0);
+}
+
+template <int P, typename T, int Dim>
+inline void evaluateMany(const NurbsView<T, Dim> &v, const T *t, size_t n, T *const *out)
+{
+    const T begin = v.domainBegin(), end = v.domainEnd();
+    const int last = v.count - 1;
+    int span = P;
+    T N[P + 1];
+    T p[Dim];
+
+    for (size_t k = 0; k < n; ++k) {
+        T u = std::min(std::max(t[k], begin), end);
+        if (u < v.knots[span] || u >= v.knots[span + 1])
+            span = findSpan(v.knots, last, P, u);
+        fixed::basisFunctions<P>(v.knots, span, u, N);
+        fixed::combineBasis<P>(v, span, N, p);
+        for (int d = 0; d < Dim; ++d) out[d][k] = p[d];
+    }
+}
+
+template <int P, typename T, int Dim>
+inline void combineTable(const NurbsView<T, Dim> &v, const int *spans, const T *values,
+                         int begin, int end, T *const *out)
+{
+    T p[Dim];
+    for (int k = begin; k < end; ++k) {
+        fixed::combineBasis<P>(v, spans[k], values + static_cast<size_t>(k) * (P + 1), p);
+        for (int d = 0; d < Dim; ++d) out[d][k] = p[d];
+    }
+}
+
+} // namespace fixed
+
+static const int MAX_FIXED_DEGREE = 5;     ///< 有编译期特化求值器的最高阶数
+
+/**
+ * @struct DegreeDispatch
+ * @brief 按运行时阶数选择求值器：1..MAX_FIXED_DEGREE 阶走完全展开的特化版本，其余走通用版本
+ */
+template <typename T, int Dim>
+struct DegreeDispatch {
+    typedef void (*EvaluateManyFn)(const NurbsView<T, Dim> &, const T *, size_t, T *const *);
+    typedef void (*CombineTableFn)(const NurbsView<T, Dim> &, const int *, const T *,
+                                   int, int, T *const *);
+
+    static EvaluateManyFn evaluateMany(int degree)
+    {
+        static const EvaluateManyFn table[MAX_FIXED_DEGREE + 1] = {
+            evaluateManyGeneric<T, Dim>,
+            fixed::evaluateMany<1, T, Dim>,
+            fixed::evaluateMany<2, T, Dim>,
+            fixed::evaluateMany<3, T, Dim>,
+            fixed::evaluateMany<4, T, Dim>,
+            fixed::evaluateMany<5, T, Dim>
+        };
+        return degree >= 1 && degree <= MAX_FIXED_DEGREE ? table[degree] : evaluateManyGeneric<T, Dim>;
+    }
+
+    static CombineTableFn combineTable(int degree)
+    {
+        static const CombineTableFn table[MAX_FIXED_DEGREE + 1] = {
+            combineTableGeneric<T, Dim>,
+            fixed::combineTable<1, T, Dim>,
+            fixed::combineTable<2, T, Dim>,
+            fixed::combineTable<3, T, Dim>,
+            fixed::combineTable<4, T, Dim>,
+            fixed::combineTable<5, T, Dim>
+        };
+        return degree >= 1 && degree <= MAX_FIXED_DEGREE ? table[degree] : combineTableGeneric<T, Dim>;
+    }
+};
+
+/**
+ * @brief 批量求值，结果按维度写入 out[d][0..n)，按阶数派发到特化求值器
+ */
+template <typename T, int Dim>
+inline void evaluateMany(const NurbsView<T, Dim> &v, const T *t, size_t n, T *const *out)
+{
+    if (!v.isValid()) {
+        for (int d = 0; d < Dim; ++d) std::fill(out[d], out[d] + n, T(0));
+        return;
+    }
+    DegreeDispatch<T, Dim>::evaluateMany(v.degree)(v, t, n, out);
+}
+
+/**
+ * @brief 单点求值，t 超出定义域时截断到端点
+ */
+template <typename T, int Dim>
+inline void evaluate(const NurbsView<T, Dim> &v, T t, T *out)
+{
+    T *dst[Dim];
+    for (int d = 0; d < Dim; ++d) dst[d] = out + d;
+    evaluateMany(v, &t, 1, dst);
+}
+
+/**
+ * @brief 区间 span 上 p+1 个非零基函数及其 0..order 阶导数（算法 A2.3）
+ * @param ders 输出，ders[k * (p+1) + j] = N^(k)_{span-p+j, p}(t)；超过 p 阶的导数为 0
+ */
+template <typename T>
+inline void basisDerivatives(const T *knots, int span, int p, T t, int order, T *ders)
+{
+    T ndu[MAX_NURBS_DEGREE + 1][MAX_NURBS_DEGREE + 1];
+    T left[MAX_NURBS_DEGREE + 1], right[MAX_NURBS_DEGREE + 1];
+    T a[2][MAX_NURBS_DEGREE + 1];
+    const int stride = p + 1;
+
+    // ndu 上三角存基函数，下三角存节点差
+    ndu[0][0] = T(1);
+    for (int j = 1; j <= p; ++j) {
+        left[j] = t - knots[span + 1 - j];
+        right[j] = knots[span + j] - t;
+        T saved = T(0);
+        for (int r = 0; r < j; ++r) {
+            ndu[j][r] = right[r + 1] + left[j - r];
+            T temp = ndu[r][j - 1] / ndu[j][r];
+            ndu[r][j] = saved + right[r + 1] * temp;
+            saved = left[j - r] * temp;
+        }
+        ndu[j][j] = saved;
+    }
+
+    std::fill(ders, ders + (order + 1) * stride, T(0));
+    for (int j = 0; j <= p; ++j) ders[j] = ndu[j][p];
+
+    const int top = std::min(order, p);
+    for (int r = 0; r <= p; ++r) {
+        int s1 = 0, s2 = 1;
+        a[0][0] = T(1);
+        for (int k = 1; k <= top; ++k) {
+            T d = T(0);
+            const int rk = r - k, pk = p - k;
+            if (r >= k) {
+                a[s2][0] = a[s1][0] / ndu[pk + 1][rk];
+                d = a[s2][0] * ndu[rk][pk];
+            }
+            const int j1 = rk >= -1 ? 1 : -rk;
+            const int j2 = r - 1 <= pk ? k - 1 : p - r;
+            for (int j = j1; j <= j2; ++j) {
+                a[s2][j] = (a[s1][j] - a[s1][j - 1]) / ndu[pk + 1][rk + j];
+                d += a[s2][j] * ndu[rk + j][pk];
+            }
+            if (r <= pk) {
+                a[s2][k] = -a[s1][k - 1] / ndu[pk + 1][r];
+                d += a[s2][k] * ndu[r][pk];
+            }
+            ders[k * stride + r] = d;
+            std::swap(s1, s2);
+        }
+    }
+
+    // 乘以 p!/(p-k)!
+    T factor = static_cast<T>(p);
+    for (int k = 1; k <= top; ++k) {
+        for (int j = 0; j <= p; ++j) ders[k * stride + j] *= factor;
+        factor *= static_cast<T>(p - k);
+    }
+}
+
+/**
+ * @brief 曲线在 t 处的 0..order 阶导数（order ≤ MAX_DERIVATIVE_ORDER），out[k * Dim + d]
+ *        先对齐次分子 A(t) = Σ N·w·P 与权重 w(t) = Σ N·w 求导，再按
+ *        C^(k) = (A^(k) - Σ_{i=1..k} C(k,i) w^(i) C^(k-i)) / w 递推（算法 A4.2）
+ *        t 超出定义域时截断到端点，端点处取单侧导数
+ */
+template <typename T, int Dim>
+inline void evaluateDerivatives(const NurbsView<T, Dim> &v, T t, int order, T *out)
+{
+    order = std::max(0, std::min(order, MAX_DERIVATIVE_ORDER));
+    std::fill(out, out + (order + 1) * Dim, T(0));
+    if (!v.isValid()) return;
+
+    const int p = v.degree, stride = p + 1;
+    const T u = std::min(std::max(t, v.domainBegin()), v.domainEnd());
+    const int span = findSpan(v.knots, v.count - 1, p, u);
+    T ders[(MAX_DERIVATIVE_ORDER + 1) * (MAX_NURBS_DEGREE + 1)];
+    basisDerivatives(v.knots, span, p, u, order, ders);
+
+    T A[MAX_DERIVATIVE_ORDER + 1][Dim], w[MAX_DERIVATIVE_ORDER + 1];
+    for (int k = 0; k <= order; ++k) {
+        w[k] = T(0);
+        for (int d = 0; d < Dim; ++d) A[k][d] = T(0);
+        for (int j = 0; j <= p; ++j) {
+            const int i = span - p + j;
+            const T basis = ders[k * stride + j] * v.weights[i];
+            for (int d = 0; d < Dim; ++d) A[k][d] += basis * v.coords[d][i];
+            w[k] += basis;
+        }
+    }
+    if (w[0] == T(0)) return;
+
+    static const int BINOMIAL[MAX_DERIVATIVE_ORDER + 1][MAX_DERIVATIVE_ORDER + 1] = {
+        { 1, 0, 0, 0 }, { 1, 1, 0, 0 }, { 1, 2, 1, 0 }, { 1, 3, 3, 1 }
+    };
+    for (int k = 0; k <= order; ++k) {
+        for (int d = 0; d < Dim; ++d) {
+            T value = A[k][d];
+            for (int i = 1; i <= k; ++i)
+                value -= BINOMIAL[k][i] * w[i] * out[(k - i) * Dim + d];
+            out[k * Dim + d] = value / w[0];
+        }
+    }
+}
+
+/**
+ * @brief 控制点 first..last 的包围盒
+ *        权重为正时，节点区间 [u_j, u_{j+1}) 上的曲线位于 P_{j-p}..P_j 的凸包内（强凸包性），
+ *        因此控制点 i 变化只影响 P_{i-p}..P_{i+p} 包围盒内的曲线
+ */
+template <typename T, int Dim>
+inline void controlBounds(const NurbsView<T, Dim> &v, int first, int last, T *lo, T *hi)
+{
+    first = std::max(first, 0);
+    last = std::min(last, v.count - 1);
+    for (int d = 0; d < Dim; ++d) {
+        lo[d] = v.coords[d][first];
+        hi[d] = v.coords[d][first];
+        for (int i = first + 1; i <= last; ++i) {
+            lo[d] = std::min(lo[d], v.coords[d][i]);
+            hi[d] = std::max(hi[d], v.coords[d][i]);
+        }
+    }
+}
+
+/**
+ * @brief 定义域内互不相同的节点（节点区间的端点），按升序写入 out
+ */
+template <typename T, int Dim>
+inline void spanBreaks(const NurbsView<T, Dim> &v, std::vector<T> &out)
+{
+    out.assign(v.knots + v.degree, v.knots + v.count + 1);
+    out.erase(std::unique(out.begin(), out.end()), out.end());
+}
+
+/**
+ * @brief 生成开放均匀节点向量：两端各 p+1 重，内部等距
+ */
+template <typename T>
+inline void openUniformKnots(int count, int p, std::vector<T> &knots)
+{
+    knots.clear();
+    int n = count - 1;
+    if (n < 1 || p < 1) return;
+
+    int m = n + p + 1;
+    knots.resize(m + 1);
+    for (int i = 0; i <= p; ++i) knots[i] = T(0);
+    for (int i = m - p; i <= m; ++i) knots[i] = T(1);
+    for (int i = p + 1; i < m - p; ++i)
+        knots[i] = static_cast<T>(i - p) / static_cast<T>(n - p + 1);
+}
+
+/**
+ * @class NurbsCurve
+ * @brief 持有 SoA 数据的 NURBS 曲线
+ *
+ * 控制点数不足 degree+1 时实际阶数退化为 n（Bézier），保证节点向量合法。
+ * 增删控制点或修改阶数会重建开放均匀节点向量；移动点、修改权重不影响节点。
+ */
+template <typename T, int Dim>
+class NurbsCurve
+{
+public:
+    typedef T Scalar;
+    enum { Dimension = Dim };
+
+    explicit NurbsCurve(int degree = 3) : m_degree(degree) {}
+
+    int size() const { return static_cast<int>(m_weights.size()); }
+    bool isEmpty() const { return m_weights.empty(); }
+
+    int degree() const { return m_degree; }
+    int effectiveDegree() const { return std::max(0, std::min(m_degree, size() - 1)); }
+    void setDegree(int degree)
+    {
+        m_degree = degree;
+        updateKnots();
+    }
+
+    T coord(int d, int i) const { return m_coords[d][i]; }
+    T weight(int i) const { return m_weights[i]; }
+    const T *coords(int d) const { return m_coords[d].data(); }
+    const T *weights() const { return m_weights.data(); }
+    const std::vector<T> &knots() const { return m_knots; }
+
+    void point(int i, T *out) const
+    {
+        for (int d = 0; d < Dim; ++d) out[d] = m_coords[d][i];
+    }
+    void setPoint(int i, const T *p)
+    {
+        for (int d = 0; d < Dim; ++d) m_coords[d][i] = p[d];
+    }
+    void setWeight(int i, T w) { m_weights[i] = w; }
+
+    void reserve(int n)
+    {
+        for (int d = 0; d < Dim; ++d) m_coords[d].reserve(n);
+        m_weights.reserve(n);
+    }
+
+    void append(const T *p, T w = T(1))
+    {
+        insert(size(), p, w);
+    }
+
+    void insert(int i, const T *p, T w = T(1))
+    {
+        for (int d = 0; d < Dim; ++d) m_coords[d].insert(m_coords[d].begin() + i, p[d]);
+        m_weights.insert(m_weights.begin() + i, w);
+        updateKnots();
+    }
+
+    void remove(int i)
+    {
+        for (int d = 0; d < Dim; ++d) m_coords[d].erase(m_coords[d].begin() + i);
+        m_weights.erase(m_weights.begin() + i);
+        updateKnots();
+    }
+
+    void clear()
+    {
+        for (int d = 0; d < Dim; ++d) m_coords[d].clear();
+        m_weights.clear();
+        m_knots.clear();
+    }
+
+    /**
+     * @brief 整体替换控制点（批量加载），只重建一次节点向量
+     * @param coords 各维坐标数组，每个含 count 个元素
+     * @param weights 权重数组，为空时全部取 1
+     */
+    void assign(const T *const *coords, const T *weights, int count)
+    {
+        for (int d = 0; d < Dim; ++d) m_coords[d].assign(coords[d], coords[d] + count);
+        if (weights) m_weights.assign(weights, weights + count);
+        else m_weights.assign(count, T(1));
+        updateKnots();
+    }
+
+    /**
+     * @brief 使用自定义节点向量（如从文件加载），元素个数须为 size() + effectiveDegree() + 1
+     *        之后的增删点操作会恢复为开放均匀节点向量
+     * @return 个数不符时返回 false 且不修改
+     */
+    bool setKnots(const T *knots, int count)
+    {
+        if (count != size() + effectiveDegree() + 1) return false;
+        m_knots.assign(knots, knots + count);
+        return true;
+    }
+
+    NurbsView<T, Dim> view() const
+    {
+        NurbsView<T, Dim> v;
+        for (int d = 0; d < Dim; ++d) v.coords[d] = m_coords[d].data();
+        v.weights = m_weights.data();
+        v.knots = m_knots.data();
+        v.count = size();
+        v.degree = effectiveDegree();
+        return v;
+    }
+
+    void controlBounds(int first, int last, T *lo, T *hi) const
+    {
+        curvecore::controlBounds(view(), first, last, lo, hi);
+    }
+    void evaluate(T t, T *out) const { curvecore::evaluate(view(), t, out); }
+    void evaluateDerivatives(T t, int order, T *out) const
+    {
+        curvecore::evaluateDerivatives(view(), t, order, out);
+    }
+    void evaluateMany(const T *t, size_t n, T *const *out) const
+    {
+        curvecore::evaluateMany(view(), t, n, out);
+    }
+
+private:
+    void updateKnots() { openUniformKnots(size(), effectiveDegree(), m_knots); }
+
+    int m_degree;
+    std::vector<T> m_coords[Dim];
+    std::vector<T> m_weights;
+    std::vector<T> m_knots;
+};
+
+} // namespace curvecore
+
+#endif // CURVECORE_NURBSCURVE_H
@@ -0,0 +1,98 @@
+/**
+ * @file ParallelSampling.h
+ * @brief 基于 ThreadPool 的并行曲线采样
+ *
+ * NURBS 按参数区间分块，Hermite 按曲线段分块；每块写入输出数组中各自的区间，
+ * 输出顺序与串行版本一致。
+ */
+#ifndef CURVECORE_PARALLELSAMPLING_H
+#define CURVECORE_PARALLELSAMPLING_H
+
+#include "HermiteSpline.h"
+#include "NurbsCurve.h"
+#include "ThreadPool.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace curvecore {
+
+static const size_t PARALLEL_SAMPLE_GRAIN = 4096;   ///< 每块的最少样本数，低于此值的任务串行执行
+
+/**
+ * @brief 并行批量求值 NURBS：参数 t[0..n) 按 grain 分块，每块独立查找节点区间
+ */
+template <typename T, int Dim>
+inline void parallelEvaluateMany(ThreadPool &pool, const NurbsView<T, Dim> &v, const T *t, size_t n,
+                                 T *const *out, size_t grain = PARALLEL_SAMPLE_GRAIN)
+{
+    pool.parallelFor(0, n, grain, [&](size_t b, size_t e) {
+        T *dst[Dim];
+        for (int d = 0; d < Dim; ++d) dst[d] = out[d] + b;
+        evaluateMany(v, t + b, e - b, dst);
+    });
+}
+
+/**
+ * @brief 并行批量求值 Hermite 样条（全局参数）
+ */
+template <typename T, int Dim>
+inline void parallelEvaluateMany(ThreadPool &pool, const HermiteView<T, Dim> &v, const T *t, size_t n,
+                                 T *const *out, size_t grain = PARALLEL_SAMPLE_GRAIN)
+{
+    pool.parallelFor(0, n, grain, [&](size_t b, size_t e) {
+        T *dst[Dim];
+        for (int d = 0; d < Dim; ++d) dst[d] = out[d] + b;
+        evaluateMany(v, t + b, e - b, dst);
+    });
+}
+
+/**
+ * @brief 对指定的若干段做均匀采样，段 i 写入 out[d][i*res ..]
+ *        最后一段额外写入 s = 1 的端点，与编辑器的段缓存布局一致
+ * @param segments 需要采样的段下标
+ * @param params   段内局部参数网格 s_j = j / res，j = 0..res
+ */
+template <typename T, int Dim>
+inline void parallelSampleSegments(ThreadPool &pool, const HermiteView<T, Dim> &v,
+                                   const int *segments, size_t segmentCount,
+                                   const T *params, int res, T *const *out)
+{
+    const int last = v.segmentCount() - 1;
+    size_t grain = std::max<size_t>(PARALLEL_SAMPLE_GRAIN / std::max(res, 1), 1);
+
+    pool.parallelFor(0, segmentCount, grain, [&](size_t b, size_t e) {
+        for (size_t k = b; k < e; ++k) {
+            int i = segments[k];
+            T c[Dim][4];
+            segmentCoeffs(v, i, c);
+
+            size_t offset = static_cast<size_t>(i) * res;
+            T *dst[Dim];
+            for (int d = 0; d < Dim; ++d) dst[d] = out[d] + offset;
+            sampleSegment<T, Dim>(c, params, i == last ? res + 1 : res, dst);
+        }
+    });
+}
+
+/**
+ * @brief 对整条 Hermite 样条均匀采样，每段 res 个样本，共 segments*res+1 个
+ */
+template <typename T, int Dim>
+inline void parallelSampleUniform(ThreadPool &pool, const HermiteView<T, Dim> &v, int res,
+                                  T *const *out)
+{
+    if (!v.isValid() || res < 1) return;
+
+    std::vector<T> params(res + 1);
+    for (int j = 0; j <= res; ++j) params[j] = static_cast<T>(j) / res;
+
+    std::vector<int> segments(v.segmentCount());
+    for (int i = 0; i < v.segmentCount(); ++i) segments[i] = i;
+
+    parallelSampleSegments(pool, v, segments.data(), segments.size(), params.data(), res, out);
+}
+
+} // namespace curvecore
+
+#endif // CURVECORE_PARALLELSAMPLING_H
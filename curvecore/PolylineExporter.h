@@ -0,0 +1,410 @@
+/**
+ * @file PolylineExporter.h
+ * @brief 流式折线导出：求值 → 简化 → 写出，内存占用与输出规模无关
+ *
+ * 生产者（调用线程）按固定块大小求值，可选地对每块做 Douglas–Peucker 简化并编码；
+ * 编码后的块交给写出线程异步输出到文件、套接字等任意 Sink。块缓冲区来自固定大小的池，
+ * 写出跟不上时生产者阻塞等待空闲缓冲区，因此总内存为 bufferCount × 块大小。
+ *
+ * 相邻块共享边界点：第 k 块的首点即第 k-1 块的末点，只输出一次，简化时块端点总是保留。
+ *
+ * 等弧长导出时样本在弧长 [0, L] 上均匀分布，求值前经 ArcLengthTable 换算为曲线参数。
+ */
+#ifndef CURVECORE_POLYLINEEXPORTER_H
+#define CURVECORE_POLYLINEEXPORTER_H
+
+#include "ArcLength.h"
+#include "HermiteSpline.h"
+#include "KnotInsertion.h"
+#include "NurbsCurve.h"
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace curvecore {
+
+enum ExportFormat {
+    EXPORT_TEXT = 0,        ///< 每行一个点，坐标以空格分隔
+    EXPORT_BINARY = 1       ///< 每点 Dim 个标量，按点交错存放（本机字节序）
+};
+
+enum ExportSpacing {
+    EXPORT_UNIFORM_PARAMETER = 0,   ///< 参数 t 等距
+    EXPORT_UNIFORM_ARC_LENGTH = 1   ///< 弧长等距（恒速遍历）
+};
+
+/**
+ * @struct ExportSettings
+ * @brief 导出参数
+ */
+struct ExportSettings {
+    std::uint64_t samples = 100000;     ///< 均匀采样点数（含两端），至少 2
+    ExportSpacing spacing = EXPORT_UNIFORM_PARAMETER;
+    ArcLengthSettings arcLength;        ///< 等弧长导出时的弧长表精度
+    size_t chunkSamples = 65536;        ///< 每块样本数
+    int bufferCount = 4;                ///< 缓冲池大小（>= 2 才能流水线化）
+    double tolerance = 0.0;             ///< 块内 Douglas–Peucker 容差，<= 0 时不简化
+    ExportFormat format = EXPORT_TEXT;
+    int precision = 6;                  ///< 文本格式的小数位数（截断到 0–64）
+    ThreadPool *pool = nullptr;         ///< 非空时块内求值并行执行
+};
+
+/**
+ * @struct ExportStats
+ * @brief 导出结果统计
+ */
+struct ExportStats {
+    std::uint64_t evaluated = 0;        ///< 求值的样本数
+    std::uint64_t written = 0;          ///< 写出的点数（简化后）
+    std::uint64_t bytes = 0;            ///< 写出的字节数
+    bool ok = false;                    ///< Sink 全部写入成功
+};
+
+/**
+ * @brief 对 n 个点做 Douglas–Peucker 简化，keep[i] 置 1 表示保留；两端点总是保留
+ *        使用显式栈，避免长块上的递归过深
+ */
+template <typename T, int Dim>
+inline void douglasPeucker(const T *const *coords, size_t n, T tolerance, unsigned char *keep,
+                           std::vector<std::pair<size_t, size_t> > &stack)
+{
+    std::fill(keep, keep + n, 0);
+    if (n == 0) return;
+    keep[0] = keep[n - 1] = 1;
+
+    const T tolerance2 = tolerance * tolerance;
+    stack.clear();
+    if (n > 2) stack.push_back(std::make_pair(size_t(0), n - 1));
+
+    while (!stack.empty()) {
+        size_t a = stack.back().first, b = stack.back().second;
+        stack.pop_back();
+
+        T ab[Dim], len2 = T(0);
+        for (int d = 0; d < Dim; ++d) {
+            ab[d] = coords[d][b] - coords[d][a];
+            len2 += ab[d] * ab[d];
+        }
+
+        size_t worst = a;
+        T worst2 = T(0);
+        for (size_t i = a + 1; i < b; ++i) {
+            T u = T(0);
+            if (len2 > T(0)) {
+                for (int d = 0; d < Dim; ++d) u += (coords[d][i] - coords[d][a]) * ab[d];
+                u = std::min(std::max(u / len2, T(0)), T(1));
+            }
+            T dist2 = T(0);
+            for (int d = 0; d < Dim; ++d) {
+                T e = coords[d][i] - coords[d][a] - u * ab[d];
+                dist2 += e * e;
+            }
+            if (dist2 > worst2) {
+                worst2 = dist2;
+                worst = i;
+            }
+        }
+
+        if (worst2 > tolerance2) {
+            keep[worst] = 1;
+            if (worst - a > 1) stack.push_back(std::make_pair(a, worst));
+            if (b - worst > 1) stack.push_back(std::make_pair(worst, b));
+        }
+    }
+}
+
+/**
+ * @class PolylineExporter
+ * @tparam Eval 批量求值函数，签名 void(const T *t, size_t n, T *const *out)
+ * @tparam Sink 输出函数，签名 bool(const void *data, size_t bytes)，在写出线程上调用
+ */
+template <typename T, int Dim, typename Eval, typename Sink>
+class PolylineExporter
+{
+public:
+    PolylineExporter(const Eval &eval, Sink &sink, const ExportSettings &settings)
+        : m_eval(eval), m_sink(sink), m_settings(settings)
+    {
+        m_settings.chunkSamples = std::max<size_t>(m_settings.chunkSamples, 2);
+        m_settings.bufferCount = std::max(m_settings.bufferCount, 1);
+    }
+
+    /**
+     * @brief 导出参数区间 [t0, t1] 上的均匀样本
+     */
+    ExportStats run(T t0, T t1)
+    {
+        ExportStats stats;
+        const std::uint64_t total = std::max<std::uint64_t>(m_settings.samples, 2);
+        const std::uint64_t step = m_settings.chunkSamples - 1;   // 相邻块共享一个边界点
+
+        m_failed = false;
+        m_done = false;
+        m_bytes = 0;
+        m_free.clear();
+        m_ready.clear();
+        m_buffers.clear();
+        for (int i = 0; i < m_settings.bufferCount; ++i) {
+            m_buffers.push_back(std::unique_ptr<Chunk>(new Chunk));
+            m_free.push_back(m_buffers.back().get());
+        }
+
+        std::thread writer(&PolylineExporter::writerLoop, this);
+
+        for (std::uint64_t first = 0; first + 1 < total && !failed(); first += step) {
+            size_t n = static_cast<size_t>(std::min<std::uint64_t>(step + 1, total - first));
+            Chunk *chunk = acquireFree();
+            if (!chunk) break;
+
+            produce(*chunk, first, n, total, t0, t1, first == 0);
+            stats.evaluated += first == 0 ? n : n - 1;
+            stats.written += chunk->points;
+            submit(chunk);
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_done = true;
+        }
+        m_readyChanged.notify_all();
+        writer.join();
+
+        stats.bytes = m_bytes;
+        stats.ok = !m_failed;
+        return stats;
+    }
+
+private:
+    struct Chunk {
+        std::vector<T> params;
+        std::vector<T> coords[Dim];
+        std::vector<unsigned char> keep;
+        std::vector<char> bytes;
+        std::uint64_t points = 0;
+    };
+
+    bool failed()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_failed;
+    }
+
+    Chunk *acquireFree()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_freeChanged.wait(lock, [this] { return m_failed || !m_free.empty(); });
+        if (m_failed) return nullptr;
+        Chunk *chunk = m_free.back();
+        m_free.pop_back();
+        return chunk;
+    }
+
+    void submit(Chunk *chunk)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_ready.push_back(chunk);
+        }
+        m_readyChanged.notify_one();
+    }
+
+    /**
+     * @brief 求值、简化并编码一块样本 [first, first+n)
+     * @param includeFirst 是否输出首点（只有第一块输出，其余块的首点已由上一块输出）
+     */
+    void produce(Chunk &c, std::uint64_t first, size_t n, std::uint64_t total, T t0, T t1,
+                 bool includeFirst)
+    {
+        c.params.resize(n);
+        for (size_t j = 0; j < n; ++j) {
+            std::uint64_t i = first + j;
+            c.params[j] = i + 1 == total ? t1
+                        : t0 + (t1 - t0) * static_cast<T>(static_cast<double>(i) / (total - 1));
+        }
+
+        T *out[Dim];
+        for (int d = 0; d < Dim; ++d) {
+            c.coords[d].resize(n);
+            out[d] = c.coords[d].data();
+        }
+        if (m_settings.pool) {
+            m_settings.pool->parallelFor(0, n, 4096, [&](size_t b, size_t e) {
+                T *dst[Dim];
+                for (int d = 0; d < Dim; ++d) dst[d] = out[d] + b;
+                m_eval(c.params.data() + b, e - b, dst);
+            });
+        } else {
+            m_eval(c.params.data(), n, out);
+        }
+
+        c.keep.resize(n);
+        if (m_settings.tolerance > 0.0)
+            douglasPeucker<T, Dim>(out, n, static_cast<T>(m_settings.tolerance), c.keep.data(), m_stack);
+        else
+            std::fill(c.keep.begin(), c.keep.end(), 1);
+
+        encode(c, n, includeFirst ? 0 : 1);
+    }
+
+    void encode(Chunk &c, size_t n, size_t begin)
+    {
+        c.bytes.clear();
+        c.points = 0;
+        if (m_settings.format == EXPORT_BINARY) {
+            c.bytes.reserve(n * Dim * sizeof(T));
+            for (size_t j = begin; j < n; ++j) {
+                if (!c.keep[j]) continue;
+                for (int d = 0; d < Dim; ++d) {
+                    const char *p = reinterpret_cast<const char *>(&c.coords[d][j]);
+                    c.bytes.insert(c.bytes.end(), p, p + sizeof(T));
+                }
+                ++c.points;
+            }
+            return;
+        }
+
+        // 直接格式化到输出缓冲：每个值先预留 %.*f 的最长输出
+        // （符号 + DBL_MAX 的 309 位整数 + 小数点 + 小数位 + 分隔符），写完再截到实际长度
+        const int precision = std::min(std::max(m_settings.precision, 0), 64);
+        const size_t bound = 312 + precision;
+        for (size_t j = begin; j < n; ++j) {
+            if (!c.keep[j]) continue;
+            for (int d = 0; d < Dim; ++d) {
+                const size_t used = c.bytes.size();
+                c.bytes.resize(used + bound + 1);   // snprintf 还会写结尾的 '\0'
+                int len = std::snprintf(c.bytes.data() + used, bound + 1, d + 1 < Dim ? "%.*f " : "%.*f\n",
+                                        precision, static_cast<double>(c.coords[d][j]));
+                c.bytes.resize(used + (len > 0 ? std::min(static_cast<size_t>(len), bound) : 0));
+            }
+            ++c.points;
+        }
+    }
+
+    void writerLoop()
+    {
+        for (;;) {
+            Chunk *chunk;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_readyChanged.wait(lock, [this] { return m_done || !m_ready.empty(); });
+                if (m_ready.empty()) return;
+                chunk = m_ready.front();
+                m_ready.pop_front();
+            }
+
+            bool ok = chunk->bytes.empty() || m_sink(chunk->bytes.data(), chunk->bytes.size());
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (ok) m_bytes += chunk->bytes.size();
+                else m_failed = true;
+                m_free.push_back(chunk);
+            }
+            m_freeChanged.notify_one();
+        }
+    }
+
+    const Eval &m_eval;
+    Sink &m_sink;
+    ExportSettings m_settings;
+    std::vector<std::pair<size_t, size_t> > m_stack;
+
+    std::vector<std::unique_ptr<Chunk> > m_buffers;
+    std::vector<Chunk *> m_free;
+    std::deque<Chunk *> m_ready;
+    std::mutex m_mutex;
+    std::condition_variable m_freeChanged;
+    std::condition_variable m_readyChanged;
+    std::uint64_t m_bytes = 0;
+    bool m_failed = false;
+    bool m_done = false;
+};
+
+/**
+ * @class ArcLengthEval
+ * @brief 把弧长样本换算为参数后交给内层求值函数；按小块换算，不额外分配
+ */
+template <typename T, int Dim, typename Eval>
+class ArcLengthEval
+{
+public:
+    ArcLengthEval(const ArcLengthTable<T> &table, const Eval &eval) : m_table(table), m_eval(eval) {}
+
+    void operator()(const T *s, size_t n, T *const *out) const
+    {
+        static const size_t BLOCK = 256;
+        T params[BLOCK];
+        for (size_t begin = 0; begin < n; begin += BLOCK) {
+            size_t count = std::min(BLOCK, n - begin);
+            m_table.parametersAt(s + begin, count, params);
+            T *dst[Dim];
+            for (int d = 0; d < Dim; ++d) dst[d] = out[d] + begin;
+            m_eval(params, count, dst);
+        }
+    }
+
+private:
+    const ArcLengthTable<T> &m_table;
+    const Eval &m_eval;
+};
+
+/**
+ * @brief 按 settings.spacing 在参数区间 [t0, t1] 或弧长区间 [0, L] 上导出
+ */
+template <typename T, int Dim, typename View, typename Eval, typename Sink>
+inline ExportStats runExport(const View &v, const Eval &eval, Sink &sink, const ExportSettings &settings,
+                             T t0, T t1)
+{
+    if (settings.spacing == EXPORT_UNIFORM_ARC_LENGTH) {
+        ArcLengthTable<T> table;
+        buildArcLengthTable(v, table, settings.arcLength);
+        if (table.isValid()) {
+            ArcLengthEval<T, Dim, Eval> arcEval(table, eval);
+            PolylineExporter<T, Dim, ArcLengthEval<T, Dim, Eval>, Sink> exporter(arcEval, sink, settings);
+            return exporter.run(T(0), table.length());
+        }
+    }
+    PolylineExporter<T, Dim, Eval, Sink> exporter(eval, sink, settings);
+    return exporter.run(t0, t1);
+}
+
+/**
+ * @brief 导出 NURBS 曲线定义域上的均匀样本
+ *        先分解为有理 Bézier 段，每个样本只做一次 Horner；节点向量未夹紧时退回逐样本基函数求值
+ */
+template <typename T, int Dim, typename Sink>
+inline ExportStats exportPolyline(const NurbsView<T, Dim> &v, Sink sink, const ExportSettings &settings)
+{
+    if (!v.isValid()) return ExportStats();
+
+    BezierSegments<T, Dim> segments;
+    if (decomposeBezier(v, segments)) {
+        auto eval = [&segments](const T *t, size_t n, T *const *out) { segments.evaluateMany(t, n, out); };
+        return runExport<T, Dim>(v, eval, sink, settings, segments.domainBegin(), segments.domainEnd());
+    }
+
+    auto eval = [&v](const T *t, size_t n, T *const *out) { evaluateMany(v, t, n, out); };
+    return runExport<T, Dim>(v, eval, sink, settings, v.domainBegin(), v.domainEnd());
+}
+
+/**
+ * @brief 导出 Hermite 样条全局参数 [0,1] 上的均匀样本（或按 settings.spacing 等弧长）
+ */
+template <typename T, int Dim, typename Sink>
+inline ExportStats exportPolyline(const HermiteView<T, Dim> &v, Sink sink, const ExportSettings &settings)
+{
+    if (!v.isValid()) return ExportStats();
+    auto eval = [&v](const T *t, size_t n, T *const *out) { evaluateMany(v, t, n, out); };
+    return runExport<T, Dim>(v, eval, sink, settings, T(0), T(1));
+}
+
+} // namespace curvecore
+
+#endif // CURVECORE_POLYLINEEXPORTER_H
@@ -0,0 +1,457 @@
+/**
+ * @file Precision.h
+ * @brief 单精度 / 混合精度求值：float 内核与带误差上界的 double 回退
+ *
+ * 屏幕绘制只需要亚像素精度：float 使 SIMD 宽度加倍，基函数表与样本缓冲的内存带宽减半；
+ * 导出与文件读写仍使用 double。混合模式按节点区间 / 曲线段估计 float 求值的误差上界，
+ * 超过容差的区间改用 double 求值，其余区间使用 float。
+ *
+ * 误差模型（ε 为 float 单位舍入 2^-24，均为保守估计）：
+ * - NURBS 节点区间：E = ε·[(2p + 8)·M + 4·U·κ·S]
+ *   M 为支撑内控制点坐标的最大绝对值（数据与有理加权求和的舍入，权重为正时不发生抵消）；
+ *   U 为区间端点参数的最大绝对值，参数与节点舍入到 float 后的绝对误差为 ε·U；
+ *   S = max p·|P_j − P_{j-1}| / (u_{j+p} − u_j) 为非有理曲线的速度上界，κ 为支撑内最大 / 最小权重之比。
+ *   退化（极短）的节点区间与极端权重都使 κ·S 变大。基函数表由 double 建表时没有参数舍入，U 项为 0。
+ * - Hermite 段：幂基系数在 double 中求得后舍入，E = ε·[8·Σ|c_k| + (1 + 2·段数)·S]，
+ *   S 为段内 |dC/ds| 的上界；局部参数网格直接给出时不经过全局参数，段数项为 0。
+ * 坐标超出 float 可安全表示的范围、或支撑内权重之比超过 MAX_FLOAT_WEIGHT_RATIO 时总是回退。
+ */
+#ifndef CURVECORE_PRECISION_H
+#define CURVECORE_PRECISION_H
+
+#include "BasisTable.h"
+#include "CurveTessellation.h"
+#include "HermiteSpline.h"
+#include "NurbsCurve.h"
+#include "ParallelSampling.h"
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+namespace curvecore {
+
+/**
+ * @brief 求值精度
+ */
+enum EvalPrecision {
+    PRECISION_DOUBLE,       ///< 全部使用 double
+    PRECISION_FLOAT,        ///< 全部使用 float，不检查误差
+    PRECISION_MIXED         ///< 使用 float，误差上界超过容差的区间回退到 double
+};
+
+/**
+ * @struct PrecisionSettings
+ * @brief 求值精度与混合模式的容差
+ */
+struct PrecisionSettings {
+    EvalPrecision mode = PRECISION_MIXED;
+    double tolerance = 0.05;    ///< 允许的 float 误差上界（曲线坐标单位；编辑器中即像素）
+};
+
+static const double FLOAT_ROUNDOFF = 5.9604644775390625e-8;    ///< float 单位舍入 2^-24
+static const double MAX_FLOAT_MAGNITUDE = 1e15;   ///< float 中参与乘加的坐标上限，保证中间结果不溢出
+static const double MAX_FLOAT_WEIGHT_RATIO = 1e15;   ///< 支撑内最大 / 最小权重之比的上限，超过时 float 分母可能下溢
+
+/**
+ * @brief 节点区间 span 上 float 求值的误差上界，不能安全使用 float 时返回无穷大
+ * @param roundedParameters 参数与节点是否舍入到 float（float 求值为 true，由 double 建表为 false）
+ */
+template <int Dim>
+inline double floatSpanError(const NurbsView<double, Dim> &v, int span, bool roundedParameters)
+{
+    const double INF = std::numeric_limits<double>::infinity();
+    const int p = v.degree, first = span - p;
+    double magnitude = 0.0, speed = 0.0;
+    double minWeight = INF, maxWeight = 0.0;
+    for (int i = first; i <= span; ++i) {
+        const double w = v.weights[i];
+        if (!(w > 0.0 && w < INF)) return INF;
+        minWeight = std::min(minWeight, w);
+        maxWeight = std::max(maxWeight, w);
+
+        double chord2 = 0.0;
+        for (int d = 0; d < Dim; ++d) {
+            const double c = v.coords[d][i];
+            if (!(std::abs(c) <= MAX_FLOAT_MAGNITUDE)) return INF;
+            magnitude = std::max(magnitude, std::abs(c));
+            if (i > first) {
+                const double e = c - v.coords[d][i - 1];
+                chord2 += e * e;
+            }
+        }
+        // 导数控制点 p·(P_i − P_{i-1}) / (u_{i+p} − u_i)，分母为 0 的项不出现在导数中
+        const double h = v.knots[i + p] - v.knots[i];
+        if (i > first && h > 0.0) speed = std::max(speed, p * std::sqrt(chord2) / h);
+    }
+    if (maxWeight > minWeight * MAX_FLOAT_WEIGHT_RATIO) return INF;
+
+    double error = (2 * p + 8) * magnitude;
+    if (roundedParameters) {
+        const double u = std::max(std::abs(v.knots[span]), std::abs(v.knots[span + 1]));
+        error += 4.0 * u * (maxWeight / minWeight) * speed;
+    }
+    return FLOAT_ROUNDOFF * error;
+}
+
+/**
+ * @brief 一段三次曲线（double 幂基系数）用 float 求值的误差上界，不能安全使用 float 时返回无穷大
+ * @param parameterScale 局部参数的误差相对 ε 的倍数：局部参数网格为 1，由全局参数换算为 1 + 2·段数
+ *        各维用 L1 范数合并（比欧氏范数至多宽松 √Dim 倍），逐段判定时不做开方
+ */
+template <int Dim>
+inline double floatSegmentError(const double (*c)[4], double parameterScale)
+{
+    double magnitude = 0.0, speed = 0.0;
+    for (int d = 0; d < Dim; ++d) {
+        for (int k = 0; k < 4; ++k) {
+            if (!(std::abs(c[d][k]) <= MAX_FLOAT_MAGNITUDE)) return std::numeric_limits<double>::infinity();
+            magnitude += std::abs(c[d][k]);
+        }
+        speed += 3.0 * std::abs(c[d][0]) + 2.0 * std::abs(c[d][1]) + std::abs(c[d][2]);
+    }
+    return FLOAT_ROUNDOFF * (8.0 * magnitude + parameterScale * speed);
+}
+
+/**
+ * @brief 把样本转换为输出类型（float 与 double 互转）写入 out[d][0..n)
+ */
+template <int Dim, typename In, typename Out>
+inline void convertSamples(const In *const *in, size_t n, Out *const *out)
+{
+    for (int d = 0; d < Dim; ++d)
+        std::copy(in[d], in[d] + n, out[d]);
+}
+
+//----------------------------------------
+// NURBS
+//----------------------------------------
+
+/**
+ * @class MixedNurbs
+ * @brief NURBS 曲线的 float 数据副本与需要回退到 double 的节点区间
+ *        权重按最大值归一化（有理曲线对权重整体缩放不变），避免 float 中的溢出
+ */
+template <int Dim>
+class MixedNurbs
+{
+public:
+    EvalPrecision mode() const { return m_settings.mode; }
+    int fallbackCount() const { return m_fallbackCount; }
+    bool isFallback(int span) const { return m_fallback[span] != 0; }
+
+    /**
+     * @brief 转换整条曲线并标记回退区间；PRECISION_DOUBLE 时不准备 float 数据
+     * @param roundedParameters 见 floatSpanError：float 参数求值为 true，配合 double 建立的基函数表为 false
+     */
+    void assign(const NurbsView<double, Dim> &v, const PrecisionSettings &settings, bool roundedParameters)
+    {
+        m_settings = settings;
+        m_roundedParameters = roundedParameters;
+        m_degree = v.degree;
+        m_fallbackCount = 0;
+        m_fallback.assign(v.isValid() ? v.count : 0, 0);
+        if (!v.isValid() || settings.mode == PRECISION_DOUBLE) {
+            for (int d = 0; d < Dim; ++d) m_coords[d].clear();
+            m_weights.clear();
+            m_knots.clear();
+            return;
+        }
+
+        m_weightScale = *std::max_element(v.weights, v.weights + v.count);
+        if (!(m_weightScale > 0.0)) m_weightScale = 1.0;
+        for (int d = 0; d < Dim; ++d) m_coords[d].assign(v.coords[d], v.coords[d] + v.count);
+        m_weights.resize(v.count);
+        for (int i = 0; i < v.count; ++i) m_weights[i] = static_cast<float>(v.weights[i] / m_weightScale);
+        m_knots.assign(v.knots, v.knots + v.count + v.degree + 1);
+        markSpans(v, v.degree, v.count - 1);
+    }
+
+    /**
+     * @brief 控制点 i 的坐标或权重改变：只更新该点与受影响的节点区间 i..i+p
+     *        点数或阶数与上次 assign 不同、或权重超过归一化基准时整体重建
+     */
+    void updatePoint(const NurbsView<double, Dim> &v, int i)
+    {
+        if (m_settings.mode == PRECISION_DOUBLE) return;
+        if (!v.isValid() || v.degree != m_degree || static_cast<int>(m_weights.size()) != v.count
+                || !(v.weights[i] <= m_weightScale)) {
+            assign(v, m_settings, m_roundedParameters);
+            return;
+        }
+
+        for (int d = 0; d < Dim; ++d) m_coords[d][i] = static_cast<float>(v.coords[d][i]);
+        m_weights[i] = static_cast<float>(v.weights[i] / m_weightScale);
+        markSpans(v, std::max(i, v.degree), std::min(i + v.degree, v.count - 1));
+    }
+
+    NurbsView<float, Dim> view() const
+    {
+        NurbsView<float, Dim> v;
+        for (int d = 0; d < Dim; ++d) v.coords[d] = m_coords[d].data();
+        v.weights = m_weights.data();
+        v.knots = m_knots.data();
+        v.count = static_cast<int>(m_weights.size());
+        v.degree = m_degree;
+        return v;
+    }
+
+    /**
+     * @brief 批量求值；参数连续落在同类区间（float / 回退）的成批交给对应内核，结果转换为 Out
+     * @param v 与 assign 时相同的 double 曲线
+     */
+    template <typename Out>
+    void evaluateMany(const NurbsView<double, Dim> &v, const double *t, size_t n, Out *const *out) const
+    {
+        const NurbsView<float, Dim> fv = view();
+        const bool useFloat = m_settings.mode != PRECISION_DOUBLE && !m_weights.empty();
+        const double begin = v.domainBegin(), end = v.domainEnd();
+        const int last = v.count - 1;
+        int span = v.degree;
+        float local[BLOCK], floatBlock[Dim][BLOCK];
+        double doubleBlock[Dim][BLOCK];
+        float *floatScratch[Dim];
+        double *doubleScratch[Dim];
+        for (int d = 0; d < Dim; ++d) {
+            floatScratch[d] = floatBlock[d];
+            doubleScratch[d] = doubleBlock[d];
+        }
+
+        size_t k = 0;
+        while (k < n) {
+            bool fallback = !useFloat;
+            size_t m = 0;
+            while (k + m < n && m < BLOCK) {
+                if (useFloat && m_fallbackCount > 0) {
+                    const double u = std::min(std::max(t[k + m], begin), end);
+                    if (u < v.knots[span] || u >= v.knots[span + 1]) span = findSpan(v.knots, last, v.degree, u);
+                    if (m == 0) fallback = isFallback(span);
+                    else if (isFallback(span) != fallback) break;
+                }
+                ++m;
+            }
+
+            Out *dst[Dim];
+            for (int d = 0; d < Dim; ++d) dst[d] = out[d] + k;
+            if (fallback) {
+                curvecore::evaluateMany(v, t + k, m, doubleScratch);
+                convertSamples<Dim>(doubleScratch, m, dst);
+            } else {
+                for (size_t j = 0; j < m; ++j) local[j] = static_cast<float>(t[k + j]);
+                curvecore::evaluateMany(fv, local, m, floatScratch);
+                convertSamples<Dim>(floatScratch, m, dst);
+            }
+            k += m;
+        }
+    }
+
+    /**
+     * @brief 用 float 基函数表重新加权求和样本 [begin, end)，结果转换为 Out
+     *        回退区间内的样本按表的参数网格（table.parameter(k)）用 double 求值
+     * @param table 由 double 曲线建立的表（见 BasisTable::build），assign 时 roundedParameters 应为 false
+     */
+    template <typename Out>
+    void evaluateTable(const NurbsView<double, Dim> &v, const BasisTable<float> &table,
+                       int begin, int end, Out *const *out) const
+    {
+        const NurbsView<float, Dim> fv = view();
+        if (m_fallbackCount == 0) {
+            table.evaluate(fv, begin, end, out);
+            return;
+        }
+        double params[BLOCK], block[Dim][BLOCK];
+        double *scratch[Dim];
+        for (int d = 0; d < Dim; ++d) scratch[d] = block[d];
+
+        int k = begin;
+        while (k < end) {
+            const bool fallback = isFallback(table.span(k));
+            int m = 1;
+            while (k + m < end && m < static_cast<int>(BLOCK) && isFallback(table.span(k + m)) == fallback)
+                ++m;
+
+            if (fallback) {
+                for (int j = 0; j < m; ++j) params[j] = table.parameter(k + j);
+                curvecore::evaluateMany(v, params, m, scratch);
+                Out *dst[Dim];
+                for (int d = 0; d < Dim; ++d) dst[d] = out[d] + k;
+                convertSamples<Dim>(scratch, m, dst);
+            } else {
+                table.evaluate(fv, k, k + m, out);
+            }
+            k += m;
+        }
+    }
+
+private:
+    static const size_t BLOCK = 256;         ///< 分块大小，float 临时结果在栈上
+
+    void markSpans(const NurbsView<double, Dim> &v, int first, int last)
+    {
+        for (int span = first; span <= last; ++span) {
+            const bool fallback = m_settings.mode == PRECISION_MIXED && v.knots[span + 1] > v.knots[span]
+                && floatSpanError(v, span, m_roundedParameters) > m_settings.tolerance;
+            m_fallbackCount += (fallback ? 1 : 0) - m_fallback[span];
+            m_fallback[span] = fallback ? 1 : 0;
+        }
+    }
+
+    PrecisionSettings m_settings;
+    bool m_roundedParameters = true;
+    int m_degree = 0;
+    double m_weightScale = 1.0;             ///< 权重归一化基准（assign 时的最大权重）
+    std::vector<float> m_coords[Dim];
+    std::vector<float> m_weights;           ///< 归一化后的权重
+    std::vector<float> m_knots;
+    std::vector<unsigned char> m_fallback;  ///< 每个节点区间是否回退到 double，按区间下标
+    int m_fallbackCount = 0;
+};
+
+/**
+ * @brief 按精度设置均匀采样：定义域等分为 res 段，k = 0..res
+ */
+template <int Dim>
+inline void tessellateUniform(const NurbsView<double, Dim> &v, int res, Polyline<double, Dim> &out,
+                              const PrecisionSettings &settings)
+{
+    if (settings.mode == PRECISION_DOUBLE) {
+        tessellateUniform(v, res, out);
+        return;
+    }
+    out.clear();
+    if (!v.isValid() || res < 1) return;
+
+    MixedNurbs<Dim> mixed;
+    mixed.assign(v, settings, true);
+    std::vector<double> t(res + 1);
+    const double begin = v.domainBegin(), end = v.domainEnd();
+    for (int k = 0; k <= res; ++k) t[k] = uniformParameter(begin, end, k, res);
+
+    out.resize(t.size());
+    double *dst[Dim];
+    for (int d = 0; d < Dim; ++d) dst[d] = out.coords[d].data();
+    mixed.evaluateMany(v, t.data(), t.size(), dst);
+}
+
+//----------------------------------------
+// Hermite
+//----------------------------------------
+
+/**
+ * @brief 单维三次多项式采样：内核输出类型与目标相同时直接写入
+ */
+template <typename T>
+inline void sampleCubicInto(const T *c, const T *s, size_t n, T *out)
+{
+    sampleCubic(c, s, n, out);
+}
+
+/**
+ * @brief 单维三次多项式采样：类型不同时经栈上缓冲分块转换
+ */
+template <typename T, typename Out>
+inline void sampleCubicInto(const T *c, const T *s, size_t n, Out *out)
+{
+    const size_t BLOCK = 256;
+    T block[BLOCK];
+    for (size_t k = 0; k < n; k += BLOCK) {
+        const size_t m = std::min(BLOCK, n - k);
+        sampleCubic(c, s + k, m, block);
+        std::copy(block, block + m, out + k);
+    }
+}
+
+/**
+ * @brief 一段曲线在局部参数上采样：按精度设置与误差上界选择 float 或 double 内核，结果写为 Out
+ * @param s  局部参数 s[0..n)
+ * @param sf 同一组参数的 float 副本；各段共享参数网格，由调用方只转换一次
+ * @return 是否使用了 float
+ */
+template <int Dim, typename Out>
+inline bool sampleSegment(const double (*c)[4], const double *s, const float *sf, size_t n,
+                          Out *const *out, const PrecisionSettings &settings)
+{
+    const bool useFloat = settings.mode == PRECISION_FLOAT
+        || (settings.mode == PRECISION_MIXED && floatSegmentError<Dim>(c, 1.0) <= settings.tolerance);
+    for (int d = 0; d < Dim; ++d) {
+        if (useFloat) {
+            const float cf[4] = { static_cast<float>(c[d][0]), static_cast<float>(c[d][1]),
+                                  static_cast<float>(c[d][2]), static_cast<float>(c[d][3]) };
+            sampleCubicInto(cf, sf, n, out[d]);
+        } else {
+            sampleCubicInto(c[d], s, n, out[d]);
+        }
+    }
+    return useFloat;
+}
+
+/**
+ * @brief 按精度设置均匀采样：每段 res 个样本，共 segments*res+1 个
+ */
+template <int Dim>
+inline void tessellateUniform(const HermiteView<double, Dim> &v, int res, Polyline<double, Dim> &out,
+                              const PrecisionSettings &settings)
+{
+    if (settings.mode == PRECISION_DOUBLE) {
+        tessellateUniform(v, res, out);
+        return;
+    }
+    out.clear();
+    if (!v.isValid() || res < 1) return;
+
+    std::vector<double> s(res + 1);
+    for (int j = 0; j <= res; ++j) s[j] = static_cast<double>(j) / res;
+    const std::vector<float> sf(s.begin(), s.end());
+
+    const int segments = v.segmentCount();
+    out.resize(static_cast<size_t>(segments) * res + 1);
+    for (int i = 0; i < segments; ++i) {
+        double c[Dim][4];
+        segmentCoeffs(v, i, c);
+
+        double *dst[Dim];
+        for (int d = 0; d < Dim; ++d) dst[d] = out.coords[d].data() + static_cast<size_t>(i) * res;
+        sampleSegment<Dim>(c, s.data(), sf.data(), i == segments - 1 ? res + 1 : res, dst, settings);
+    }
+}
+
+/**
+ * @brief 按精度设置对指定的若干段并行采样，布局与 parallelSampleSegments 相同
+ * @return 回退到 double 的段数（PRECISION_DOUBLE 时为 0）
+ */
+template <int Dim, typename Out>
+inline int parallelSampleSegments(ThreadPool &pool, const HermiteView<double, Dim> &v,
+                                  const int *segments, size_t segmentCount,
+                                  const double *params, int res, Out *const *out,
+                                  const PrecisionSettings &settings)
+{
+    const int last = v.segmentCount() - 1;
+    size_t grain = std::max<size_t>(PARALLEL_SAMPLE_GRAIN / std::max(res, 1), 1);
+    std::atomic<int> fallbacks(0);
+    const std::vector<float> floatParams(params, params + res + 1);
+
+    pool.parallelFor(0, segmentCount, grain, [&](size_t b, size_t e) {
+        int local = 0;
+        for (size_t k = b; k < e; ++k) {
+            int i = segments[k];
+            double c[Dim][4];
+            segmentCoeffs(v, i, c);
+
+            size_t offset = static_cast<size_t>(i) * res;
+            Out *dst[Dim];
+            for (int d = 0; d < Dim; ++d) dst[d] = out[d] + offset;
+            if (!sampleSegment<Dim>(c, params, floatParams.data(), i == last ? res + 1 : res, dst, settings))
+                ++local;
+        }
+        fallbacks += local;
+    });
+    return settings.mode == PRECISION_DOUBLE ? 0 : fallbacks.load();
+}
+
+} // namespace curvecore
+
+#endif // CURVECORE_PRECISION_H
@@ -0,0 +1,407 @@
+/**
+ * @file Scene.h
+ * @brief 多曲线文档：逐曲线缓存细分结果与包围盒，并行重建脏曲线，BVH 用于剔除与拾取（二维）
+ *
+ * - 每条曲线持有自己的折线、包围盒与脏标志；修改曲线须经 editNurbs / editHermite 或 markDirty
+ * - update() 只在线程池上重新细分脏曲线，随后更新层次包围盒：
+ *   增删曲线后整体重建，否则自底向上重新拟合节点包围盒
+ * - query() 返回与矩形相交的曲线，pick() 返回距离某点最近的曲线
+ *
+ * 包围盒取自细分后的折线，与实际绘制的内容一致。
+ */
+#ifndef CURVECORE_SCENE_H
+#define CURVECORE_SCENE_H
+
+#include "CurveFile.h"
+#include "CurveTessellation.h"
+#include "LevelOfDetail.h"
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+namespace curvecore {
+
+enum SceneTessellationMode {
+    SCENE_UNIFORM,
+    SCENE_ADAPTIVE,
+    SCENE_LOD
+};
+
+/**
+ * @struct SceneSettings
+ * @brief 场景内所有曲线共用的细分参数
+ */
+struct SceneSettings {
+    SceneTessellationMode mode = SCENE_ADAPTIVE;
+    int resolution = 100;               ///< 均匀采样的样本数（NURBS 整条，Hermite 每段）
+    TessellationSettings adaptive;
+    Viewport viewport;                  ///< 视口细分所用视口
+    LodSettings lod;
+};
+
+template <typename T>
+class Scene
+{
+public:
+    /**
+     * @struct Curve
+     * @brief 场景中的一条曲线；kind 决定 nurbs 与 hermite 中哪一个有效
+     */
+    struct Curve {
+        CurveKind kind = CURVE_NURBS;
+        NurbsCurve<T, 2> nurbs;
+        HermiteSpline<T, 2> hermite;
+        Polyline<T, 2> line;            ///< 缓存的细分结果
+        T lo[2] = { T(0), T(0) };       ///< line 的包围盒；line 为空时无效
+        T hi[2] = { T(0), T(0) };
+        bool dirty = true;
+
+        bool hasBounds() const { return !line.isEmpty(); }
+    };
+
+    int size() const { return static_cast<int>(m_curves.size()); }
+    bool isEmpty() const { return m_curves.empty(); }
+    const Curve &curve(int i) const { return m_curves[i]; }
+
+    int addNurbs(const NurbsCurve<T, 2> &nurbs)
+    {
+        Curve c;
+        c.kind = CURVE_NURBS;
+        c.nurbs = nurbs;
+        return add(c);
+    }
+
+    int addHermite(const HermiteSpline<T, 2> &hermite)
+    {
+        Curve c;
+        c.kind = CURVE_HERMITE;
+        c.hermite = hermite;
+        return add(c);
+    }
+
+    /**
+     * @brief 删除第 i 条曲线，其后曲线的下标减一
+     */
+    void remove(int i)
+    {
+        m_curves.erase(m_curves.begin() + i);
+        m_topologyChanged = true;
+    }
+
+    void clear()
+    {
+        m_curves.clear();
+        m_nodes.clear();
+        m_order.clear();
+        m_topologyChanged = false;
+    }
+
+    /// 可写访问会把曲线标记为脏
+    NurbsCurve<T, 2> &editNurbs(int i)
+    {
+        markDirty(i);
+        return m_curves[i].nurbs;
+    }
+    HermiteSpline<T, 2> &editHermite(int i)
+    {
+        markDirty(i);
+        return m_curves[i].hermite;
+    }
+
+    void markDirty(int i) { m_curves[i].dirty = true; }
+    void markAllDirty()
+    {
+        for (Curve &c : m_curves) c.dirty = true;
+    }
+
+    const SceneSettings &settings() const { return m_settings; }
+    void setSettings(const SceneSettings &settings)
+    {
+        m_settings = settings;
+        markAllDirty();
+    }
+
+    /**
+     * @brief 并行重新细分所有脏曲线并更新层次包围盒
+     *        每条曲线是一个任务，任务之间只写各自的 Curve，无需加锁
+     * @return 本次重新细分的曲线数
+     */
+    int update(ThreadPool &pool)
+    {
+        m_work.clear();
+        for (int i = 0; i < size(); ++i)
+            if (m_curves[i].dirty) m_work.push_back(i);
+
+        pool.parallelFor(0, m_work.size(), 1, [this](size_t b, size_t e) {
+            for (size_t k = b; k < e; ++k) {
+                Curve &c = m_curves[m_work[k]];
+                tessellate(c);
+                c.dirty = false;
+            }
+        });
+
+        if (m_topologyChanged || (!m_work.empty() && m_nodes.empty())) buildHierarchy();
+        else if (!m_work.empty()) refitHierarchy();
+        m_topologyChanged = false;
+        return static_cast<int>(m_work.size());
+    }
+
+    /**
+     * @brief 场景包围盒，没有可见曲线时返回 false
+     */
+    bool bounds(T *lo, T *hi) const
+    {
+        if (m_nodes.empty()) return false;
+        for (int d = 0; d < 2; ++d) {
+            lo[d] = m_nodes[0].lo[d];
+            hi[d] = m_nodes[0].hi[d];
+        }
+        return true;
+    }
+
+    /**
+     * @brief 包围盒与矩形 [lo, hi] 相交的曲线（剔除），下标按层次顺序写入 out
+     */
+    void query(const T *lo, const T *hi, std::vector<int> &out) const
+    {
+        out.clear();
+        if (m_nodes.empty()) return;
+
+        int stack[STACK_SIZE];
+        int top = 0;
+        stack[top++] = 0;
+        while (top > 0) {
+            const Node &node = m_nodes[stack[--top]];
+            if (!overlaps(node.lo, node.hi, lo, hi)) continue;
+            if (node.count > 0) {
+                for (int k = node.first; k < node.first + node.count; ++k) {
+                    const Curve &c = m_curves[m_order[k]];
+                    if (overlaps(c.lo, c.hi, lo, hi)) out.push_back(m_order[k]);
+                }
+            } else {
+                stack[top++] = node.right;
+                stack[top++] = node.left;
+            }
+        }
+    }
+
+    /**
+     * @brief 距离 (x, y) 不超过 radius 的最近曲线（按折线距离），没有时返回 -1
+     *        节点按包围盒距离剪枝：盒距超过当前最近距离的子树不再访问
+     */
+    int pick(T x, T y, T radius, T *distance = nullptr) const
+    {
+        if (m_nodes.empty()) return -1;
+
+        const T p[2] = { x, y };
+        T best2 = radius * radius;
+        int best = -1;
+
+        int stack[STACK_SIZE];
+        int top = 0;
+        stack[top++] = 0;
+        while (top > 0) {
+            const Node &node = m_nodes[stack[--top]];
+            if (boxDistance2(node.lo, node.hi, p) > best2) continue;
+            if (node.count > 0) {
+                for (int k = node.first; k < node.first + node.count; ++k) {
+                    const Curve &c = m_curves[m_order[k]];
+                    if (boxDistance2(c.lo, c.hi, p) > best2) continue;
+                    T d2 = polylineDistance2(c.line, p);
+                    if (d2 <= best2) {
+                        best2 = d2;
+                        best = m_order[k];
+                    }
+                }
+            } else {
+                stack[top++] = node.right;
+                stack[top++] = node.left;
+            }
+        }
+        if (best >= 0 && distance) *distance = std::sqrt(best2);
+        return best;
+    }
+
+private:
+    static const int LEAF_SIZE = 4;     ///< 叶节点最多容纳的曲线数
+    static const int STACK_SIZE = 64;   ///< 中位数划分的树深约 log2(n)，64 层足够
+
+    /**
+     * @struct Node
+     * @brief 层次包围盒节点，按前序存放：左子节点紧随父节点；count > 0 为叶节点
+     */
+    struct Node {
+        T lo[2], hi[2];
+        int left, right;                ///< 内部节点的子节点下标
+        int first, count;               ///< 叶节点在 m_order 中的区间
+    };
+
+    int add(const Curve &c)
+    {
+        m_curves.push_back(c);
+        m_topologyChanged = true;
+        return size() - 1;
+    }
+
+    void tessellate(Curve &c) const
+    {
+        const SceneSettings &s = m_settings;
+        if (c.kind == CURVE_NURBS) {
+            const NurbsView<T, 2> v = c.nurbs.view();
+            if (s.mode == SCENE_ADAPTIVE) tessellateAdaptive(v, s.adaptive, c.line);
+            else if (s.mode == SCENE_LOD) tessellateLod(v, s.viewport, s.lod, c.line);
+            else tessellateUniform(v, s.resolution, c.line);
+        } else {
+            const HermiteView<T, 2> v = c.hermite.view();
+            if (s.mode == SCENE_ADAPTIVE) tessellateAdaptive(v, s.adaptive, c.line);
+            else if (s.mode == SCENE_LOD) tessellateLod(v, s.viewport, s.lod, c.line);
+            else tessellateUniform(v, s.resolution, c.line);
+        }
+
+        if (c.line.isEmpty()) return;
+        for (int d = 0; d < 2; ++d) {
+            const std::vector<T> &x = c.line.coords[d];
+            auto range = std::minmax_element(x.begin(), x.end());
+            c.lo[d] = *range.first;
+            c.hi[d] = *range.second;
+        }
+    }
+
+    /**
+     * @brief 按包围盒中心沿最长轴取中位数递归划分
+     */
+    void buildHierarchy()
+    {
+        m_nodes.clear();
+        m_order.clear();
+        for (int i = 0; i < size(); ++i)
+            if (m_curves[i].hasBounds()) m_order.push_back(i);
+        if (m_order.empty()) return;
+
+        m_nodes.reserve(2 * m_order.size() / LEAF_SIZE + 1);
+        buildNode(0, static_cast<int>(m_order.size()));
+    }
+
+    int buildNode(int first, int last)
+    {
+        int index = static_cast<int>(m_nodes.size());
+        m_nodes.push_back(Node());
+        unionBounds(first, last, m_nodes[index].lo, m_nodes[index].hi);
+
+        int count = last - first;
+        if (count <= LEAF_SIZE) {
+            m_nodes[index].first = first;
+            m_nodes[index].count = count;
+            m_nodes[index].left = m_nodes[index].right = -1;
+            return index;
+        }
+
+        const Node &node = m_nodes[index];
+        int axis = node.hi[0] - node.lo[0] >= node.hi[1] - node.lo[1] ? 0 : 1;
+        int mid = first + count / 2;
+        std::nth_element(m_order.begin() + first, m_order.begin() + mid, m_order.begin() + last,
+                         [this, axis](int a, int b) {
+            return m_curves[a].lo[axis] + m_curves[a].hi[axis] < m_curves[b].lo[axis] + m_curves[b].hi[axis];
+        });
+
+        // push_back 可能使引用失效，子节点建好后再按下标写回
+        int left = buildNode(first, mid);
+        int right = buildNode(mid, last);
+        m_nodes[index].left = left;
+        m_nodes[index].right = right;
+        m_nodes[index].first = 0;
+        m_nodes[index].count = 0;
+        return index;
+    }
+
+    /**
+     * @brief 曲线集合不变时只更新包围盒：前序存放保证子节点下标大于父节点，逆序遍历即自底向上
+     *        有曲线的细分结果由空变为非空或反之（如点数跨过 2）时树的成员变化，需整体重建
+     */
+    void refitHierarchy()
+    {
+        int bounded = 0;
+        for (const Curve &c : m_curves) bounded += c.hasBounds() ? 1 : 0;
+        bool sameMembers = bounded == static_cast<int>(m_order.size());
+        for (size_t k = 0; sameMembers && k < m_order.size(); ++k)
+            sameMembers = m_curves[m_order[k]].hasBounds();
+        if (!sameMembers) {
+            buildHierarchy();
+            return;
+        }
+        for (int n = static_cast<int>(m_nodes.size()) - 1; n >= 0; --n) {
+            Node &node = m_nodes[n];
+            if (node.count > 0) {
+                unionBounds(node.first, node.first + node.count, node.lo, node.hi);
+                continue;
+            }
+            const Node &a = m_nodes[node.left], &b = m_nodes[node.right];
+            for (int d = 0; d < 2; ++d) {
+                node.lo[d] = std::min(a.lo[d], b.lo[d]);
+                node.hi[d] = std::max(a.hi[d], b.hi[d]);
+            }
+        }
+    }
+
+    void unionBounds(int first, int last, T *lo, T *hi) const
+    {
+        for (int d = 0; d < 2; ++d) {
+            lo[d] = std::numeric_limits<T>::max();
+            hi[d] = std::numeric_limits<T>::lowest();
+        }
+        for (int k = first; k < last; ++k) {
+            const Curve &c = m_curves[m_order[k]];
+            for (int d = 0; d < 2; ++d) {
+                lo[d] = std::min(lo[d], c.lo[d]);
+                hi[d] = std::max(hi[d], c.hi[d]);
+            }
+        }
+    }
+
+    static bool overlaps(const T *alo, const T *ahi, const T *blo, const T *bhi)
+    {
+        return alo[0] <= bhi[0] && blo[0] <= ahi[0] && alo[1] <= bhi[1] && blo[1] <= ahi[1];
+    }
+
+    static T boxDistance2(const T *lo, const T *hi, const T *p)
+    {
+        T dist2 = T(0);
+        for (int d = 0; d < 2; ++d) {
+            T e = p[d] < lo[d] ? lo[d] - p[d] : (p[d] > hi[d] ? p[d] - hi[d] : T(0));
+            dist2 += e * e;
+        }
+        return dist2;
+    }
+
+    /**
+     * @brief 点到折线的最近距离平方；只有一个顶点时为到该点的距离
+     */
+    static T polylineDistance2(const Polyline<T, 2> &line, const T *p)
+    {
+        const T *x = line.coords[0].data(), *y = line.coords[1].data();
+        T a[2] = { x[0], y[0] };
+        T best2 = (p[0] - a[0]) * (p[0] - a[0]) + (p[1] - a[1]) * (p[1] - a[1]);
+        for (size_t i = 1; i < line.size(); ++i) {
+            T b[2] = { x[i], y[i] };
+            best2 = std::min(best2, chordDeviation2<T, 2>(p, a, b));
+            a[0] = b[0];
+            a[1] = b[1];
+        }
+        return best2;
+    }
+
+    std::vector<Curve> m_curves;
+    std::vector<Node> m_nodes;
+    std::vector<int> m_order;           ///< 叶节点引用的曲线下标
+    std::vector<int> m_work;            ///< 本次 update 的脏曲线（复用缓冲区）
+    SceneSettings m_settings;
+    bool m_topologyChanged = false;
+};
+
+} // namespace curvecore
+
+#endif // CURVECORE_SCENE_H
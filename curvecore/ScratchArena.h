@@ -0,0 +1,113 @@
+/**
+ * @file ScratchArena.h
+ * @brief 每帧临时内存：顺序分配、整体释放的线性分配器
+ *
+ * allocate() 只移动偏移量；reset() 一次性回收本帧的全部分配。
+ * 一帧内用尽当前内存块时追加新块，reset() 时把所有块合并为一个总容量相同的块，
+ * 因此经过一两帧预热后，稳定交互中的每帧都不再触发堆分配。
+ *
+ * 只用于可平凡析构的类型（坐标、下标、GPU 实例等），reset() 不调用析构函数。
+ */
+#ifndef CURVECORE_SCRATCHARENA_H
+#define CURVECORE_SCRATCHARENA_H
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+namespace curvecore {
+
+static const size_t SCRATCH_ARENA_BLOCK = 64 * 1024;   ///< 默认的最小块字节数
+
+class ScratchArena
+{
+public:
+    /**
+     * @param minimumBlock 新内存块的最小字节数；只用一次的局部 arena 可传 0，按需分配
+     */
+    explicit ScratchArena(size_t minimumBlock = SCRATCH_ARENA_BLOCK) : m_minimumBlock(minimumBlock) {}
+    ScratchArena(const ScratchArena &) = delete;
+    ScratchArena &operator=(const ScratchArena &) = delete;
+
+    /**
+     * @brief 分配 n 个未初始化的 T，内存在下一次 reset() 前有效
+     */
+    template <typename T>
+    T *allocate(size_t n)
+    {
+        static_assert(std::is_trivially_destructible<T>::value, "ScratchArena 不调用析构函数");
+        static_assert(alignof(T) <= alignof(std::max_align_t), "不支持超对齐类型");
+        return static_cast<T *>(allocateBytes(n * sizeof(T), alignof(T)));
+    }
+
+    /**
+     * @brief 回收本帧的全部分配；本帧用到多个块时合并为一个，下一帧同样的用量只占一块
+     */
+    void reset()
+    {
+        if (m_blocks.size() > 1) {
+            size_t total = capacity();
+            m_blocks.clear();
+            m_blocks.push_back(Block(total));
+        }
+        m_current = 0;
+        m_offset = 0;
+        m_used = 0;
+    }
+
+    size_t used() const { return m_used; }              ///< 本帧已分配的字节数
+    size_t highWater() const { return m_highWater; }    ///< 历史上单帧的最大用量
+
+    size_t capacity() const
+    {
+        size_t total = 0;
+        for (const Block &b : m_blocks) total += b.size;
+        return total;
+    }
+
+private:
+    struct Block {
+        explicit Block(size_t bytes) : data(new unsigned char[bytes]), size(bytes) {}
+        std::unique_ptr<unsigned char[]> data;
+        size_t size;
+    };
+
+    void *allocateBytes(size_t bytes, size_t align)
+    {
+        if (bytes == 0) bytes = 1;
+        for (;;) {
+            if (m_current < m_blocks.size()) {
+                size_t offset = (m_offset + align - 1) & ~(align - 1);
+                if (offset + bytes <= m_blocks[m_current].size) {
+                    m_offset = offset + bytes;
+                    m_used += bytes;
+                    m_highWater = std::max(m_highWater, m_used);
+                    return m_blocks[m_current].data.get() + offset;
+                }
+                if (m_current + 1 < m_blocks.size()) {
+                    ++m_current;
+                    m_offset = 0;
+                    continue;
+                }
+            }
+            // 新块至少与已有总容量相同，块数按对数增长
+            m_blocks.push_back(Block(std::max(std::max(bytes, capacity()), m_minimumBlock)));
+            m_current = m_blocks.size() - 1;
+            m_offset = 0;
+        }
+    }
+
+    size_t m_minimumBlock;
+    std::vector<Block> m_blocks;
+    size_t m_current = 0;       ///< 正在分配的块
+    size_t m_offset = 0;        ///< 当前块内已用字节数
+    size_t m_used = 0;
+    size_t m_highWater = 0;
+};
+
+} // namespace curvecore
+
+#endif // CURVECORE_SCRATCHARENA_H
@@ -0,0 +1,96 @@
+/**
+ * @file Tessellation.h
+ * @brief 基于弦偏差的自适应曲线细分（任意维度）
+ *
+ * 在参数区间中点求值，若曲线点到弦的距离超过容差则二分递归，
+ * 直到满足容差或达到最大深度。直线段只保留端点，急弯处自动加密。
+ */
+#ifndef CURVECORE_TESSELLATION_H
+#define CURVECORE_TESSELLATION_H
+
+namespace curvecore {
+
+/**
+ * @struct TessellationSettings
+ * @brief 自适应细分参数
+ */
+struct TessellationSettings {
+    double tolerance = 0.25;   ///< 弦偏差容差（与坐标同单位，编辑器中为像素）
+    int maxDepth = 10;         ///< 每个初始子区间的最大二分深度
+    int initialSplits = 4;     ///< 每个区间先均匀切分的份数，避免 S 形曲线中点恰好落在弦上
+};
+
+/**
+ * @brief 点 p 到线段 a-b 的距离平方
+ */
+template <typename T, int Dim>
+inline T chordDeviation2(const T *p, const T *a, const T *b)
+{
+    T len2 = T(0), dot = T(0);
+    for (int d = 0; d < Dim; ++d) {
+        T ab = b[d] - a[d];
+        len2 += ab * ab;
+        dot += (p[d] - a[d]) * ab;
+    }
+
+    T u = T(0);
+    if (len2 > T(0)) {
+        u = dot / len2;
+        u = u < T(0) ? T(0) : (u > T(1) ? T(1) : u);
+    }
+
+    T dist2 = T(0);
+    for (int d = 0; d < Dim; ++d) {
+        T e = p[d] - a[d] - u * (b[d] - a[d]);
+        dist2 += e * e;
+    }
+    return dist2;
+}
+
+/**
+ * @brief 递归细分 [t0, t1]，输出 (t0, t1] 上的顶点（不含起点）
+ * @param eval 求值函数，签名 void(T t, T *out)
+ * @param sink 顶点输出函数，签名 void(const T *p)
+ */
+template <typename T, int Dim, typename Eval, typename Sink>
+void adaptiveSubdivide(const Eval &eval, const Sink &sink, T t0, const T *p0, T t1, const T *p1,
+                       T tolerance2, int depth)
+{
+    T tm = T(0.5) * (t0 + t1);
+    T pm[Dim];
+    eval(tm, pm);
+
+    if (depth > 0 && chordDeviation2<T, Dim>(pm, p0, p1) > tolerance2) {
+        adaptiveSubdivide<T, Dim>(eval, sink, t0, p0, tm, pm, tolerance2, depth - 1);
+        adaptiveSubdivide<T, Dim>(eval, sink, tm, pm, t1, p1, tolerance2, depth - 1);
+    } else {
+        sink(p1);
+    }
+}
+
+/**
+ * @brief 对参数区间 [t0, t1] 做自适应细分，输出 (t0, t1] 上的顶点
+ *        调用方负责在首个区间前输出起点
+ */
+template <typename T, int Dim, typename Eval, typename Sink>
+void adaptiveTessellateInterval(const Eval &eval, const Sink &sink, T t0, T t1,
+                                const TessellationSettings &settings)
+{
+    int splits = settings.initialSplits > 0 ? settings.initialSplits : 1;
+    T tolerance2 = static_cast<T>(settings.tolerance * settings.tolerance);
+
+    T pa[Dim], pb[Dim];
+    eval(t0, pa);
+    T ta = t0;
+    for (int k = 1; k <= splits; ++k) {
+        T tb = (k == splits) ? t1 : t0 + (t1 - t0) * k / splits;
+        eval(tb, pb);
+        adaptiveSubdivide<T, Dim>(eval, sink, ta, pa, tb, pb, tolerance2, settings.maxDepth);
+        ta = tb;
+        for (int d = 0; d < Dim; ++d) pa[d] = pb[d];
+    }
+}
+
+} // namespace curvecore
+
+#endif // CURVECORE_TESSELLATION_H
@@ -0,0 +1,213 @@
+/**
+ * @file ThreadPool.h
+ * @brief 工作窃取线程池
+ *
+ * 每个工作线程持有一个双端队列：本线程从队尾取任务（LIFO，缓存友好），
+ * 空闲线程从其他队列队首窃取（FIFO，取走较大的剩余工作）。
+ * parallelFor 把区间切成块分发到各队列，调用线程也参与执行，直到全部块完成。
+ * 每块写入互不重叠的输出区间，结果与串行执行一致、与调度顺序无关。
+ */
+#ifndef CURVECORE_THREADPOOL_H
+#define CURVECORE_THREADPOOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace curvecore {
+
+class ThreadPool
+{
+public:
+    /**
+     * @param workers 工作线程数，<0 时取硬件线程数 - 1（调用线程也参与计算）
+     */
+    explicit ThreadPool(int workers = -1)
+    {
+        if (workers < 0) {
+            int hw = static_cast<int>(std::thread::hardware_concurrency());
+            workers = std::max(hw - 1, 0);
+        }
+        for (int i = 0; i < workers; ++i)
+            m_queues.push_back(std::unique_ptr<Queue>(new Queue));
+        for (int i = 0; i < workers; ++i)
+            m_threads.push_back(std::thread(&ThreadPool::workerLoop, this, i));
+    }
+
+    ~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_sleepMutex);
+            m_stop = true;
+        }
+        m_wake.notify_all();
+        for (size_t i = 0; i < m_threads.size(); ++i)
+            m_threads[i].join();
+    }
+
+    /**
+     * @brief 进程内共享的线程池
+     */
+    static ThreadPool &instance()
+    {
+        static ThreadPool pool;
+        return pool;
+    }
+
+    int workerCount() const { return static_cast<int>(m_threads.size()); }
+
+    /**
+     * @brief 对 [begin, end) 按 grain 分块并行执行 body(b, e)
+     *        只有一块或没有工作线程时直接在调用线程执行；body 抛出的第一个异常在此重新抛出
+     */
+    template <typename Body>
+    void parallelFor(size_t begin, size_t end, size_t grain, const Body &body)
+    {
+        if (end <= begin) return;
+        grain = std::max<size_t>(grain, 1);
+        size_t chunks = (end - begin + grain - 1) / grain;
+        if (chunks <= 1 || m_threads.empty()) {
+            body(begin, end);
+            return;
+        }
+
+        Job job;
+        job.body = [&body](size_t b, size_t e) { body(b, e); };
+        job.remaining.store(chunks);
+
+        const size_t queues = m_queues.size();
+        for (size_t k = 0; k < chunks; ++k) {
+            Item item;
+            item.job = &job;
+            item.begin = begin + k * grain;
+            item.end = std::min(item.begin + grain, end);
+            Queue &q = *m_queues[k % queues];
+            std::lock_guard<std::mutex> lock(q.mutex);
+            q.items.push_back(item);
+        }
+        {
+            std::lock_guard<std::mutex> lock(m_sleepMutex);
+            m_pending += chunks;
+        }
+        m_wake.notify_all();
+
+        // 调用线程参与窃取，避免在嵌套 parallelFor 中死锁
+        while (job.remaining.load() > 0) {
+            Item item;
+            if (steal(queues, item)) {
+                run(item);
+            } else {
+                std::unique_lock<std::mutex> lock(job.mutex);
+                job.finished.wait(lock, [&job] { return job.remaining.load() == 0; });
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(job.mutex);
+        if (job.error) std::rethrow_exception(job.error);
+    }
+
+private:
+    struct Job {
+        std::function<void(size_t, size_t)> body;
+        std::atomic<size_t> remaining;
+        std::mutex mutex;
+        std::condition_variable finished;
+        std::exception_ptr error;
+    };
+
+    struct Item {
+        Job *job;
+        size_t begin;
+        size_t end;
+    };
+
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Item> items;
+    };
+
+    ThreadPool(const ThreadPool &);
+    ThreadPool &operator=(const ThreadPool &);
+
+    bool popLocal(size_t self, Item &item)
+    {
+        Queue &q = *m_queues[self];
+        std::lock_guard<std::mutex> lock(q.mutex);
+        if (q.items.empty()) return false;
+        item = q.items.back();
+        q.items.pop_back();
+        return true;
+    }
+
+    /**
+     * @brief 从 self 之后的队列依次窃取（self == 队列数时即调用线程，从 0 开始）
+     */
+    bool steal(size_t self, Item &item)
+    {
+        const size_t queues = m_queues.size();
+        for (size_t k = 1; k <= queues; ++k) {
+            Queue &q = *m_queues[(self + k) % queues];
+            std::lock_guard<std::mutex> lock(q.mutex);
+            if (q.items.empty()) continue;
+            item = q.items.front();
+            q.items.pop_front();
+            return true;
+        }
+        return false;
+    }
+
+    void run(const Item &item)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_sleepMutex);
+            --m_pending;
+        }
+
+        Job &job = *item.job;
+        try {
+            job.body(item.begin, item.end);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(job.mutex);
+            if (!job.error) job.error = std::current_exception();
+        }
+
+        // 计数在锁内递减，调用线程返回前再取一次锁，保证此处不再访问已销毁的 job
+        std::lock_guard<std::mutex> lock(job.mutex);
+        if (job.remaining.fetch_sub(1) == 1)
+            job.finished.notify_all();
+    }
+
+    void workerLoop(size_t self)
+    {
+        for (;;) {
+            Item item;
+            if (popLocal(self, item) || steal(self, item)) {
+                run(item);
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(m_sleepMutex);
+            m_wake.wait(lock, [this] { return m_stop || m_pending > 0; });
+            if (m_stop) return;
+        }
+    }
+
+    std::vector<std::unique_ptr<Queue> > m_queues;
+    std::vector<std::thread> m_threads;
+    std::mutex m_sleepMutex;
+    std::condition_variable m_wake;
+    size_t m_pending = 0;       ///< 已入队但尚未开始执行的块数
+    bool m_stop = false;
+};
+
+} // namespace curvecore
+
+#endif // CURVECORE_THREADPOOL_H
@@ -0,0 +1,25 @@
+# curvecore：不依赖 Qt 的纯头文件曲线库
+INCLUDEPATH += $$PWD/..
+CONFIG += thread   # ThreadPool 使用 std::thread
+
+HEADERS += \
+    $$PWD/ArcLength.h \
+    $$PWD/BackgroundTessellator.h \
+    $$PWD/BasisTable.h \
+    $$PWD/ClosestPoint.h \
+    $$PWD/CurveCore.h \
+    $$PWD/CurveFile.h \
+    $$PWD/CurveTessellation.h \
+    $$PWD/DeltaJournal.h \
+    $$PWD/HermiteKernel.h \
+    $$PWD/HermiteSpline.h \
+    $$PWD/KnotInsertion.h \
+    $$PWD/LevelOfDetail.h \
+    $$PWD/NurbsCurve.h \
+    $$PWD/ParallelSampling.h \
+    $$PWD/Precision.h \
+    $$PWD/PolylineExporter.h \
+    $$PWD/Scene.h \
+    $$PWD/ScratchArena.h \
+    $$PWD/Tessellation.h \
+    $$PWD/ThreadPool.h
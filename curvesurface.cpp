@@ -0,0 +1,155 @@
+/**
+ * @file curvesurface.cpp
+ * @brief SurfaceRenderer 实现：OpenGL 与 QPainter 两种后端
+ */
+#include "CurveSurface.h"
+
+#include <QPainter>
+#include <QRadialGradient>
+
+#ifdef CURVE_OPENGL
+#include "GLCurveRenderer.h"
+
+namespace {
+void toRgba(const QColor &c, float *out)
+{
+    out[0] = static_cast<float>(c.redF());
+    out[1] = static_cast<float>(c.greenF());
+    out[2] = static_cast<float>(c.blueF());
+    out[3] = static_cast<float>(c.alphaF());
+}
+} // namespace
+#endif
+
+SurfaceRenderer::SurfaceRenderer(CurveSurface *surface)
+    : surface(surface)
+{
+}
+
+SurfaceRenderer::~SurfaceRenderer()
+{
+#ifdef CURVE_OPENGL
+    // GL 资源必须在其上下文中释放；此时 QOpenGLWidget 基类尚未析构
+    if (gl) {
+        surface->makeCurrent();
+        gl->release();
+        surface->doneCurrent();
+    }
+#endif
+}
+
+void SurfaceRenderer::begin(QPainter &painter)
+{
+#ifdef CURVE_OPENGL
+    if (!glInitialized) {
+        glInitialized = true;
+        painter.beginNativePainting();
+        gl.reset(new GLCurveRenderer);
+        if (!gl->initialize()) {
+            gl->release();
+            gl.reset();
+        }
+        painter.endNativePainting();
+    }
+    if (gl) gl->setViewport(surface->width(), surface->height(), surface->devicePixelRatioF());
+#else
+    Q_UNUSED(painter);
+#endif
+}
+
+void SurfaceRenderer::end()
+{
+    arena.reset();
+}
+
+bool SurfaceRenderer::acceleratesDiscs() const
+{
+#ifdef CURVE_OPENGL
+    return gl != nullptr;
+#else
+    return false;
+#endif
+}
+
+template <typename T>
+void SurfaceRenderer::strokePolylineImpl(QPainter &painter, const T *xs, const T *ys, int count,
+                                         quint64 revision, const QPen &pen)
+{
+    if (count < 2) return;
+
+#ifdef CURVE_OPENGL
+    if (gl) {
+        float color[4];
+        toRgba(pen.color(), color);
+        painter.beginNativePainting();
+        gl->drawPolyline(xs, ys, count, revision, color, static_cast<float>(pen.widthF()));
+        painter.endNativePainting();
+        return;
+    }
+#else
+    Q_UNUSED(revision);
+#endif
+
+    // 与逐帧构造 QPainterPath 的描边相同，顶点数组取自每帧临时内存
+    QPointF *points = arena.allocate<QPointF>(count);
+    for (int i = 0; i < count; ++i)
+        new (points + i) QPointF(xs[i], ys[i]);
+
+    painter.setPen(pen);
+    painter.setBrush(Qt::NoBrush);
+    painter.drawPolyline(points, count);
+}
+
+void SurfaceRenderer::strokePolyline(QPainter &painter, const double *xs, const double *ys, int count,
+                                     quint64 revision, const QPen &pen)
+{
+    strokePolylineImpl(painter, xs, ys, count, revision, pen);
+}
+
+void SurfaceRenderer::strokePolyline(QPainter &painter, const float *xs, const float *ys, int count,
+                                     quint64 revision, const QPen &pen)
+{
+    strokePolylineImpl(painter, xs, ys, count, revision, pen);
+}
+
+void SurfaceRenderer::drawDiscs(QPainter &painter, const QVector<SurfaceDisc> &discs)
+{
+#ifdef CURVE_OPENGL
+    if (gl) {
+        GLCurveRenderer::Disc *instances = arena.allocate<GLCurveRenderer::Disc>(discs.size());
+        for (int i = 0; i < discs.size(); ++i) {
+            const SurfaceDisc &d = discs[i];
+            GLCurveRenderer::Disc &g = instances[i];
+            g.center[0] = static_cast<float>(d.center.x());
+            g.center[1] = static_cast<float>(d.center.y());
+            g.radius = static_cast<float>(d.radius);
+            g.strokeWidth = static_cast<float>(d.strokeWidth);
+            toRgba(d.inner, g.inner);
+            toRgba(d.outer, g.outer);
+            toRgba(d.stroke, g.stroke);
+        }
+        painter.beginNativePainting();
+        gl->drawDiscs(instances, discs.size());
+        painter.endNativePainting();
+        return;
+    }
+#endif
+    paintDiscs(painter, discs);
+}
+
+void SurfaceRenderer::paintDiscs(QPainter &painter, const QVector<SurfaceDisc> &discs)
+{
+    for (const SurfaceDisc &d : discs) {
+        if (d.inner == d.outer) {
+            painter.setBrush(d.inner);
+        } else {
+            QRadialGradient gradient(d.center, d.radius);
+            gradient.setColorAt(0, d.inner);
+            gradient.setColorAt(1, d.outer);
+            painter.setBrush(gradient);
+        }
+        if (d.strokeWidth > 0.0) painter.setPen(QPen(d.stroke, d.strokeWidth));
+        else painter.setPen(Qt::NoPen);
+        painter.drawEllipse(d.center, d.radius, d.radius);
+    }
+}
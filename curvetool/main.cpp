@@ -0,0 +1,603 @@
+/**
+ * @file main.cpp
+ * @brief curvetool：无界面的曲线文件批处理工具
+ *
+ * 只依赖 QtCore 与 curvecore，用于 CI / 渲染农场等无显示环境：
+ * - info      打印文件信息
+ * - evaluate  在给定参数处求值
+ * - uniform   均匀采样并流式导出折线（可选 Douglas–Peucker 简化，--spacing arc 为等弧长）
+ * - adaptive  按弦偏差自适应细分后导出
+ * - project   把测量点（--points）投影到每条曲线上，输出参数、最近点与距离
+ * - scene     把所有文件载入同一个场景，并行细分后报告包围盒，可按矩形剔除与按点拾取
+ *
+ * 曲线文件通过 QFile::map 映射，每列为单个块时直接在映射内存上求值。
+ * 多个文件可用 --jobs 并行处理，每个文件的输出互相独立。
+ */
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QPointF>
+#include <QRectF>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+#include "curvecore/CurveCore.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace {
+
+enum Mode {
+    MODE_INFO,
+    MODE_EVALUATE,
+    MODE_UNIFORM,
+    MODE_ADAPTIVE,
+    MODE_PROJECT,
+    MODE_SCENE
+};
+
+struct Options {
+    Mode mode = MODE_UNIFORM;
+    qint64 samples = 1000;
+    double tolerance = 0.0;                         ///< uniform：简化容差；adaptive：弦偏差容差
+    curvecore::ExportFormat format = curvecore::EXPORT_TEXT;
+    curvecore::ExportSpacing spacing = curvecore::EXPORT_UNIFORM_PARAMETER;   ///< uniform 模式的样本分布
+    QString outputDir;                              ///< 为空时输出到输入文件旁；"-" 为标准输出
+    QVector<double> params;                         ///< evaluate 模式的参数
+    bool parallelEval = true;                       ///< 单文件时在线程池上并行求值
+    QVector<QPointF> picks;                         ///< scene 模式的拾取点
+    QVector<QRectF> views;                          ///< scene 模式的剔除矩形
+    double pickRadius = 10.0;
+    QVector<double> projectX;                       ///< project 模式的测量点
+    QVector<double> projectY;
+    double projectRadius = std::numeric_limits<double>::infinity();   ///< project 模式的最大投影距离
+};
+
+std::mutex logMutex;
+
+void logLine(const std::string &line)
+{
+    std::lock_guard<std::mutex> lock(logMutex);
+    std::fprintf(stderr, "%s\n", line.c_str());
+}
+
+/**
+ * @brief 曲线文件的两种来源：映射内存上的零拷贝视图，或拷贝出的曲线
+ */
+struct LoadedCurve {
+    curvecore::CurveFileView file;
+    curvecore::NurbsView<double, 2> nurbsView;
+    curvecore::HermiteView<double, 2> hermiteView;
+    curvecore::NurbsCurve<double, 2> nurbs;
+    curvecore::HermiteSpline<double, 2> hermite;
+    bool mapped = false;
+
+    bool isNurbs() const { return file.kind() == curvecore::CURVE_NURBS; }
+};
+
+bool loadCurveFile(const uchar *data, qint64 size, LoadedCurve &curve, std::string &error)
+{
+    if (!curve.file.open(data, static_cast<size_t>(size), &error)) return false;
+
+    if (curve.isNurbs()) {
+        curve.mapped = curve.file.nurbsView(curve.nurbsView);
+        if (!curve.mapped) {
+            if (!curvecore::loadCurve(curve.file, curve.nurbs, &error)) return false;
+            curve.nurbsView = curve.nurbs.view();
+        }
+        if (!curve.nurbsView.isValid()) {
+            error = "curve needs at least two control points";
+            return false;
+        }
+    } else {
+        curve.mapped = curve.file.hermiteView(curve.hermiteView);
+        if (!curve.mapped) {
+            if (!curvecore::loadCurve(curve.file, curve.hermite, &error)) return false;
+            curve.hermiteView = curve.hermite.view();
+        }
+        if (!curve.hermiteView.isValid()) {
+            error = "curve needs at least two points";
+            return false;
+        }
+    }
+    return true;
+}
+
+QString outputPath(const Options &options, const QString &input)
+{
+    if (options.outputDir == "-") return options.outputDir;
+
+    QFileInfo info(input);
+    QString suffix = options.format == curvecore::EXPORT_BINARY ? ".bin" : ".txt";
+    QString dir = options.outputDir.isEmpty() ? info.absolutePath() : options.outputDir;
+    return dir + "/" + info.completeBaseName() + suffix;
+}
+
+/**
+ * @brief 写出自适应细分结果
+ */
+bool writePolyline(const curvecore::Polyline<double, 2> &line, curvecore::ExportFormat format,
+                   std::FILE *out, qint64 &bytes)
+{
+    curvecore::FileSink sink = { out };
+    bytes = 0;
+    char text[64];
+    for (size_t i = 0; i < line.size(); ++i) {
+        double p[2] = { line.coords[0][i], line.coords[1][i] };
+        size_t n;
+        bool ok;
+        if (format == curvecore::EXPORT_BINARY) {
+            n = sizeof(p);
+            ok = sink(p, n);
+        } else {
+            n = static_cast<size_t>(std::snprintf(text, sizeof(text), "%.6f %.6f\n", p[0], p[1]));
+            ok = sink(text, n);
+        }
+        if (!ok) return false;
+        bytes += n;
+    }
+    return true;
+}
+
+/**
+ * @brief 读取测量点：.bin 为交错存放的 double (x, y)，其余按文本每行 "x y"
+ */
+bool loadPoints(const QString &fileName, QVector<double> &x, QVector<double> &y, std::string &error)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        error = file.errorString().toStdString();
+        return false;
+    }
+    const QByteArray data = file.readAll();
+    x.clear();
+    y.clear();
+
+    if (QFileInfo(fileName).suffix().toLower() == "bin") {
+        const size_t count = static_cast<size_t>(data.size()) / (2 * sizeof(double));
+        const double *p = reinterpret_cast<const double *>(data.constData());
+        x.resize(static_cast<int>(count));
+        y.resize(static_cast<int>(count));
+        for (size_t i = 0; i < count; ++i) {
+            x[static_cast<int>(i)] = p[2 * i];
+            y[static_cast<int>(i)] = p[2 * i + 1];
+        }
+        return true;
+    }
+
+    // QByteArray 以 '\0' 结尾，strtod 可直接在整块文本上推进
+    const char *cursor = data.constData();
+    for (;;) {
+        char *end;
+        double px = std::strtod(cursor, &end);
+        if (end == cursor) break;
+        cursor = end;
+        double py = std::strtod(cursor, &end);
+        if (end == cursor) {
+            error = "odd number of coordinates";
+            return false;
+        }
+        cursor = end;
+        x.append(px);
+        y.append(py);
+    }
+    return true;
+}
+
+/**
+ * @brief 写出投影结果：每点为参数、最近点与距离，未找到时距离为无穷大
+ */
+bool writeProjection(const double *t, const double *x, const double *y, const double *distance, size_t n,
+                     curvecore::ExportFormat format, std::FILE *out, qint64 &bytes)
+{
+    curvecore::FileSink sink = { out };
+    bytes = 0;
+    char text[128];
+    for (size_t i = 0; i < n; ++i) {
+        double record[4] = { t[i], x[i], y[i], distance[i] };
+        size_t size;
+        bool ok;
+        if (format == curvecore::EXPORT_BINARY) {
+            size = sizeof(record);
+            ok = sink(record, size);
+        } else {
+            size = static_cast<size_t>(std::snprintf(text, sizeof(text), "%.9g %.6f %.6f %.6f\n",
+                                                     record[0], record[1], record[2], record[3]));
+            ok = sink(text, size);
+        }
+        if (!ok) return false;
+        bytes += size;
+    }
+    return true;
+}
+
+/**
+ * @brief 处理单个文件，成功返回 true；日志写到标准错误
+ */
+bool processFile(const QString &input, const Options &options)
+{
+    const std::string name = input.toStdString();
+    QElapsedTimer timer;
+    timer.start();
+
+    QFile file(input);
+    if (!file.open(QIODevice::ReadOnly)) {
+        logLine(name + ": " + file.errorString().toStdString());
+        return false;
+    }
+    uchar *data = file.map(0, file.size());
+    if (!data) {
+        logLine(name + ": " + file.errorString().toStdString());
+        return false;
+    }
+
+    LoadedCurve curve;
+    std::string error;
+    if (!loadCurveFile(data, file.size(), curve, error)) {
+        logLine(name + ": " + error);
+        return false;
+    }
+
+    char summary[256];
+    const curvecore::FileHeader &h = curve.file.header();
+    if (options.mode == MODE_INFO) {
+        std::snprintf(summary, sizeof(summary), "%s: %s, %llu points, degree %d, %zu chunks, %s",
+                      name.c_str(), curve.isNurbs() ? "NURBS" : "Hermite",
+                      static_cast<unsigned long long>(h.count), h.degree, curve.file.chunks().size(),
+                      curve.mapped ? "zero-copy" : "copied");
+        logLine(summary);
+        return true;
+    }
+
+    QString outName = outputPath(options, input);
+    std::FILE *out = outName == "-" ? stdout
+                   : std::fopen(outName.toLocal8Bit().constData(), options.format == curvecore::EXPORT_BINARY ? "wb" : "w");
+    if (!out) {
+        logLine(name + ": cannot open " + outName.toStdString());
+        return false;
+    }
+
+    bool ok = true;
+    qint64 points = 0, bytes = 0;
+    if (options.mode == MODE_EVALUATE) {
+        const int n = options.params.size();
+        QVector<double> x(n), y(n);
+        double *dst[2] = { x.data(), y.data() };
+        if (curve.isNurbs()) curvecore::evaluateMany(curve.nurbsView, options.params.constData(), n, dst);
+        else curvecore::evaluateMany(curve.hermiteView, options.params.constData(), n, dst);
+        for (int i = 0; i < n && ok; ++i)
+            ok = std::fprintf(out, "%.9g %.9f %.9f\n", options.params[i], x[i], y[i]) > 0;
+        points = n;
+    } else if (options.mode == MODE_UNIFORM) {
+        curvecore::ExportSettings settings;
+        settings.samples = static_cast<std::uint64_t>(options.samples);
+        settings.tolerance = options.tolerance;
+        settings.format = options.format;
+        settings.spacing = options.spacing;
+        settings.pool = options.parallelEval ? &curvecore::ThreadPool::instance() : nullptr;
+
+        curvecore::FileSink sink = { out };
+        curvecore::ExportStats stats = curve.isNurbs()
+            ? curvecore::exportPolyline(curve.nurbsView, sink, settings)
+            : curvecore::exportPolyline(curve.hermiteView, sink, settings);
+        ok = stats.ok;
+        points = static_cast<qint64>(stats.written);
+        bytes = static_cast<qint64>(stats.bytes);
+    } else if (options.mode == MODE_PROJECT) {
+        // 按曲线建一次投影索引，测量点在线程池上并行投影
+        const size_t n = static_cast<size_t>(options.projectX.size());
+        std::vector<double> t(n), distance(n), x(n), y(n);
+        const double *queries[2] = { options.projectX.constData(), options.projectY.constData() };
+        double *dst[2] = { x.data(), y.data() };
+        curvecore::ThreadPool *pool = options.parallelEval ? &curvecore::ThreadPool::instance() : nullptr;
+        curvecore::ClosestPointIndex<double, 2> index;
+        if (curve.isNurbs()) {
+            index.build(curve.nurbsView);
+            index.closestMany(curve.nurbsView, queries, n, options.projectRadius, t.data(), distance.data(), pool);
+            curvecore::evaluateMany(curve.nurbsView, t.data(), n, dst);
+        } else {
+            index.build(curve.hermiteView);
+            index.closestMany(curve.hermiteView, queries, n, options.projectRadius, t.data(), distance.data(), pool);
+            curvecore::evaluateMany(curve.hermiteView, t.data(), n, dst);
+        }
+        ok = writeProjection(t.data(), x.data(), y.data(), distance.data(), n, options.format, out, bytes);
+        points = static_cast<qint64>(n);
+    } else {
+        curvecore::TessellationSettings settings;
+        if (options.tolerance > 0.0) settings.tolerance = options.tolerance;
+        curvecore::Polyline<double, 2> line;
+        if (curve.isNurbs()) curvecore::tessellateAdaptive(curve.nurbsView, settings, line);
+        else curvecore::tessellateAdaptive(curve.hermiteView, settings, line);
+        ok = writePolyline(line, options.format, out, bytes);
+        points = static_cast<qint64>(line.size());
+    }
+
+    if (out == stdout) ok = std::fflush(out) == 0 && ok;
+    else ok = std::fclose(out) == 0 && ok;
+    file.unmap(data);
+
+    std::snprintf(summary, sizeof(summary), "%s: %s%lld points, %lld bytes -> %s (%lld ms)",
+                  name.c_str(), ok ? "" : "FAILED after ", static_cast<long long>(points),
+                  static_cast<long long>(bytes), outName.toStdString().c_str(),
+                  static_cast<long long>(timer.elapsed()));
+    logLine(summary);
+    return ok;
+}
+
+/**
+ * @brief 把文件载入场景；映射内存只在载入期间使用，曲线拷贝进场景
+ */
+bool loadIntoScene(const QString &input, curvecore::Scene<double> &scene, std::string &error)
+{
+    QFile file(input);
+    if (!file.open(QIODevice::ReadOnly)) {
+        error = file.errorString().toStdString();
+        return false;
+    }
+    uchar *data = file.map(0, file.size());
+    if (!data) {
+        error = file.errorString().toStdString();
+        return false;
+    }
+
+    curvecore::CurveFileView view;
+    bool ok = view.open(data, static_cast<size_t>(file.size()), &error);
+    if (ok && view.kind() == curvecore::CURVE_NURBS) {
+        curvecore::NurbsCurve<double, 2> nurbs;
+        ok = curvecore::loadCurve(view, nurbs, &error);
+        if (ok) scene.addNurbs(nurbs);
+    } else if (ok) {
+        curvecore::HermiteSpline<double, 2> hermite;
+        ok = curvecore::loadCurve(view, hermite, &error);
+        if (ok) scene.addHermite(hermite);
+    }
+    file.unmap(data);
+    return ok;
+}
+
+/**
+ * @brief scene 模式：所有文件进同一场景，在线程池上按曲线并行细分，再用层次包围盒剔除与拾取
+ *        剔除与拾取结果写到标准输出，每行一条
+ */
+bool processScene(const QStringList &files, const Options &options, curvecore::ThreadPool &pool)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    curvecore::Scene<double> scene;
+    QStringList names;                      // 场景下标 -> 文件名
+    bool ok = true;
+    for (const QString &input : files) {
+        std::string error;
+        if (loadIntoScene(input, scene, error)) {
+            names.append(input);
+        } else {
+            logLine(input.toStdString() + ": " + error);
+            ok = false;
+        }
+    }
+    qint64 loadMs = timer.restart();
+
+    curvecore::SceneSettings settings;
+    if (options.tolerance > 0.0) settings.adaptive.tolerance = options.tolerance;
+    scene.setSettings(settings);
+    scene.update(pool);
+    qint64 tessellateMs = timer.elapsed();
+
+    qint64 vertices = 0;
+    int nurbs = 0;
+    for (int i = 0; i < scene.size(); ++i) {
+        vertices += static_cast<qint64>(scene.curve(i).line.size());
+        nurbs += scene.curve(i).kind == curvecore::CURVE_NURBS ? 1 : 0;
+    }
+
+    char summary[256];
+    double lo[2] = { 0.0, 0.0 }, hi[2] = { 0.0, 0.0 };
+    scene.bounds(lo, hi);
+    std::snprintf(summary, sizeof(summary),
+                  "scene: %d curves (%d NURBS, %d Hermite), %lld vertices, bounds [%.3f, %.3f] - [%.3f, %.3f], "
+                  "load %lld ms, tessellate %lld ms on %d threads",
+                  scene.size(), nurbs, scene.size() - nurbs, static_cast<long long>(vertices),
+                  lo[0], lo[1], hi[0], hi[1], static_cast<long long>(loadMs),
+                  static_cast<long long>(tessellateMs), pool.workerCount() + 1);
+    logLine(summary);
+
+    std::vector<int> hits;
+    for (const QRectF &view : options.views) {
+        const double qlo[2] = { view.left(), view.top() }, qhi[2] = { view.right(), view.bottom() };
+        scene.query(qlo, qhi, hits);
+        std::printf("view %g,%g,%g,%g: %zu curves\n", qlo[0], qlo[1], qhi[0], qhi[1], hits.size());
+        for (int i : hits) std::printf("  %s\n", names[i].toStdString().c_str());
+    }
+    for (const QPointF &p : options.picks) {
+        double distance = 0.0;
+        int hit = scene.pick(p.x(), p.y(), options.pickRadius, &distance);
+        if (hit >= 0) std::printf("pick %g,%g: %s (distance %.6f)\n", p.x(), p.y(),
+                                  names[hit].toStdString().c_str(), distance);
+        else std::printf("pick %g,%g: none within %g\n", p.x(), p.y(), options.pickRadius);
+    }
+    return ok && std::fflush(stdout) == 0;
+}
+
+/**
+ * @brief 解析逗号分隔的 count 个数
+ */
+bool parseNumbers(const QString &value, int count, double *out)
+{
+    const QStringList parts = value.split(',');
+    if (parts.size() != count) return false;
+    bool ok = true;
+    for (int k = 0; k < count && ok; ++k) out[k] = parts[k].trimmed().toDouble(&ok);
+    return ok;
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("curvetool");
+    QCoreApplication::setApplicationVersion("1.0");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Evaluate and tessellate .crv curve files without a display.");
+    parser.addHelpOption();
+    parser.addVersionOption();
+    parser.addPositionalArgument("files", "Curve files (.crv) to process.", "files...");
+
+    QCommandLineOption modeOption({"m", "mode"},
+        "info | evaluate | uniform | adaptive | project | scene (default: uniform).", "mode", "uniform");
+    QCommandLineOption samplesOption({"n", "samples"},
+        "Uniform sample count per curve (default: 1000).", "count", "1000");
+    QCommandLineOption toleranceOption({"t", "tolerance"},
+        "Chord tolerance; simplification for uniform, subdivision for adaptive.", "value", "0");
+    QCommandLineOption paramOption({"p", "param"},
+        "Parameter to evaluate (repeatable, evaluate mode).", "t");
+    QCommandLineOption formatOption({"f", "format"},
+        "text | binary (default: text).", "format", "text");
+    QCommandLineOption spacingOption("spacing",
+        "param | arc: equal parameter or equal arc-length steps (uniform mode, default: param).",
+        "spacing", "param");
+    QCommandLineOption outputOption({"o", "output"},
+        "Output directory, or - for stdout (default: next to each input).", "dir");
+    QCommandLineOption jobsOption({"j", "jobs"},
+        "Files processed in parallel, or scene tessellation threads (default: 1, 0 = all cores).", "n", "1");
+    parser.addOption(modeOption);
+    parser.addOption(samplesOption);
+    parser.addOption(toleranceOption);
+    parser.addOption(paramOption);
+    parser.addOption(formatOption);
+    parser.addOption(spacingOption);
+    parser.addOption(outputOption);
+    QCommandLineOption pickOption("pick",
+        "Report the curve nearest to x,y (repeatable, scene mode).", "x,y");
+    QCommandLineOption radiusOption("radius",
+        "Pick radius (default: 10); maximum projection distance (project mode, default: none).", "value", "10");
+    QCommandLineOption pointsOption("points",
+        "Points to project: text x y per line, or .bin interleaved doubles (project mode).", "file");
+    QCommandLineOption viewOption("view",
+        "List curves whose bounds meet the rectangle x0,y0,x1,y1 (repeatable, scene mode).", "rect");
+    parser.addOption(jobsOption);
+    parser.addOption(pickOption);
+    parser.addOption(radiusOption);
+    parser.addOption(viewOption);
+    parser.addOption(pointsOption);
+    parser.process(app);
+
+    Options options;
+    const QString mode = parser.value(modeOption);
+    if (mode == "info") options.mode = MODE_INFO;
+    else if (mode == "evaluate") options.mode = MODE_EVALUATE;
+    else if (mode == "uniform") options.mode = MODE_UNIFORM;
+    else if (mode == "adaptive") options.mode = MODE_ADAPTIVE;
+    else if (mode == "project") options.mode = MODE_PROJECT;
+    else if (mode == "scene") options.mode = MODE_SCENE;
+    else {
+        std::fprintf(stderr, "unknown mode: %s\n", mode.toStdString().c_str());
+        return 2;
+    }
+
+    bool ok = true;
+    options.samples = parser.value(samplesOption).toLongLong(&ok);
+    if (!ok || options.samples < 2) {
+        std::fprintf(stderr, "invalid sample count\n");
+        return 2;
+    }
+    options.tolerance = parser.value(toleranceOption).toDouble(&ok);
+    if (!ok || options.tolerance < 0.0) {
+        std::fprintf(stderr, "invalid tolerance\n");
+        return 2;
+    }
+    for (const QString &value : parser.values(paramOption)) {
+        options.params.append(value.toDouble(&ok));
+        if (!ok) {
+            std::fprintf(stderr, "invalid parameter: %s\n", value.toStdString().c_str());
+            return 2;
+        }
+    }
+    if (options.mode == MODE_EVALUATE && options.params.isEmpty()) {
+        std::fprintf(stderr, "evaluate mode needs at least one --param\n");
+        return 2;
+    }
+    for (const QString &value : parser.values(pickOption)) {
+        double p[2];
+        if (!parseNumbers(value, 2, p)) {
+            std::fprintf(stderr, "invalid pick point: %s\n", value.toStdString().c_str());
+            return 2;
+        }
+        options.picks.append(QPointF(p[0], p[1]));
+    }
+    for (const QString &value : parser.values(viewOption)) {
+        double r[4];
+        if (!parseNumbers(value, 4, r)) {
+            std::fprintf(stderr, "invalid view rectangle: %s\n", value.toStdString().c_str());
+            return 2;
+        }
+        options.views.append(QRectF(QPointF(std::min(r[0], r[2]), std::min(r[1], r[3])),
+                                    QPointF(std::max(r[0], r[2]), std::max(r[1], r[3]))));
+    }
+    options.pickRadius = parser.value(radiusOption).toDouble(&ok);
+    if (!ok || options.pickRadius < 0.0) {
+        std::fprintf(stderr, "invalid pick radius\n");
+        return 2;
+    }
+    if (parser.isSet(radiusOption)) options.projectRadius = options.pickRadius;
+    if (options.mode == MODE_PROJECT) {
+        std::string error;
+        if (!parser.isSet(pointsOption)) {
+            std::fprintf(stderr, "project mode needs --points\n");
+            return 2;
+        }
+        if (!loadPoints(parser.value(pointsOption), options.projectX, options.projectY, error)) {
+            std::fprintf(stderr, "cannot read points: %s\n", error.c_str());
+            return 2;
+        }
+    }
+    options.format = parser.value(formatOption) == "binary" ? curvecore::EXPORT_BINARY
+                                                            : curvecore::EXPORT_TEXT;
+    const QString spacing = parser.value(spacingOption);
+    if (spacing == "arc") options.spacing = curvecore::EXPORT_UNIFORM_ARC_LENGTH;
+    else if (spacing != "param") {
+        std::fprintf(stderr, "unknown spacing: %s\n", spacing.toStdString().c_str());
+        return 2;
+    }
+    options.outputDir = parser.value(outputOption);
+
+    const QStringList files = parser.positionalArguments();
+    if (files.isEmpty()) parser.showHelp(2);
+
+    int jobs = parser.value(jobsOption).toInt(&ok);
+    if (!ok || jobs < 0) {
+        std::fprintf(stderr, "invalid job count\n");
+        return 2;
+    }
+    if (options.mode == MODE_SCENE) {
+        // 场景按曲线并行细分，jobs 即参与细分的线程数
+        curvecore::ThreadPool pool(jobs == 0 ? -1 : jobs - 1);
+        return processScene(files, options, pool) ? 0 : 1;
+    }
+    if (options.outputDir == "-") jobs = 1;          // 标准输出不能交错写入
+
+    // 多文件并行时每个文件内部串行求值，避免两层并行争抢核心
+    options.parallelEval = jobs == 1 || files.size() == 1;
+
+    // 按文件并行：调用线程加 jobs-1 个工作线程，0 表示使用全部硬件线程
+    curvecore::ThreadPool filePool(jobs == 0 ? -1 : jobs - 1);
+    std::atomic<int> failures(0);
+    filePool.parallelFor(0, files.size(), 1, [&](size_t b, size_t e) {
+        for (size_t i = b; i < e; ++i)
+            if (!processFile(files[static_cast<int>(i)], options)) ++failures;
+    });
+
+    return failures.load() == 0 ? 0 : 1;
+}
@@ -0,0 +1,309 @@
+/**
+ * @file glcurverenderer.cpp
+ * @brief GLCurveRenderer 实现：着色器、实例化线段与圆点
+ */
+#include "GLCurveRenderer.h"
+
+#include <QOpenGLContext>
+
+#include <cstddef>
+
+namespace {
+
+// 顶点属性位置
+enum {
+    ATTR_CORNER = 0,
+    ATTR_P0 = 1,
+    ATTR_P1 = 2,
+    ATTR_GEOMETRY = 1,
+    ATTR_INNER = 2,
+    ATTR_OUTER = 3,
+    ATTR_STROKE = 4
+};
+
+const char *POLYLINE_VERTEX = R"(
+in vec2 corner;
+in vec2 p0;
+in vec2 p1;
+uniform vec2 viewport;
+uniform float scale;
+uniform float halfWidth;
+out vec2 local;
+out float segmentLength;
+
+void main()
+{
+    // 四边形覆盖线段两侧及两端各 halfWidth + 1 像素，片元按到线段的距离裁出圆头
+    vec2 a = p0 * scale;
+    vec2 b = p1 * scale;
+    vec2 d = b - a;
+    float len = length(d);
+    vec2 dir = len > 0.0 ? d / len : vec2(1.0, 0.0);
+    vec2 normal = vec2(-dir.y, dir.x);
+    float r = halfWidth + 1.0;
+    float along = corner.x < 0.0 ? -r : len + r;
+    float across = corner.y * r;
+    vec2 pos = a + dir * along + normal * across;
+
+    local = vec2(along, across);
+    segmentLength = len;
+    gl_Position = vec4(pos.x / viewport.x * 2.0 - 1.0, 1.0 - pos.y / viewport.y * 2.0, 0.0, 1.0);
+}
+)";
+
+const char *POLYLINE_FRAGMENT = R"(
+in vec2 local;
+in float segmentLength;
+uniform vec4 color;
+uniform float halfWidth;
+out vec4 fragColor;
+
+void main()
+{
+    float x = clamp(local.x, 0.0, segmentLength);
+    float dist = length(vec2(local.x - x, local.y));
+    float coverage = clamp(halfWidth + 0.5 - dist, 0.0, 1.0);
+    if (coverage <= 0.0) discard;
+    fragColor = vec4(color.rgb, color.a * coverage);
+}
+)";
+
+const char *DISC_VERTEX = R"(
+in vec2 corner;
+in vec4 geometry;
+in vec4 inner;
+in vec4 outer;
+in vec4 stroke;
+uniform vec2 viewport;
+uniform float scale;
+out vec2 local;
+out vec2 shape;
+out vec4 innerColor;
+out vec4 outerColor;
+out vec4 strokeColor;
+
+void main()
+{
+    float radius = geometry.z * scale;
+    float strokeWidth = geometry.w * scale;
+    float extent = radius + 0.5 * strokeWidth + 1.0;
+    vec2 pos = geometry.xy * scale + corner * extent;
+
+    local = corner * extent;
+    shape = vec2(radius, strokeWidth);
+    innerColor = inner;
+    outerColor = outer;
+    strokeColor = stroke;
+    gl_Position = vec4(pos.x / viewport.x * 2.0 - 1.0, 1.0 - pos.y / viewport.y * 2.0, 0.0, 1.0);
+}
+)";
+
+const char *DISC_FRAGMENT = R"(
+in vec2 local;
+in vec2 shape;
+in vec4 innerColor;
+in vec4 outerColor;
+in vec4 strokeColor;
+out vec4 fragColor;
+
+void main()
+{
+    float d = length(local);
+    float radius = shape.x;
+    float strokeWidth = shape.y;
+
+    // 与 QPainter 一致：填充到半径处，描边以半径为中线
+    vec4 fill = mix(innerColor, outerColor, clamp(d / radius, 0.0, 1.0));
+    fill.a *= clamp(radius + 0.5 - d, 0.0, 1.0);
+    float strokeAlpha = strokeWidth > 0.0
+        ? strokeColor.a * clamp(0.5 * strokeWidth + 0.5 - abs(d - radius), 0.0, 1.0) : 0.0;
+
+    float alpha = strokeAlpha + fill.a * (1.0 - strokeAlpha);
+    if (alpha <= 0.0) discard;
+    fragColor = vec4((strokeColor.rgb * strokeAlpha + fill.rgb * fill.a * (1.0 - strokeAlpha)) / alpha, alpha);
+}
+)";
+
+// 三角形带顺序的单位四边形
+const float QUAD_CORNERS[8] = { -1.0f, -1.0f, 1.0f, -1.0f, -1.0f, 1.0f, 1.0f, 1.0f };
+
+} // namespace
+
+GLCurveRenderer::GLCurveRenderer()
+    : cornerBuffer(QOpenGLBuffer::VertexBuffer),
+      polylineBuffer(QOpenGLBuffer::VertexBuffer),
+      discBuffer(QOpenGLBuffer::VertexBuffer)
+{
+}
+
+/**
+ * @brief 按上下文类型补上 GLSL 版本头后编译链接
+ */
+bool GLCurveRenderer::buildProgram(QOpenGLShaderProgram &program, const char *vertex, const char *fragment,
+                                   const char *const *attributes, int attributeCount)
+{
+    const QByteArray header = QOpenGLContext::currentContext()->isOpenGLES()
+        ? QByteArray("#version 300 es\nprecision highp float;\n")
+        : QByteArray("#version 330 core\n");
+
+    if (!program.addShaderFromSourceCode(QOpenGLShader::Vertex, header + vertex)) return false;
+    if (!program.addShaderFromSourceCode(QOpenGLShader::Fragment, header + fragment)) return false;
+    for (int i = 0; i < attributeCount; ++i)
+        program.bindAttributeLocation(attributes[i], i);
+    return program.link();
+}
+
+bool GLCurveRenderer::initialize()
+{
+    QOpenGLContext *context = QOpenGLContext::currentContext();
+    if (!context) return false;
+    // 实例化绘制与 GLSL 330 / 300 es 需要 OpenGL 3.3 或 OpenGL ES 3.0
+    const QPair<int, int> required = context->isOpenGLES() ? qMakePair(3, 0) : qMakePair(3, 3);
+    if (context->format().version() < required)
+        return false;
+
+    initializeOpenGLFunctions();
+
+    const char *polylineAttributes[] = { "corner", "p0", "p1" };
+    const char *discAttributes[] = { "corner", "geometry", "inner", "outer", "stroke" };
+    if (!buildProgram(polylineProgram, POLYLINE_VERTEX, POLYLINE_FRAGMENT, polylineAttributes, 3)
+            || !buildProgram(discProgram, DISC_VERTEX, DISC_FRAGMENT, discAttributes, 5))
+        return false;
+
+    cornerBuffer.create();
+    cornerBuffer.bind();
+    cornerBuffer.allocate(QUAD_CORNERS, sizeof(QUAD_CORNERS));
+    cornerBuffer.release();
+
+    polylineBuffer.create();
+    polylineBuffer.setUsagePattern(QOpenGLBuffer::DynamicDraw);
+    discBuffer.create();
+    discBuffer.setUsagePattern(QOpenGLBuffer::StreamDraw);
+
+    // 线段实例：p0 与 p1 读取同一缓冲，p1 错开一个顶点
+    polylineVao.create();
+    polylineVao.bind();
+    cornerBuffer.bind();
+    glEnableVertexAttribArray(ATTR_CORNER);
+    glVertexAttribPointer(ATTR_CORNER, 2, GL_FLOAT, GL_FALSE, 0, nullptr);
+    polylineBuffer.bind();
+    glEnableVertexAttribArray(ATTR_P0);
+    glVertexAttribPointer(ATTR_P0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), nullptr);
+    glVertexAttribDivisor(ATTR_P0, 1);
+    glEnableVertexAttribArray(ATTR_P1);
+    glVertexAttribPointer(ATTR_P1, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float),
+                          reinterpret_cast<const void *>(2 * sizeof(float)));
+    glVertexAttribDivisor(ATTR_P1, 1);
+    polylineVao.release();
+
+    discVao.create();
+    discVao.bind();
+    cornerBuffer.bind();
+    glEnableVertexAttribArray(ATTR_CORNER);
+    glVertexAttribPointer(ATTR_CORNER, 2, GL_FLOAT, GL_FALSE, 0, nullptr);
+    discBuffer.bind();
+    const struct { int location; size_t offset; } fields[] = {
+        { ATTR_GEOMETRY, offsetof(Disc, center) },
+        { ATTR_INNER, offsetof(Disc, inner) },
+        { ATTR_OUTER, offsetof(Disc, outer) },
+        { ATTR_STROKE, offsetof(Disc, stroke) }
+    };
+    for (const auto &field : fields) {
+        glEnableVertexAttribArray(field.location);
+        glVertexAttribPointer(field.location, 4, GL_FLOAT, GL_FALSE, sizeof(Disc),
+                              reinterpret_cast<const void *>(field.offset));
+        glVertexAttribDivisor(field.location, 1);
+    }
+    discVao.release();
+    discBuffer.release();
+
+    valid = true;
+    return true;
+}
+
+void GLCurveRenderer::release()
+{
+    polylineVao.destroy();
+    discVao.destroy();
+    cornerBuffer.destroy();
+    polylineBuffer.destroy();
+    discBuffer.destroy();
+    polylineProgram.removeAllShaders();
+    discProgram.removeAllShaders();
+    uploadedData = nullptr;
+    valid = false;
+}
+
+void GLCurveRenderer::setViewport(int width, int height, float devicePixelRatio)
+{
+    scale = devicePixelRatio;
+    viewport[0] = width * devicePixelRatio;
+    viewport[1] = height * devicePixelRatio;
+}
+
+template <typename T>
+void GLCurveRenderer::drawPolylineImpl(const T *xs, const T *ys, int count, quint64 revision,
+                                       const float *color, float width)
+{
+    if (!valid || count < 2) return;
+
+    if (xs != uploadedData || count != uploadedCount || revision != uploadedRevision) {
+        uploadScratch.resize(2 * count);
+        float *dst = uploadScratch.data();
+        for (int i = 0; i < count; ++i) {
+            dst[2 * i] = static_cast<float>(xs[i]);
+            dst[2 * i + 1] = static_cast<float>(ys[i]);
+        }
+        polylineBuffer.bind();
+        polylineBuffer.allocate(dst, 2 * count * static_cast<int>(sizeof(float)));
+        polylineBuffer.release();
+        uploadedData = xs;
+        uploadedCount = count;
+        uploadedRevision = revision;
+    }
+
+    glEnable(GL_BLEND);
+    glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+
+    polylineProgram.bind();
+    polylineProgram.setUniformValue("viewport", viewport[0], viewport[1]);
+    polylineProgram.setUniformValue("scale", scale);
+    polylineProgram.setUniformValue("halfWidth", 0.5f * width * scale);
+    polylineProgram.setUniformValue("color", color[0], color[1], color[2], color[3]);
+    polylineVao.bind();
+    glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, count - 1);
+    polylineVao.release();
+    polylineProgram.release();
+}
+
+void GLCurveRenderer::drawPolyline(const double *xs, const double *ys, int count, quint64 revision,
+                                   const float *color, float width)
+{
+    drawPolylineImpl(xs, ys, count, revision, color, width);
+}
+
+void GLCurveRenderer::drawPolyline(const float *xs, const float *ys, int count, quint64 revision,
+                                   const float *color, float width)
+{
+    drawPolylineImpl(xs, ys, count, revision, color, width);
+}
+
+void GLCurveRenderer::drawDiscs(const Disc *discs, int count)
+{
+    if (!valid || count <= 0) return;
+
+    discBuffer.bind();
+    discBuffer.allocate(discs, count * static_cast<int>(sizeof(Disc)));
+    discBuffer.release();
+
+    glEnable(GL_BLEND);
+    glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+
+    discProgram.bind();
+    discProgram.setUniformValue("viewport", viewport[0], viewport[1]);
+    discProgram.setUniformValue("scale", scale);
+    discVao.bind();
+    glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, count);
+    discVao.release();
+    discProgram.release();
+}
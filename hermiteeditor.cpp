@@ -13,20 +13,30 @@
 #include <QPainter>
 #include <QMouseEvent>
 #include <QKeyEvent>
+#include <QRegion>
 #include <QtMath>
 #include <QString>
+#include <QFile>
+#include <QFileDialog>
+#include <QMessageBox>
+#include <QInputDialog>
+#include <QFileInfo>
+#include <algorithm>
 
 HermiteEditor::HermiteEditor(QWidget *parent)
-    : QWidget(parent)
+    : CurveSurface(parent), pointIndex(SNAP_DISTANCE),
+      backgroundTessellator(&HermiteEditor::buildTessellation,
+                            [this] { QMetaObject::invokeMethod(this, "update", Qt::QueuedConnection); }),
+      surfaceRenderer(this)
 {
+    handleIndex[0] = PointGrid(SNAP_DISTANCE);
+    handleIndex[1] = PointGrid(SNAP_DISTANCE);
     setMouseTracking(true);
     setFocusPolicy(Qt::StrongFocus);
 }
 
 HermiteEditor::~HermiteEditor()
 {
-    qDeleteAll(points);
-    points.clear();
 }
 
 //----------------------------------------
@@ -39,29 +49,65 @@ HermiteEditor::~HermiteEditor()
  */
 void HermiteEditor::paintEvent(QPaintEvent *)
 {
+    stats.beginFrame();
+
     QPainter painter(this);
     painter.setRenderHint(QPainter::Antialiasing);
     painter.fillRect(rect(), Qt::white);
+    surfaceRenderer.begin(painter);
 
     drawHermiteCurve(painter);
+    drawHover(painter);
     drawTangents(painter);
     drawPoints(painter);
 
-    painter.setPen(Qt::black);
+    drawStatusText(painter);
+
+    stats.endFrame();
+    surfaceRenderer.end();
+    if (showProfiling) stats.drawOverlay(painter, rect());
+}
+
+/**
+ * @brief 说明文字：内容与字体不变时直接合成缓存图层
+ */
+void HermiteEditor::drawStatusText(QPainter &painter)
+{
     QStringList helpText = {
         "左键添加点，右键删除点",
         "拖动蓝点调整位置",
         "拖动绿色手柄调整切线",
-        "C 清空, +/- 改变曲线精度",
+        "C 清空, +/- 改变曲线精度, Ctrl+Z / Ctrl+Y 撤销 / 重做",
         "V 显示/隐藏插值点",
-        QString("当前精度: %1").arg(sampleResolution)
+        "Ctrl+S / Ctrl+O 保存 / 打开曲线文件",
+        "Ctrl+E / Ctrl+Shift+E 导出折线（参数 / 弧长等距）",
+        QString("P 性能统计: %1").arg(showProfiling ? "开" : "关"),
+        QString("当前精度: %1").arg(sampleResolution),
+        adaptiveMode
+            ? QString("自适应细分(A): 开, 容差([ / ]) %1px, 顶点 %2")
+                  .arg(adaptiveSettings.tolerance, 0, 'f', 2).arg(adaptiveX.size())
+            : QString("自适应细分(A): 关"),
+        lodMode
+            ? QString("视口细分(L): 开, 剔除 %1 / %2 段").arg(lodStats.culled).arg(lodStats.intervals)
+            : QString("视口细分(L): 关"),
+        precision.mode == curvecore::PRECISION_MIXED
+            ? QString("绘制精度(F): 混合, 上次采样回退 double %1 段").arg(fallbackSegments)
+            : QString("绘制精度(F): %1").arg(precision.mode == curvecore::PRECISION_FLOAT ? "float" : "double")
     };
 
-    int y = 20;
-    for (const QString &line : helpText) {
-        painter.drawText(10, y, line);
-        y += 16;
-    }
+    // 显示插值点时 drawPoints 已把字号改为 8，文字沿用当前字体
+    const QFont font = painter.font();
+    statusLayer.setKey(helpText.join('\n') + "\n" + font.toString());
+    statusLayer.draw(painter, QRect(0, 0, STATUS_WIDTH, STATUS_HEIGHT), devicePixelRatioF(),
+                     [&helpText, &font](QPainter &layer) {
+        layer.setFont(font);
+        layer.setPen(Qt::black);
+        int y = 20;
+        for (const QString &line : helpText) {
+            layer.drawText(10, y, line);
+            y += 16;
+        }
+    });
 }
 
 
@@ -74,70 +120,110 @@ void HermiteEditor::paintEvent(QPaintEvent *)
  *        支持：点选中、拖动、选中切线手柄、删除点
  */
 void HermiteEditor::mousePressEvent(QMouseEvent *event) {
-    selectedPoint = nullptr;
+    clearHover();
+    // 旧选中点的切线手柄将消失，其区域总要重绘
+    QRegion dirty = overlayRegion() | pointRegion(selectedPoint);
+    selectedPoint = -1;
     if (event->button() == Qt::RightButton) {
+        int count = spline.size();
         deletePointAt(event->pos());
-        update();
+        if (spline.size() != count) update();
+        else update(dirty);
         return;
     }
 
-    for (auto *pt : points) {
-        QPointF h0 = pt->position + pt->tangent;
-        QPointF h1 = pt->position - pt->tangent;
-        if (QLineF(event->pos(), h0).length() < SNAP_DISTANCE) {
-            selectedPoint = pt;
-            activeTangent = &pt->tangent;
-            return;
-        } else if (QLineF(event->pos(), h1).length() < SNAP_DISTANCE) {
-            selectedPoint = pt;
-            activeTangent = &pt->tangent;
-            pt->tangent = pt->position - event->pos();
-            return;
-        }
-    }
-
-    for (auto *pt : points) {
-        if (QLineF(event->pos(), pt->position).length() < SNAP_DISTANCE) {
-            selectedPoint = pt;
+    // 手柄优先于插值点；同一点的正向手柄优先于反向手柄
+    double x = event->pos().x(), y = event->pos().y();
+    int h0 = handleIndex[0].firstWithin(x, y, SNAP_DISTANCE);
+    int h1 = handleIndex[1].firstWithin(x, y, SNAP_DISTANCE);
+    if (h0 >= 0 && (h1 < 0 || h0 <= h1)) {
+        selectedPoint = h0;
+        draggingTangent = true;
+        dirty |= pointRegion(h0);
+    } else if (h1 >= 0) {
+        dirty |= pointRegion(h1);
+        selectedPoint = h1;
+        draggingTangent = true;
+        Edit edit = captureEdit(Edit::SET_TANGENT, h1);
+        setTangentVector(h1, pointAt(h1) - event->pos(), spline.hasTangent(h1));
+        updateIndex(h1);
+        if (spline.hasTangent(h1)) markTangentChanged(h1);
+        // 反向手柄翻转切线与随后的拖动合并为一条
+        commitEdit(edit, mergeKey(Edit::SET_TANGENT, h1));
+        dirty |= pointRegion(h1);
+    } else {
+        // 命中插值点则选中并开始拖动；单击空白区域仅取消选中，不创建新点
+        int hit = pointIndex.firstWithin(x, y, SNAP_DISTANCE);
+        if (hit >= 0) {
+            selectedPoint = hit;
             draggingPoint = true;
-            return;
+            dirty |= pointRegion(hit);
         }
     }
-
-    // 鼠标单击空白区域，仅取消选中，不创建新点
-    update();
+    update(dirty);
 }
 
+/**
+ * @brief 拖动插值点或切线手柄；悬停移动只更新曲线上的悬停标记
+ *        只重绘移动前后受影响曲线段与手柄的区域
+ */
 void HermiteEditor::mouseMoveEvent(QMouseEvent *event)
 {
-    if (selectedPoint && activeTangent) {
-        selectedPoint->tangent = event->pos() - selectedPoint->position;
-        selectedPoint->hasTangent = true;
-        update();
-    } else if (selectedPoint && draggingPoint) {
-        selectedPoint->position = event->pos();
-        update();
+    if (selectedPoint < 0 || (!draggingTangent && !draggingPoint)) {
+        updateHover(event->pos());
+        return;
     }
+
+    // 同一次拖动在撤销日志中合并为一条
+    QRect before = pointRegion(selectedPoint);
+    if (draggingTangent) {
+        Edit edit = captureEdit(Edit::SET_TANGENT, selectedPoint);
+        setTangentVector(selectedPoint, event->pos() - pointAt(selectedPoint), true);
+        updateIndex(selectedPoint);
+        markTangentChanged(selectedPoint);
+        commitEdit(edit, mergeKey(Edit::SET_TANGENT, selectedPoint));
+    } else {
+        Edit edit = captureEdit(Edit::MOVE_POINT, selectedPoint);
+        setPointAt(selectedPoint, event->pos());
+        updateIndex(selectedPoint);
+        markPointMoved(selectedPoint);
+        commitEdit(edit, mergeKey(Edit::MOVE_POINT, selectedPoint));
+    }
+    update(overlayRegion() | before | pointRegion(selectedPoint));
 }
 
+/**
+ * @brief 双击在末尾追加插值点；Shift+双击插入到曲线上，附近没有曲线时与普通双击相同
+ */
 void HermiteEditor::mouseDoubleClickEvent(QMouseEvent *event) {
     if (event->button() == Qt::LeftButton) {
-        auto *newPt = new InterpPoint(event->pos());
-        if (points.size() >= 1) {
-            QPointF dir = newPt->position - points.last()->position;
+        if ((event->modifiers() & Qt::ShiftModifier) && insertPointOnCurve(event->pos())) {
+            update();
+            return;
+        }
+        QPointF pos = event->pos();
+        QPointF tangent(50, 0);
+        if (spline.size() >= 1) {
+            QPointF dir = pos - pointAt(spline.size() - 1);
             if (!dir.isNull())
-                newPt->tangent = 0.5 * dir;
+                tangent = 0.5 * dir;
         }
-        points.append(newPt);
-        selectedPoint = newPt;
+        const double p[2] = { pos.x(), pos.y() };
+        const double t[2] = { tangent.x(), tangent.y() };
+        spline.append(p, t);
+        selectedPoint = spline.size() - 1;
+        appendToIndex(selectedPoint);
+        onPointAppended();
+        journal.record(captureEdit(Edit::INSERT_POINT, selectedPoint));
         update();
     }
 }
 
 void HermiteEditor::mouseReleaseEvent(QMouseEvent *event) {
     Q_UNUSED(event);
-    activeTangent = nullptr;
+    draggingTangent = false;
     draggingPoint = false;
+    journal.close();
 }
 //----------------------------------------
 // 键盘事件
@@ -145,15 +231,47 @@ void HermiteEditor::mouseReleaseEvent(QMouseEvent *event) {
 
 /**
  * @brief 处理快捷键操作
- * C 清空, +/- 调节精度, V 显示/隐藏插值点
+ * C 清空, +/- 调节精度, V 显示/隐藏插值点, Ctrl+Z / Ctrl+Y（Ctrl+Shift+Z）撤销 / 重做
  */
 void HermiteEditor::keyPressEvent(QKeyEvent *event)
 {
+    if ((event->modifiers() & Qt::ControlModifier)
+            && (event->key() == Qt::Key_Z || event->key() == Qt::Key_Y)) {
+        bool redoing = event->key() == Qt::Key_Y || (event->modifiers() & Qt::ShiftModifier);
+        if (redoing) redo();
+        else undo();
+        return;
+    }
+    if ((event->modifiers() & Qt::ControlModifier) && event->key() == Qt::Key_E) {
+        exportWithDialog((event->modifiers() & Qt::ShiftModifier)
+                         ? curvecore::EXPORT_UNIFORM_ARC_LENGTH : curvecore::EXPORT_UNIFORM_PARAMETER);
+        return;
+    }
+    if ((event->modifiers() & Qt::ControlModifier)
+            && (event->key() == Qt::Key_S || event->key() == Qt::Key_O)) {
+        bool saving = event->key() == Qt::Key_S;
+        QString fileName = saving
+            ? QFileDialog::getSaveFileName(this, "保存曲线", QString(), "曲线文件 (*.crv)")
+            : QFileDialog::getOpenFileName(this, "打开曲线", QString(), "曲线文件 (*.crv)");
+        QString error;
+        if (!fileName.isEmpty() && !(saving ? saveCurve(fileName, &error) : loadCurve(fileName, &error)))
+            QMessageBox::warning(this, saving ? "保存失败" : "打开失败", error);
+        update();
+        return;
+    }
+
     switch (event->key()) {
     case Qt::Key_C:
-        qDeleteAll(points);
-        points.clear();
-        selectedPoint = nullptr;
+        if (!spline.isEmpty()) {
+            Edit edit;
+            edit.kind = Edit::CLEAR;
+            edit.clearedSpline = std::make_shared<const Spline>(spline);
+            journal.record(edit);
+        }
+        spline.clear();
+        resetIndex();
+        invalidateCurveIndex();
+        selectedPoint = -1;
         break;
     case Qt::Key_Plus:
     case Qt::Key_Equal:
@@ -165,8 +283,34 @@ void HermiteEditor::keyPressEvent(QKeyEvent *event)
     case Qt::Key_V:
         showPoints = !showPoints;
         break;
-
+    case Qt::Key_A:
+        adaptiveMode = !adaptiveMode;
+        break;
+    case Qt::Key_L:
+        lodMode = !lodMode;
+        break;
+    case Qt::Key_P:
+        setProfilingOverlay(!showProfiling);
+        break;
+    case Qt::Key_F:
+        precision.mode = precision.mode == curvecore::PRECISION_MIXED ? curvecore::PRECISION_FLOAT
+                       : precision.mode == curvecore::PRECISION_FLOAT ? curvecore::PRECISION_DOUBLE
+                       : curvecore::PRECISION_MIXED;
+        fallbackSegments = 0;
+        segmentDirty.fill(true);
+        break;
+    case Qt::Key_BracketLeft:
+        setAdaptiveTolerance(adaptiveSettings.tolerance * 0.5);
+        break;
+    case Qt::Key_BracketRight:
+        setAdaptiveTolerance(adaptiveSettings.tolerance * 2.0);
+        break;
+    default:
+        // 未处理的按键交给父类，不重绘
+        CurveSurface::keyPressEvent(event);
+        return;
     }
+    tessellationStale = true;
     update();
 }
 
@@ -182,22 +326,74 @@ void HermiteEditor::drawPoints(QPainter &painter)
 {
     if (!showPoints) return;
 
-    painter.setPen(Qt::darkBlue);
-    painter.setBrush(Qt::darkBlue);
-
     QFont font = painter.font();
     font.setPointSize(8);
     painter.setFont(font);
 
-    for (int i = 0; i < points.size(); ++i) {
-        auto *pt = points[i];
-        painter.drawEllipse(pt->position, 5, 5);
+    // OpenGL 后端下所有圆点一次实例化绘制，图层只缓存编号
+    bool gpuDiscs = surfaceRenderer.acceleratesDiscs();
+    if (gpuDiscs) {
+        const QColor blue(Qt::darkBlue);
+        discBuffer.clear();
+        for (int i = 0; i < spline.size(); ++i)
+            discBuffer.append({ pointAt(i), 5.0, blue, blue, blue, 1.0 });
+        surfaceRenderer.drawDiscs(painter, discBuffer);
+    }
+
+    // 未选中的点来自缓存图层，选中点随拖动变化，直接绘制
+    syncPointLayer();
+    pointLayer.draw(painter, pointArea, devicePixelRatioF(), [this, &font, gpuDiscs](QPainter &layer) {
+        layer.setFont(font);
+        for (int i = 0; i < spline.size(); ++i)
+            if (i != selectedPoint) drawPoint(layer, i, !gpuDiscs);
+    });
+
+    if (selectedPoint >= 0) drawPoint(painter, selectedPoint, !gpuDiscs);
+}
 
-        // 显示编号
-        painter.setPen(Qt::black);
-        painter.drawText(pt->position + QPointF(6, -6), QString::number(i));
+void HermiteEditor::drawPoint(QPainter &painter, int i, bool withDisc)
+{
+    QPointF position = pointAt(i);
+    if (withDisc) {
         painter.setPen(Qt::darkBlue);
+        painter.setBrush(Qt::darkBlue);
+        painter.drawEllipse(position, 5, 5);
+    }
+
+    // 显示编号
+    painter.setPen(Qt::black);
+    painter.drawText(position + QPointF(6, -6), QString::number(i));
+}
+
+/**
+ * @brief 选中点、点数或窗口尺寸变化时重建插值点图层的覆盖区域
+ */
+void HermiteEditor::syncPointLayer()
+{
+    if (pointLayer.isValid() && layerSelection == selectedPoint
+            && layerCount == spline.size() && layerSize == size())
+        return;
+
+    layerSelection = selectedPoint;
+    layerCount = spline.size();
+    layerSize = size();
+    pointLayer.invalidate();
+
+    if (spline.isEmpty()) {
+        pointArea = QRect();
+        return;
+    }
+    double lo[2] = { spline.coord(0, 0), spline.coord(1, 0) };
+    double hi[2] = { lo[0], lo[1] };
+    for (int i = 1; i < spline.size(); ++i) {
+        for (int d = 0; d < 2; ++d) {
+            lo[d] = qMin(lo[d], spline.coord(d, i));
+            hi[d] = qMax(hi[d], spline.coord(d, i));
+        }
     }
+    pointArea = QRect(QPoint(qFloor(lo[0]), qFloor(lo[1])), QPoint(qCeil(hi[0]), qCeil(hi[1])))
+        .adjusted(-REPAINT_MARGIN, -REPAINT_MARGIN, REPAINT_MARGIN, REPAINT_MARGIN)
+        .intersected(rect());
 }
 
 
@@ -206,73 +402,555 @@ void HermiteEditor::drawPoints(QPainter &painter)
  */
 void HermiteEditor::drawTangents(QPainter &painter)
 {
-    if (!selectedPoint) return;
+    if (selectedPoint < 0) return;
 
     painter.setPen(QPen(Qt::darkGreen, 1.5));
-    painter.setBrush(Qt::green);
 
-    QPointF p = selectedPoint->position;
-    QPointF h0 = p + selectedPoint->tangent;
-    QPointF h1 = p - selectedPoint->tangent;
+    QPointF p = pointAt(selectedPoint);
+    QPointF tangent = tangentVector(selectedPoint);
+    QPointF h0 = p + tangent;
+    QPointF h1 = p - tangent;
 
-    if (!selectedPoint->tangent.isNull()) {
+    if (!tangent.isNull()) {
         painter.drawLine(p, h0);
         painter.drawLine(p, h1);
     }
 
-    painter.drawEllipse(h0, HANDLE_RADIUS, HANDLE_RADIUS);
-    painter.drawEllipse(h1, HANDLE_RADIUS, HANDLE_RADIUS);
+    const QColor fill(Qt::green), stroke(Qt::darkGreen);
+    discBuffer.clear();
+    discBuffer.append({ h0, double(HANDLE_RADIUS), fill, fill, stroke, 1.5 });
+    discBuffer.append({ h1, double(HANDLE_RADIUS), fill, fill, stroke, 1.5 });
+    surfaceRenderer.drawDiscs(painter, discBuffer);
 }
 
 
 /**
  * @brief Hermite 三次曲线插值绘制函数
- *        支持手动或自动切线估算
+ *        只对标记为脏的段重新求幂基系数并用 SIMD 内核采样，其余段复用缓存
  */
 void HermiteEditor::drawHermiteCurve(QPainter &painter)
 {
-    if (points.size() < 2) return;
-    QPainterPath path;
+    if (spline.size() < 2) return;
 
-    // Estimate tangents automatically if not user-defined
-    QVector<QPointF> autoTangents(points.size());
-    for (int i = 0; i < points.size(); ++i) {
-        if (i == 0)
-            autoTangents[i] = 0.5 * (points[i + 1]->position - points[i]->position);
-        else if (i == points.size() - 1)
-            autoTangents[i] = 0.5 * (points[i]->position - points[i - 1]->position);
-        else
-            autoTangents[i] = 0.5 * (points[i + 1]->position - points[i - 1]->position);
+    stats.beginTessellation();
+    if (useBackgroundTessellation()) {
+        drawBackgroundCurve(painter);
+        return;
     }
 
-    for (int i = 0; i < points.size() - 1; ++i) {
-        auto *p0 = points[i];
-        auto *p1 = points[i + 1];
+    if (adaptiveMode) {
+        int evaluations = tessellateAdaptive();
+        stats.endTessellation(adaptiveX.size(), evaluations, 0);
+        ++curveRevision;
 
-        QPointF t0 = p0->hasTangent ? p0->tangent : autoTangents[i];
-        QPointF t1 = p1->hasTangent ? p1->tangent : autoTangents[i + 1];
+        surfaceRenderer.strokePolyline(painter, adaptiveX.constData(), adaptiveY.constData(),
+                                       adaptiveX.size(), curveRevision, QPen(Qt::red, 2));
+        return;
+    }
 
-        for (int j = 0; j <= sampleResolution; ++j) {
-            double t = static_cast<double>(j) / sampleResolution;
+    if (lodMode) {
+        lodStats = curvecore::LodStats();
+        curvecore::tessellateLod(spline.view(), viewport(), lodSettings(), lodLine, &lodStats,
+                                 &surfaceRenderer.frameArena());
+        stats.endTessellation(static_cast<qint64>(lodLine.size()), lodStats.evaluations, 0);
+        ++curveRevision;
 
-            double h00 = 2 * t * t * t - 3 * t * t + 1;
-            double h10 = t * t * t - 2 * t * t + t;
-            double h01 = -2 * t * t * t + 3 * t * t;
-            double h11 = t * t * t - t * t;
+        surfaceRenderer.strokePolyline(painter, lodLine.coords[0].data(), lodLine.coords[1].data(),
+                                       static_cast<int>(lodLine.size()), curveRevision, QPen(Qt::red, 2));
+        return;
+    }
 
-            QPointF pt = h00 * p0->position + h10 * t0 + h01 * p1->position + h11 * t1;
+    syncSegmentCache();
 
-            if (j == 0)
-                path.moveTo(pt);
-            else
-                path.lineTo(pt);
+    int segments = spline.size() - 1;
+    int count = segments * sampleResolution + 1;
+    dirtySegments.clear();
+    for (int i = 0; i < segments; ++i) {
+        if (segmentDirty[i]) {
+            dirtySegments.append(i);
+            segmentDirty[i] = false;
         }
     }
 
-    painter.setPen(QPen(Qt::red, 2));
-    painter.drawPath(path);
+    // 段末点归属下一段（s = 0 时精确等于端点），只有最后一段采样到 s = 1；
+    // 脏段较多时按段分块并行采样，各段写入自己的样本区间；
+    // 混合精度下误差上界超过容差的段改用 double 求值后再转为 float
+    float *out[2] = { sampleX.data(), sampleY.data() };
+    int fallbacks = curvecore::parallelSampleSegments(curvecore::ThreadPool::instance(), spline.view(),
+                                                      dirtySegments.constData(), dirtySegments.size(),
+                                                      sampleParams.constData(), sampleResolution, out,
+                                                      precision);
+    if (!dirtySegments.isEmpty()) fallbackSegments = fallbacks;
 
+    // 段 i 采样 res 个点，最后一段多一个端点
+    int evaluated = dirtySegments.size() * sampleResolution;
+    if (!dirtySegments.isEmpty() && dirtySegments.last() == segments - 1) ++evaluated;
+    stats.endTessellation(count, evaluated, count - evaluated);
+    if (evaluated > 0) ++curveRevision;
+
+    surfaceRenderer.strokePolyline(painter, sampleX.constData(), sampleY.constData(), count,
+                                   curveRevision, QPen(Qt::red, 2));
+}
+
+/**
+ * @brief 自适应细分：每段先求幂基系数，再在段内参数 [0,1] 上按弦偏差递归二分
+ * @return 曲线求值次数
+ */
+int HermiteEditor::tessellateAdaptive()
+{
+    adaptiveX.clear();
+    adaptiveY.clear();
+    adaptiveX.append(spline.coord(0, 0));
+    adaptiveY.append(spline.coord(1, 0));
+
+    auto sink = [this](const double *p) {
+        adaptiveX.append(p[0]);
+        adaptiveY.append(p[1]);
+    };
+
+    const curvecore::HermiteView<double, 2> view = spline.view();
+    int evaluations = 0;
+    for (int i = 0; i < spline.segmentCount(); ++i) {
+        double c[2][4];
+        curvecore::segmentCoeffs(view, i, c);
+
+        auto eval = [&c, &evaluations](double s, double *p) {
+            p[0] = ((c[0][0] * s + c[0][1]) * s + c[0][2]) * s + c[0][3];
+            p[1] = ((c[1][0] * s + c[1][1]) * s + c[1][2]) * s + c[1][3];
+            ++evaluations;
+        };
+        curvecore::adaptiveTessellateInterval<double, 2>(eval, sink, 0.0, 1.0, adaptiveSettings);
+    }
+    return evaluations;
+}
+
+/**
+ * @brief 提交最新快照（若有变化）并绘制后台线程最近发布的折线
+ *        拖动期间工作线程忙碌时提交的快照只保留最新一个，GUI 线程从不等待
+ */
+void HermiteEditor::drawBackgroundCurve(QPainter &painter)
+{
+    if (lodMode && !adaptiveMode && submittedViewport != viewport()) tessellationStale = true;
+    if (tessellationStale) {
+        std::shared_ptr<TessellationJob> job = jobPool.acquire();
+        job->spline = spline;
+        job->resolution = sampleResolution;
+        job->adaptive = adaptiveMode;
+        job->settings = adaptiveSettings;
+        job->lod = lodMode;
+        job->viewport = submittedViewport = viewport();
+        job->lodSettings = lodSettings();
+        job->precision = precision;
+        backgroundTessellator.submit(job);
+        tessellationStale = false;
+    }
+
+    if (backgroundTessellator.acquire()) ++curveRevision;
+    const Polyline &line = backgroundTessellator.front();
+    stats.endTessellation(static_cast<qint64>(line.size()), 0, 0, true);
+
+    surfaceRenderer.strokePolyline(painter, line.coords[0].data(), line.coords[1].data(),
+                                   static_cast<int>(line.size()), curveRevision, QPen(Qt::red, 2));
+}
+
+void HermiteEditor::setAdaptiveTessellation(bool enabled)
+{
+    tessellationStale = true;
+    adaptiveMode = enabled;
+    update();
+}
+
+void HermiteEditor::setAdaptiveTolerance(double pixels)
+{
+    tessellationStale = true;
+    adaptiveSettings.tolerance = qBound(0.01, pixels, 16.0);
+    update();
+}
+
+void HermiteEditor::setAdaptiveMaxDepth(int depth)
+{
+    tessellationStale = true;
+    adaptiveSettings.maxDepth = qBound(0, depth, 20);
+    update();
+}
+
+void HermiteEditor::setLevelOfDetail(bool enabled)
+{
+    tessellationStale = true;
+    lodMode = enabled;
+    update();
+}
+
+bool HermiteEditor::levelOfDetail() const
+{
+    return lodMode;
+}
+
+/**
+ * @brief 曲线坐标到屏幕像素的变换：目前两者重合，平移 / 缩放接入后在此返回当前视图变换
+ */
+curvecore::Viewport HermiteEditor::viewport() const
+{
+    curvecore::Viewport view;
+    view.width = width();
+    view.height = height();
+    return view;
+}
+
+/**
+ * @brief 视口细分与自适应细分共用弦偏差容差（[ / ] 调节）
+ */
+curvecore::LodSettings HermiteEditor::lodSettings() const
+{
+    curvecore::LodSettings settings;
+    settings.tolerance = adaptiveSettings.tolerance;
+    return settings;
+}
+
+//----------------------------------------
+// 性能统计
+//----------------------------------------
+
+const RenderStats &HermiteEditor::renderStats() const
+{
+    return stats;
+}
+
+void HermiteEditor::setProfilingOverlay(bool visible)
+{
+    showProfiling = visible;
+    stats.reset();
+    update();
+}
+
+bool HermiteEditor::profilingOverlay() const
+{
+    return showProfiling;
+}
+
+QPointF HermiteEditor::pointAt(int i) const
+{
+    return QPointF(spline.coord(0, i), spline.coord(1, i));
+}
+
+QPointF HermiteEditor::tangentVector(int i) const
+{
+    return QPointF(spline.tangentCoord(0, i), spline.tangentCoord(1, i));
+}
+
+/**
+ * @brief 第 i 个点实际使用的切线
+ *        未自定义切线的点使用相邻点差分自动估算，只依赖 i-1、i、i+1 三个点
+ */
+QPointF HermiteEditor::tangentAt(int i) const
+{
+    double t[2];
+    spline.tangentAt(i, t);
+    return QPointF(t[0], t[1]);
+}
+
+void HermiteEditor::setPointAt(int i, const QPointF &p)
+{
+    const double xy[2] = { p.x(), p.y() };
+    spline.setPoint(i, xy);
+}
+
+/**
+ * @brief 设置切线向量
+ * @param custom 是否作为自定义切线参与求值，否则仍使用自动切线
+ */
+void HermiteEditor::setTangentVector(int i, const QPointF &t, bool custom)
+{
+    const double xy[2] = { t.x(), t.y() };
+    spline.setTangent(i, xy, custom);
+}
+
+//----------------------------------------
+// 局部重绘区域
+//----------------------------------------
+
+/**
+ * @brief 点 i 或其切线变化时需要重绘的区域
+ *        移动点 i 会改变相邻自动切线，受影响的是 i-2..i+1 段；每段位于其 Bézier 控制点的包围盒内。
+ *        再并入点 i 的两个切线手柄（选中时绘制），最后外扩 REPAINT_MARGIN
+ */
+QRect HermiteEditor::pointRegion(int i) const
+{
+    if (i < 0 || i >= spline.size()) return QRect();
+
+    QPointF p = pointAt(i), t = tangentVector(i);
+    double lo[2] = { qMin(p.x() - t.x(), p.x() + t.x()), qMin(p.y() - t.y(), p.y() + t.y()) };
+    double hi[2] = { qMax(p.x() - t.x(), p.x() + t.x()), qMax(p.y() - t.y(), p.y() + t.y()) };
+
+    int first = qMax(i - 2, 0), last = qMin(i + 1, spline.segmentCount() - 1);
+    for (int s = first; s <= last; ++s) {
+        double slo[2], shi[2];
+        spline.segmentBounds(s, slo, shi);
+        for (int d = 0; d < 2; ++d) {
+            lo[d] = qMin(lo[d], slo[d]);
+            hi[d] = qMax(hi[d], shi[d]);
+        }
+    }
+    return QRect(QPoint(qFloor(lo[0]), qFloor(lo[1])), QPoint(qCeil(hi[0]), qCeil(hi[1])))
+        .adjusted(-REPAINT_MARGIN, -REPAINT_MARGIN, REPAINT_MARGIN, REPAINT_MARGIN);
+}
+
+/**
+ * @brief 拖动时内容会变化的文字区域：左上角说明文字与性能面板
+ */
+QRegion HermiteEditor::overlayRegion() const
+{
+    QRegion region(0, 0, STATUS_WIDTH, STATUS_HEIGHT);
+    if (showProfiling) region |= stats.overlayRect(rect());
+    return region;
+}
+
+//----------------------------------------
+// 段采样缓存
+//----------------------------------------
+
+/**
+ * @brief 保证段缓存与当前点数、采样精度一致
+ *        规模不符（清空、精度变化等）时整体重建并全部标脏
+ */
+void HermiteEditor::syncSegmentCache()
+{
+    int segments = spline.segmentCount();
+    int count = segments > 0 ? segments * sampleResolution + 1 : 0;
+    if (cachedResolution == sampleResolution && segmentDirty.size() == segments
+            && sampleX.size() == count)
+        return;
+
+    if (cachedResolution != sampleResolution) {
+        sampleParams.resize(sampleResolution + 1);
+        for (int j = 0; j <= sampleResolution; ++j)
+            sampleParams[j] = static_cast<double>(j) / sampleResolution;
+        cachedResolution = sampleResolution;
+    }
+
+    sampleX.resize(count);
+    sampleY.resize(count);
+    segmentDirty.fill(true, segments);
+    invalidateCurveIndex();
+}
+
+void HermiteEditor::markSegmentsDirty(int first, int last)
+{
+    tessellationStale = true;
+    invalidateCurveIndex();
+    first = qMax(first, 0);
+    last = qMin(last, segmentDirty.size() - 1);
+    for (int i = first; i <= last; ++i)
+        segmentDirty[i] = true;
+}
+
+/**
+ * @brief 点 i 移动：影响相邻两段，且相邻点若为自动切线，其切线也随之改变
+ */
+void HermiteEditor::markPointMoved(int i)
+{
+    if (i < 0) return;
 
+    int first = i - 1, last = i;
+    if (i - 1 >= 0 && !spline.hasTangent(i - 1)) first = i - 2;
+    if (i + 1 < spline.size() && !spline.hasTangent(i + 1)) last = i + 1;
+    markSegmentsDirty(first, last);
+}
+
+/**
+ * @brief 点 i 的切线改变：只影响以该点为端点的两段
+ */
+void HermiteEditor::markTangentChanged(int i)
+{
+    if (i < 0) return;
+    markSegmentsDirty(i - 1, i);
+}
+
+/**
+ * @brief 末尾追加点：新增最后一段，原末点的自动切线从单侧差分变为中心差分
+ */
+void HermiteEditor::onPointAppended()
+{
+    tessellationStale = true;
+    int segments = spline.size() - 1;
+    if (segments < 1 || segmentDirty.size() != segments - 1
+            || cachedResolution != sampleResolution) {
+        syncSegmentCache();
+        return;
+    }
+
+    int count = segments * sampleResolution + 1;
+    sampleX.resize(count);
+    sampleY.resize(count);
+    segmentDirty.append(true);
+    markSegmentsDirty(segments - 2, segments - 1);
+}
+
+/**
+ * @brief 在下标 i 处插入点：原第 i-1 段拆为两段，后续段的样本整体后移一段；
+ *        两侧点的自动切线改变，新编号下 i-2..i+1 段需要重新采样
+ */
+void HermiteEditor::onPointInserted(int i)
+{
+    tessellationStale = true;
+    int segments = spline.size() - 1;
+    if (segments < 1 || segmentDirty.size() != segments - 1
+            || cachedResolution != sampleResolution) {
+        syncSegmentCache();
+        return;
+    }
+
+    int inserted = qMin(i, segments - 1);
+    sampleX.insert(inserted * sampleResolution, sampleResolution, 0.0f);
+    sampleY.insert(inserted * sampleResolution, sampleResolution, 0.0f);
+    segmentDirty.insert(inserted, true);
+    markSegmentsDirty(i - 2, i + 1);
+}
+
+/**
+ * @brief 删除点 i：原第 i-1、i 段合并为一段，后续段的样本整体前移一段；
+ *        两侧点的自动切线改变，新编号下 i-2..i 段需要重新采样
+ */
+void HermiteEditor::onPointRemoved(int i)
+{
+    tessellationStale = true;
+    int segments = spline.size() - 1;
+    if (segments < 1 || segmentDirty.size() != segments + 1
+            || cachedResolution != sampleResolution) {
+        syncSegmentCache();
+        return;
+    }
+
+    int removed = qMin(i, segments);
+    sampleX.remove(removed * sampleResolution, sampleResolution);
+    sampleY.remove(removed * sampleResolution, sampleResolution);
+    segmentDirty.remove(removed);
+    markSegmentsDirty(i - 2, i);
+}
+
+//----------------------------------------
+// 撤销 / 重做
+//----------------------------------------
+
+/**
+ * @brief 以当前状态建立一条修改记录，before 与 after 相同；修改完成后由 commitEdit 补上 after
+ */
+HermiteEditor::Edit HermiteEditor::captureEdit(Edit::Kind kind, int i) const
+{
+    Edit edit;
+    edit.kind = kind;
+    edit.index = i;
+    readEditState(kind, i, edit.before);
+    std::copy(edit.before, edit.before + 5, edit.after);
+    return edit;
+}
+
+void HermiteEditor::readEditState(Edit::Kind kind, int i, double *out) const
+{
+    switch (kind) {
+    case Edit::MOVE_POINT:
+        out[0] = spline.coord(0, i);
+        out[1] = spline.coord(1, i);
+        break;
+    case Edit::SET_TANGENT:
+        out[0] = spline.tangentCoord(0, i);
+        out[1] = spline.tangentCoord(1, i);
+        out[2] = spline.hasTangent(i) ? 1.0 : 0.0;
+        break;
+    case Edit::INSERT_POINT:
+    case Edit::REMOVE_POINT:
+        out[0] = spline.coord(0, i);
+        out[1] = spline.coord(1, i);
+        out[2] = spline.tangentCoord(0, i);
+        out[3] = spline.tangentCoord(1, i);
+        out[4] = spline.hasTangent(i) ? 1.0 : 0.0;
+        break;
+    case Edit::CLEAR:
+        break;
+    }
+}
+
+/**
+ * @brief 读取修改后的状态并记入日志；没有实际变化的修改不记录
+ */
+void HermiteEditor::commitEdit(Edit &edit, int mergeKey)
+{
+    readEditState(edit.kind, edit.index, edit.after);
+    if (std::equal(edit.before, edit.before + 5, edit.after)) return;
+    journal.record(edit, mergeKey);
+}
+
+/**
+ * @brief 撤销（undo 为 true）或重做一条修改，同步网格索引与段缓存
+ *        增删点后选中下标失效，统一取消选中
+ */
+void HermiteEditor::applyEdit(const Edit &edit, bool undo)
+{
+    const double *v = undo ? edit.before : edit.after;
+    const int i = edit.index;
+    switch (edit.kind) {
+    case Edit::MOVE_POINT:
+        setPointAt(i, QPointF(v[0], v[1]));
+        updateIndex(i);
+        markPointMoved(i);
+        break;
+    case Edit::SET_TANGENT:
+        setTangentVector(i, QPointF(v[0], v[1]), v[2] != 0.0);
+        updateIndex(i);
+        markTangentChanged(i);
+        break;
+    case Edit::INSERT_POINT:
+    case Edit::REMOVE_POINT:
+        selectedPoint = -1;
+        if (undo == (edit.kind == Edit::INSERT_POINT)) {
+            spline.remove(i);
+            removeFromIndex(i);
+            onPointRemoved(i);
+        } else {
+            const double p[2] = { v[0], v[1] };
+            const double t[2] = { v[2], v[3] };
+            spline.insert(i, p, t, v[4] != 0.0);
+            insertIntoIndex(i);
+            onPointInserted(i);
+        }
+        break;
+    case Edit::CLEAR:
+        selectedPoint = -1;
+        if (undo) spline = *edit.clearedSpline;
+        else spline.clear();
+        resetIndex();
+        syncSegmentCache();
+        markSegmentsDirty(0, segmentDirty.size() - 1);
+        break;
+    }
+
+    pointLayer.invalidate();
+    tessellationStale = true;
+    update();
+}
+
+void HermiteEditor::undo()
+{
+    if (const Edit *edit = journal.undo()) applyEdit(*edit, true);
+}
+
+void HermiteEditor::redo()
+{
+    if (const Edit *edit = journal.redo()) applyEdit(*edit, false);
+}
+
+/**
+ * @brief 批量求值 Hermite 样条（由 curvecore 完成，同段参数成批交给 SIMD 内核）
+ *        全局参数 t ∈ [0,1] 均匀映射到 spline.size()-1 段
+ * @param t    参数数组，超出 [0,1] 的部分按端点处理
+ * @param n    参数个数
+ * @param outX 输出 x 坐标（至少 n 个元素）
+ * @param outY 输出 y 坐标（至少 n 个元素）
+ */
+void HermiteEditor::evaluateMany(const double *t, size_t n, double *outX, double *outY) const
+{
+    double *out[2] = { outX, outY };
+    spline.evaluateMany(t, n, out);
 }
 
 /**
@@ -281,12 +959,306 @@ void HermiteEditor::drawHermiteCurve(QPainter &painter)
  */
 void HermiteEditor::deletePointAt(const QPointF &pos)
 {
-    for (int i = 0; i < points.size(); ++i) {
-        if (QLineF(pos, points[i]->position).length() < SNAP_DISTANCE) {
-            delete points[i];
-            points.remove(i);
-            selectedPoint = nullptr;
-            return;
-        }
+    int i = pointIndex.firstWithin(pos.x(), pos.y(), SNAP_DISTANCE);
+    if (i < 0) return;
+
+    journal.record(captureEdit(Edit::REMOVE_POINT, i));
+    spline.remove(i);
+    removeFromIndex(i);
+    selectedPoint = -1;
+    onPointRemoved(i);
+}
+
+//----------------------------------------
+// 命中测试索引
+//----------------------------------------
+
+void HermiteEditor::appendToIndex(int i)
+{
+    QPointF p = pointAt(i), t = tangentVector(i);
+    pointIndex.append(p.x(), p.y());
+    handleIndex[0].append(p.x() + t.x(), p.y() + t.y());
+    handleIndex[1].append(p.x() - t.x(), p.y() - t.y());
+}
+
+void HermiteEditor::updateIndex(int i)
+{
+    QPointF p = pointAt(i), t = tangentVector(i);
+    pointIndex.move(i, p.x(), p.y());
+    handleIndex[0].move(i, p.x() + t.x(), p.y() + t.y());
+    handleIndex[1].move(i, p.x() - t.x(), p.y() - t.y());
+}
+
+void HermiteEditor::removeFromIndex(int i)
+{
+    pointIndex.removeAt(i);
+    handleIndex[0].removeAt(i);
+    handleIndex[1].removeAt(i);
+}
+
+void HermiteEditor::insertIntoIndex(int i)
+{
+    QPointF p = pointAt(i), t = tangentVector(i);
+    pointIndex.insert(i, p.x(), p.y());
+    handleIndex[0].insert(i, p.x() + t.x(), p.y() + t.y());
+    handleIndex[1].insert(i, p.x() - t.x(), p.y() - t.y());
+}
+
+void HermiteEditor::resetIndex()
+{
+    pointIndex.clear();
+    handleIndex[0].clear();
+    handleIndex[1].clear();
+    for (int i = 0; i < spline.size(); ++i)
+        appendToIndex(i);
+}
+
+
+//----------------------------------------
+// 曲线投影
+//----------------------------------------
+
+/**
+ * @brief p 在 SNAP_DISTANCE 内的最近曲线点；曲线变化后首次查询时重建投影索引
+ */
+bool HermiteEditor::projectToCurve(const QPointF &p, double &t, QPointF &onCurve)
+{
+    if (curveIndexStale) {
+        curveIndex.build(spline.view());
+        curveIndexStale = false;
+    }
+    const double query[2] = { p.x(), p.y() };
+    double point[2];
+    if (!curveIndex.closest(spline.view(), query, double(SNAP_DISTANCE), t, point)) return false;
+    onCurve = QPointF(point[0], point[1]);
+    return true;
+}
+
+/**
+ * @brief 悬停移动：只重绘新旧两个标记
+ */
+void HermiteEditor::updateHover(const QPointF &p)
+{
+    QRect before = hoverRegion();
+    double t;
+    QPointF onCurve;
+    hovering = projectToCurve(p, t, onCurve);
+    if (hovering) hoverPoint = onCurve;
+    QRect after = hoverRegion();
+    if (before != after) update(QRegion(before) | after);
+}
+
+void HermiteEditor::clearHover()
+{
+    if (!hovering) return;
+    update(hoverRegion());
+    hovering = false;
+}
+
+QRect HermiteEditor::hoverRegion() const
+{
+    if (!hovering) return QRect();
+    const int r = HOVER_RADIUS + 2;
+    return QRect(qFloor(hoverPoint.x()) - r, qFloor(hoverPoint.y()) - r, 2 * r + 2, 2 * r + 2);
+}
+
+void HermiteEditor::invalidateCurveIndex()
+{
+    curveIndexStale = true;
+    hovering = false;
+}
+
+/**
+ * @brief 在 p 投影到曲线的位置插入插值点，投影所在的段一分为二
+ *        新点使用自动切线；保存的切线取投影处的导数换算到拆分后的半段，切换为自定义切线时沿用
+ */
+bool HermiteEditor::insertPointOnCurve(const QPointF &p)
+{
+    double t;
+    QPointF onCurve;
+    if (!projectToCurve(p, t, onCurve)) return false;
+
+    const int segments = spline.segmentCount();
+    const int i = qMin(static_cast<int>(t * segments), segments - 1) + 1;
+    double d[4];
+    spline.evaluateDerivatives(t, 1, d);
+    const double xy[2] = { onCurve.x(), onCurve.y() };
+    const double tangent[2] = { 0.5 * d[2] / segments, 0.5 * d[3] / segments };
+
+    spline.insert(i, xy, tangent);
+    insertIntoIndex(i);
+    onPointInserted(i);
+    selectedPoint = i;
+    journal.record(captureEdit(Edit::INSERT_POINT, i));
+    return true;
+}
+
+void HermiteEditor::drawHover(QPainter &painter)
+{
+    if (!hovering) return;
+    painter.save();
+    painter.setPen(QPen(QColor(255, 140, 0), 2));
+    painter.setBrush(Qt::white);
+    painter.drawEllipse(hoverPoint, HOVER_RADIUS, HOVER_RADIUS);
+    painter.restore();
+}
+
+//----------------------------------------
+// 后台细分
+//----------------------------------------
+
+/**
+ * @brief 重建整条曲线预计的求值样本数
+ *        均匀采样为 segments*res；自适应细分按每个初始子区间约 8 次求值估算；
+ *        视口细分与采样精度无关，按每段约 8 个样本估算
+ */
+int HermiteEditor::tessellationWork() const
+{
+    int segments = spline.segmentCount();
+    if (adaptiveMode)
+        return segments * adaptiveSettings.initialSplits * 8;
+    if (lodMode)
+        return segments * 8;
+    return segments * sampleResolution;
+}
+
+/**
+ * @brief 小曲线继续走同步的分段缓存路径，大曲线交给后台线程
+ */
+bool HermiteEditor::useBackgroundTessellation() const
+{
+    return tessellationWork() > BACKGROUND_WORK;
+}
+
+/**
+ * @brief 在工作线程上执行：只访问快照，不触碰编辑器状态
+ */
+void HermiteEditor::buildTessellation(const TessellationJob &job, Polyline &out)
+{
+    if (job.adaptive)
+        curvecore::tessellateAdaptive(job.spline.view(), job.settings, out);
+    else if (job.lod)
+        curvecore::tessellateLod(job.spline.view(), job.viewport, job.lodSettings, out);
+    else
+        curvecore::tessellateUniform(job.spline.view(), job.resolution, out, job.precision);
+}
+
+
+//----------------------------------------
+// 曲线文件
+//----------------------------------------
+
+bool HermiteEditor::saveCurve(const QString &fileName, QString *error) const
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        if (error) *error = file.errorString();
+        return false;
+    }
+
+    auto sink = [&file](const void *data, size_t bytes) {
+        return file.write(static_cast<const char *>(data), bytes) == static_cast<qint64>(bytes);
+    };
+    if (!curvecore::writeHermite(spline.view(), sink)) {
+        if (error) *error = file.errorString();
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief 内存映射文件后解析，再拷贝到可编辑的样条
+ */
+bool HermiteEditor::loadCurve(const QString &fileName, QString *error)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        if (error) *error = file.errorString();
+        return false;
+    }
+    uchar *data = file.map(0, file.size());
+    if (!data) {
+        if (error) *error = file.errorString();
+        return false;
     }
+
+    std::string message;
+    curvecore::CurveFileView view;
+    Spline loaded;
+    bool ok = view.open(data, static_cast<size_t>(file.size()), &message)
+           && curvecore::loadCurve(view, loaded, &message);
+    file.unmap(data);
+    if (!ok) {
+        if (error) *error = QString::fromUtf8(message.c_str());
+        return false;
+    }
+
+    spline = loaded;
+    resetIndex();
+    journal.clear();
+    selectedPoint = -1;
+    draggingPoint = false;
+    draggingTangent = false;
+
+    // 点数可能不变，段缓存须整体标脏
+    syncSegmentCache();
+    markSegmentsDirty(0, segmentDirty.size() - 1);
+    pointLayer.invalidate();
+    update();
+    return true;
+}
+
+/**
+ * @brief 询问文件名与采样点数后导出
+ */
+void HermiteEditor::exportWithDialog(curvecore::ExportSpacing spacing)
+{
+    QString fileName = QFileDialog::getSaveFileName(this, "导出折线", QString(),
+                                                    "文本 (*.txt);;二进制 (*.bin)");
+    if (fileName.isEmpty()) return;
+
+    // exportPolyline 接受 64 位点数，getInt 的上限只有 2^31-1，改用 0 位小数的 getDouble
+    bool ok = false;
+    qint64 samples = qRound64(QInputDialog::getDouble(this, "导出折线", "采样点数", 1e6, 2, 1e12, 0, &ok));
+    if (!ok) return;
+
+    QString error;
+    if (!exportPolyline(fileName, samples, 0.0, &error, spacing))
+        QMessageBox::warning(this, "导出失败", error);
+}
+
+/**
+ * @brief 导出均匀采样的折线
+ *        求值在线程池上分块进行，写出线程异步写文件，缓冲池大小固定
+ * @param tolerance 块内 Douglas–Peucker 简化容差，<= 0 时不简化
+ * @param spacing   参数等距或弧长等距（恒速遍历）
+ */
+bool HermiteEditor::exportPolyline(const QString &fileName, qint64 samples, double tolerance,
+                               QString *error, curvecore::ExportSpacing spacing) const
+{
+    if (spline.size() < 2) {
+        if (error) *error = "曲线至少需要两个点";
+        return false;
+    }
+
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        if (error) *error = file.errorString();
+        return false;
+    }
+
+    curvecore::ExportSettings settings;
+    settings.samples = static_cast<std::uint64_t>(qMax<qint64>(samples, 2));
+    settings.tolerance = tolerance;
+    settings.spacing = spacing;
+    settings.format = QFileInfo(fileName).suffix().toLower() == "bin"
+                    ? curvecore::EXPORT_BINARY : curvecore::EXPORT_TEXT;
+    settings.pool = &curvecore::ThreadPool::instance();
+
+    auto sink = [&file](const void *data, size_t bytes) {
+        return file.write(static_cast<const char *>(data), bytes) == static_cast<qint64>(bytes);
+    };
+    curvecore::ExportStats result = curvecore::exportPolyline(spline.view(), sink, settings);
+    if (!result.ok && error) *error = file.errorString();
+    return result.ok;
 }
@@ -19,16 +19,29 @@
 #include <QApplication>
 #include <QMessageBox>
 #include <QInputDialog>
+#ifdef CURVE_OPENGL
+#include <QSurfaceFormat>
+#endif
 
 #include "NurbsEditor.h"
 #include "HermiteEditor.h"
+#include "SceneViewer.h"
 
 int main(int argc, char *argv[])
 {
+#ifdef CURVE_OPENGL
+    // 实例化绘制需要 OpenGL 3.3；兼容模式保留 QPainter 在同一上下文中绘制文字与图层
+    QSurfaceFormat format;
+    format.setVersion(3, 3);
+    format.setProfile(QSurfaceFormat::CompatibilityProfile);
+    format.setSamples(4);
+    QSurfaceFormat::setDefaultFormat(format);
+#endif
+
     QApplication app(argc, argv);
     QApplication::setStyle("fusion");
 
-    QStringList options = {"NURBS 曲线", "Hermite 样条"};
+    QStringList options = {"NURBS 曲线", "Hermite 样条", "多曲线场景（只读）"};
     bool ok;
     QString choice = QInputDialog::getItem(
         nullptr,
@@ -47,9 +60,12 @@ int main(int argc, char *argv[])
     if (choice == "NURBS 曲线") {
         editor = new NURBSEditor();
         editor->setWindowTitle("NURBS 曲线编辑器");
-    } else {
+    } else if (choice == "Hermite 样条") {
         editor = new HermiteEditor();
         editor->setWindowTitle("Hermite 样条曲线编辑器");
+    } else {
+        editor = new SceneViewer();
+        editor->setWindowTitle("曲线场景查看器");
     }
 
     editor->resize(1280, 800);
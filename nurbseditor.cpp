@@ -15,14 +15,24 @@
 #include <QPainter>
 #include <QMouseEvent>
 #include <QKeyEvent>
+#include <QRegion>
 #include <QLinearGradient>
 #include <QtMath>
+#include <QFile>
+#include <QFileDialog>
+#include <QMessageBox>
+#include <QInputDialog>
+#include <QFileInfo>
 #include <algorithm>
+#include <limits>
 
 const double NURBSEditor::HANDLE_RADIUS = 60.0;
 
 NURBSEditor::NURBSEditor(QWidget *parent)
-    : QWidget(parent), selectedPoint(nullptr), activeSlopeHandle(nullptr)
+    : CurveSurface(parent), pointIndex(SNAP_DISTANCE),
+      backgroundTessellator(&NURBSEditor::buildTessellation,
+                            [this] { QMetaObject::invokeMethod(this, "update", Qt::QueuedConnection); }),
+      surfaceRenderer(this)
 {
     setMouseTracking(true);
     setFocusPolicy(Qt::StrongFocus);
@@ -31,8 +41,6 @@ NURBSEditor::NURBSEditor(QWidget *parent)
 
 NURBSEditor::~NURBSEditor()
 {
-    qDeleteAll(controlPoints);
-    controlPoints.clear();
 }
 
 
@@ -46,36 +54,26 @@ NURBSEditor::~NURBSEditor()
  */
 void NURBSEditor::paintEvent(QPaintEvent *)
 {
+    stats.beginFrame();
+
     QPainter painter(this);
     painter.setRenderHint(QPainter::Antialiasing);
     painter.fillRect(rect(), QColor(250, 250, 250));
+    surfaceRenderer.begin(painter);
 
      if (showControlPoints)drawConnectionLines(painter);
     drawNURBSCurve(painter);
      //drawHermiteCurve(painter);  // 替代 drawNURBSCurve
+    drawHover(painter);
 
      if (showControlPoints)drawSlopeHandles(painter);
     if (showControlPoints)drawControlPoints(painter);
 
-    painter.setPen(Qt::black);
-    painter.drawText(10, 20, "左键点击: 添加/移动点");
-    painter.drawText(10, 40, "拖动绿色手柄: 调整权重");
-    painter.drawText(10, 60, "上下箭头: 微调权重");
-    painter.drawText(10, 80, "Delete: 删除选中点");
-    painter.drawText(10, 100, "C: 清除所有点");
-    painter.drawText(10, 120, QString("当前阶数(数字1-5): %1").arg(degree));
-    painter.drawText(10, 140, QString("曲线采样(+ / -): %1").arg(sampleResolution));
-    painter.drawText(10, 160, QString("显示控制点: %1 (按 V 切换)").arg(showControlPoints ? "是" : "否"));
-
-    if (selectedPoint) {
-        painter.drawText(10, 160, QString("权重: %1").arg(selectedPoint->weight, 0, 'f', 2));
-    }
+    drawStatusText(painter);
 
-    QVector<double> knots = generateKnots();
-    QString knotStr = "Knots: ";
-    for (double k : knots)
-        knotStr += QString::number(k, 'f', 2) + ", ";
-    painter.drawText(10, height() - 20, knotStr);
+    stats.endFrame();
+    surfaceRenderer.end();
+    if (showProfiling) stats.drawOverlay(painter, rect());
 }
 
 
@@ -86,68 +84,83 @@ void NURBSEditor::paintEvent(QPaintEvent *)
 //鼠标单机，右键删除点，左键选中点
 void NURBSEditor::mousePressEvent(QMouseEvent *event)
 {
+    clearHover();
+    // 拖动从新的一条撤销记录开始，不与之前按住方向键调整的同一点权重合并
+    journal.close();
     if (event->button() == Qt::RightButton) {
+        int count = curve.size();
         deleteControlPoint(event->pos());
+        if (curve.size() != count) update();
     }else if (event->button() == Qt::LeftButton) {
+        int previous = selectedPoint;
         bool pointHit = false;
 
         if (!trySelectSlopeHandle(event->pos())) {
-            for (auto *cp : controlPoints) {
-                if (QLineF(event->pos(), cp->position).length() < SNAP_DISTANCE) {
-                    selectedPoint = cp;
-                    isDraggingPoint = true;
-                    pointHit = true;
-                    break;
-                }
+            int hit = pointIndex.firstWithin(event->pos().x(), event->pos().y(), SNAP_DISTANCE);
+            if (hit >= 0) {
+                selectedPoint = hit;
+                isDraggingPoint = true;
+                pointHit = true;
             }
         }
 
-        if (!pointHit && !activeSlopeHandle) {
+        if (!pointHit && activeSlopeHandle < 0) {
             // 点击空白区域：取消选中点 & 不显示手柄
-            selectedPoint = nullptr;
+            selectedPoint = -1;
         }
-    }
 
-    update();
+        // 选中状态只影响新旧两个点的颜色、权重标签与手柄
+        if (selectedPoint != previous) {
+            QRect before = pointRegion(previous);
+            update(overlayRegion() | before | pointRegion(selectedPoint));
+        }
+    }
 }
 
 //鼠标拖动，分为拖动手柄或者控制顶点
+//未拖动时（鼠标追踪产生的悬停移动）只更新曲线上的悬停标记
 void NURBSEditor::mouseMoveEvent(QMouseEvent *event)
 {
-    if (activeSlopeHandle && selectedPoint) {
+    if (selectedPoint < 0 || (activeSlopeHandle < 0 && !isDraggingPoint)) {
+        updateHover(event->pos());
+        return;
+    }
+
+    // 移动前后两个位置的受影响区域都需要重绘；同一次拖动在撤销日志中合并为一条
+    QRect before = pointRegion(selectedPoint);
+    if (activeSlopeHandle >= 0) {
+        Edit edit = captureEdit(Edit::SET_WEIGHT, selectedPoint);
         updateSlopeHandles(event->pos());
-    } else if (selectedPoint&&isDraggingPoint) {
+        commitEdit(edit, mergeKey(Edit::SET_WEIGHT, selectedPoint));
+    } else {
+        Edit edit = captureEdit(Edit::MOVE_POINT, selectedPoint);
         QPointF newPos = event->pos();
         newPos.setX(qBound(20.0, newPos.x(), width() - 20.0));
         newPos.setY(qBound(20.0, newPos.y(), height() - 20.0));
-        selectedPoint->position = newPos;
-        updateSlopeHandlePositions(*selectedPoint);
+        setControlPoint(selectedPoint, newPos);
+        pointIndex.move(selectedPoint, newPos.x(), newPos.y());
+        markSamplesDirty(selectedPoint);
+        commitEdit(edit, mergeKey(Edit::MOVE_POINT, selectedPoint));
     }
-    update();
+    update(overlayRegion() | before | pointRegion(selectedPoint));
 }
-//双击放置顶点
+//双击放置顶点；Shift+双击插入到曲线上，附近没有曲线时与普通双击相同
 void NURBSEditor::mouseDoubleClickEvent(QMouseEvent *event)
 {
     if (event->button() == Qt::LeftButton) {
-        createNewControlPoint(event->pos());
+        if (!(event->modifiers() & Qt::ShiftModifier) || !insertPointOnCurve(event->pos()))
+            createNewControlPoint(event->pos());
         update();
     }
 }
 
-//释放之后，需要重新计算手柄位置
+//释放之后结束拖动，手柄位置由点位置、角度与权重实时计算
 void NURBSEditor::mouseReleaseEvent(QMouseEvent *event)
 {
     Q_UNUSED(event);
-    activeSlopeHandle = nullptr;
-
-       if (isDraggingPoint && selectedPoint) {
-           // 拖动结束后，显示并更新切线手柄
-           //initSlopeHandles(*selectedPoint);
-           updateSlopeHandlePositions(*selectedPoint);
-       }
-
-       isDraggingPoint = false;
-       update();
+    activeSlopeHandle = -1;
+    isDraggingPoint = false;
+    journal.close();
 }
 
 //----------------------------------------
@@ -156,33 +169,67 @@ void NURBSEditor::mouseReleaseEvent(QMouseEvent *event)
 
 void NURBSEditor::keyPressEvent(QKeyEvent *event)
 {
-    if (selectedPoint) {
-        switch (event->key()) {
-        case Qt::Key_Delete: {
-            auto it = std::find(controlPoints.begin(), controlPoints.end(), selectedPoint);
-            if (it != controlPoints.end()) {
-                delete *it;
-                controlPoints.erase(it);
-                selectedPoint = nullptr;
-            }
-            break;
+    if (event->modifiers() & Qt::ControlModifier) {
+        if (event->key() == Qt::Key_Z || event->key() == Qt::Key_Y) {
+            bool redoing = event->key() == Qt::Key_Y || (event->modifiers() & Qt::ShiftModifier);
+            if (redoing) redo();
+            else undo();
+            return;
         }
-        case Qt::Key_C:
-            qDeleteAll(controlPoints);
-            controlPoints.clear();
-            selectedPoint = nullptr;
-            break;
-        case Qt::Key_Up:
-            selectedPoint->weight += 0.01;
-            updateSlopeHandlePositions(*selectedPoint);
+        if (event->key() == Qt::Key_E) {
+            exportWithDialog((event->modifiers() & Qt::ShiftModifier)
+                             ? curvecore::EXPORT_UNIFORM_ARC_LENGTH : curvecore::EXPORT_UNIFORM_PARAMETER);
+            return;
+        }
+        if (event->key() == Qt::Key_S || event->key() == Qt::Key_O) {
+            bool saving = event->key() == Qt::Key_S;
+            QString fileName = saving
+                ? QFileDialog::getSaveFileName(this, "保存曲线", QString(), "曲线文件 (*.crv)")
+                : QFileDialog::getOpenFileName(this, "打开曲线", QString(), "曲线文件 (*.crv)");
+            QString error;
+            if (!fileName.isEmpty() && !(saving ? saveCurve(fileName, &error) : loadCurve(fileName, &error)))
+                QMessageBox::warning(this, saving ? "保存失败" : "打开失败", error);
+            update();
+            return;
+        }
+    }
+
+    // 微调权重只影响选中点附近，局部重绘
+    if (selectedPoint >= 0 && (event->key() == Qt::Key_Up || event->key() == Qt::Key_Down)) {
+        QRect before = pointRegion(selectedPoint);
+        Edit edit = captureEdit(Edit::SET_WEIGHT, selectedPoint);
+        double step = event->key() == Qt::Key_Up ? 0.01 : -0.01;
+        curve.setWeight(selectedPoint, qMax(curve.weight(selectedPoint) + step, 0.1));
+        markSamplesDirty(selectedPoint);
+        // 按住不放的自动重复合并为一条，每次单独按下各占一条
+        if (!event->isAutoRepeat()) journal.close();
+        commitEdit(edit, mergeKey(Edit::SET_WEIGHT, selectedPoint));
+        update(overlayRegion() | before | pointRegion(selectedPoint));
+        return;
+    }
+
+    bool handled = false;
+    if (selectedPoint >= 0) {
+        handled = true;
+        switch (event->key()) {
+        case Qt::Key_Delete:
+            removeControlPoint(selectedPoint);
             break;
-        case Qt::Key_Down:
-            selectedPoint->weight = qMax(selectedPoint->weight - 0.01, 0.1);
-            updateSlopeHandlePositions(*selectedPoint);
+        case Qt::Key_C: {
+            Edit edit;
+            edit.kind = Edit::CLEAR;
+            edit.clearedCurve = std::make_shared<const Curve>(curve);
+            edit.clearedAngles = slopeAngles;
+            journal.record(edit);
+            clearControlPoints();
             break;
+        }
         case Qt::Key_V:
                showControlPoints = !showControlPoints;
                break;
+        default:
+            handled = false;
+            break;
         }
     }
     //调整采样精度
@@ -195,11 +242,43 @@ void NURBSEditor::keyPressEvent(QKeyEvent *event)
         sampleResolution = qMax(sampleResolution - 10, 10);
         break;
     case Qt::Key_1: case Qt::Key_2: case Qt::Key_3:
-    case Qt::Key_4: case Qt::Key_5:
-        degree = event->key() - Qt::Key_0;
+    case Qt::Key_4: case Qt::Key_5: {
+        Edit edit = captureEdit(Edit::SET_DEGREE, -1);
+        curve.setDegree(event->key() - Qt::Key_0);
+        onKnotsChanged();
+        commitEdit(edit, curvecore::DeltaJournal<Edit>::NO_MERGE);
+        break;
+    }
+    case Qt::Key_A:
+        adaptiveMode = !adaptiveMode;
+        break;
+    case Qt::Key_L:
+        lodMode = !lodMode;
+        break;
+    case Qt::Key_P:
+        setProfilingOverlay(!showProfiling);
+        break;
+    case Qt::Key_F:
+        setPrecision(precision.mode == curvecore::PRECISION_MIXED ? curvecore::PRECISION_FLOAT
+                     : precision.mode == curvecore::PRECISION_FLOAT ? curvecore::PRECISION_DOUBLE
+                     : curvecore::PRECISION_MIXED);
+        break;
+    case Qt::Key_BracketLeft:
+        setAdaptiveTolerance(adaptiveSettings.tolerance * 0.5);
+        break;
+    case Qt::Key_BracketRight:
+        setAdaptiveTolerance(adaptiveSettings.tolerance * 2.0);
+        break;
+    default:
+        if (!handled) {
+            // 未处理的按键交给父类，不重绘
+            CurveSurface::keyPressEvent(event);
+            return;
+        }
         break;
     }
 
+    tessellationStale = true;
     update();
 }
 
@@ -208,24 +287,183 @@ void NURBSEditor::keyPressEvent(QKeyEvent *event)
 //----------------------------------------
 void NURBSEditor::deleteControlPoint(const QPointF &p)
 {
-    for (auto it = controlPoints.begin(); it != controlPoints.end();) {
-        if (QLineF(p, (*it)->position).length() < SNAP_DISTANCE) {
-            if (*it == selectedPoint) selectedPoint = nullptr;
-            delete *it;
-            it = controlPoints.erase(it);
+    pointIndex.queryWithin(p.x(), p.y(), SNAP_DISTANCE, hitBuffer);
+
+    // 从大到小删除，前面的下标不受影响
+    std::sort(hitBuffer.begin(), hitBuffer.end());
+    for (int k = hitBuffer.size() - 1; k >= 0; --k)
+        removeControlPoint(hitBuffer[k]);
+}
+
+/**
+ * @brief 删除下标为 i 的控制点，并修正选中下标
+ */
+void NURBSEditor::removeControlPoint(int i)
+{
+    journal.record(captureEdit(Edit::REMOVE_POINT, i));
+    eraseControlPoint(i);
+}
+
+/**
+ * @brief 在下标 i 处插入控制点（不记录撤销日志），并修正选中下标
+ */
+void NURBSEditor::insertControlPoint(int i, const QPointF &p, double weight, double angle)
+{
+    const double xy[2] = { p.x(), p.y() };
+    curve.insert(i, xy, weight);
+    slopeAngles.insert(i, angle);
+    pointIndex.insert(i, p.x(), p.y());
+    if (selectedPoint >= i) ++selectedPoint;
+    onKnotsChanged();
+}
+
+/**
+ * @brief 删除下标 i 的控制点（不记录撤销日志）
+ */
+void NURBSEditor::eraseControlPoint(int i)
+{
+    curve.remove(i);
+    slopeAngles.remove(i);
+    pointIndex.removeAt(i);
+    if (selectedPoint == i) selectedPoint = -1;
+    else if (selectedPoint > i) --selectedPoint;
+    onKnotsChanged();
+}
+
+void NURBSEditor::clearControlPoints()
+{
+    curve.clear();
+    slopeAngles.clear();
+    pointIndex.clear();
+    selectedPoint = -1;
+    onKnotsChanged();
+}
+
+/**
+ * @brief 曲线整体替换后按当前控制点重建网格索引
+ */
+void NURBSEditor::resetPointIndex()
+{
+    pointIndex.clear();
+    for (int i = 0; i < curve.size(); ++i)
+        pointIndex.append(curve.coord(0, i), curve.coord(1, i));
+}
+
+//----------------------------------------
+// 撤销 / 重做
+//----------------------------------------
+
+/**
+ * @brief 以当前状态建立一条修改记录，before 与 after 相同；修改完成后由 commitEdit 补上 after
+ */
+NURBSEditor::Edit NURBSEditor::captureEdit(Edit::Kind kind, int i) const
+{
+    Edit edit;
+    edit.kind = kind;
+    edit.index = i;
+    readEditState(kind, i, edit.before);
+    std::copy(edit.before, edit.before + 4, edit.after);
+    return edit;
+}
+
+void NURBSEditor::readEditState(Edit::Kind kind, int i, double *out) const
+{
+    switch (kind) {
+    case Edit::MOVE_POINT:
+        out[0] = curve.coord(0, i);
+        out[1] = curve.coord(1, i);
+        break;
+    case Edit::SET_WEIGHT:
+        out[0] = curve.weight(i);
+        out[1] = slopeAngles[i];
+        break;
+    case Edit::INSERT_POINT:
+    case Edit::REMOVE_POINT:
+        out[0] = curve.coord(0, i);
+        out[1] = curve.coord(1, i);
+        out[2] = curve.weight(i);
+        out[3] = slopeAngles[i];
+        break;
+    case Edit::SET_DEGREE:
+        out[0] = curve.degree();
+        break;
+    case Edit::CLEAR:
+        break;
+    }
+}
+
+/**
+ * @brief 读取修改后的状态并记入日志；没有实际变化的修改（如权重已到下限）不记录
+ */
+void NURBSEditor::commitEdit(Edit &edit, int mergeKey)
+{
+    readEditState(edit.kind, edit.index, edit.after);
+    if (std::equal(edit.before, edit.before + 4, edit.after)) return;
+    journal.record(edit, mergeKey);
+}
+
+/**
+ * @brief 撤销（undo 为 true）或重做一条修改；增删点复用不记日志的 insert/eraseControlPoint
+ */
+void NURBSEditor::applyEdit(const Edit &edit, bool undo)
+{
+    const double *v = undo ? edit.before : edit.after;
+    const int i = edit.index;
+    switch (edit.kind) {
+    case Edit::MOVE_POINT:
+        setControlPoint(i, QPointF(v[0], v[1]));
+        pointIndex.move(i, v[0], v[1]);
+        markSamplesDirty(i);
+        break;
+    case Edit::SET_WEIGHT:
+        curve.setWeight(i, v[0]);
+        slopeAngles[i] = v[1];
+        markSamplesDirty(i);
+        break;
+    case Edit::INSERT_POINT:
+    case Edit::REMOVE_POINT:
+        if (undo == (edit.kind == Edit::INSERT_POINT)) eraseControlPoint(i);
+        else insertControlPoint(i, QPointF(v[0], v[1]), v[2], v[3]);
+        break;
+    case Edit::SET_DEGREE:
+        curve.setDegree(static_cast<int>(v[0]));
+        onKnotsChanged();
+        break;
+    case Edit::CLEAR:
+        if (undo) {
+            curve = *edit.clearedCurve;
+            slopeAngles = edit.clearedAngles;
+            resetPointIndex();
+            selectedPoint = -1;
+            onKnotsChanged();
         } else {
-            ++it;
+            clearControlPoints();
         }
+        break;
     }
+
+    invalidateControlLayers();
+    tessellationStale = true;
+    update();
+}
+
+void NURBSEditor::undo()
+{
+    if (const Edit *edit = journal.undo()) applyEdit(*edit, true);
+}
+
+void NURBSEditor::redo()
+{
+    if (const Edit *edit = journal.redo()) applyEdit(*edit, false);
 }
 
 bool NURBSEditor::trySelectSlopeHandle(const QPointF &p)
 {
-    if (!selectedPoint) return false;
+    if (selectedPoint < 0) return false;
 
-    for (auto &handle : selectedPoint->slopeHandles) {
-        if (QLineF(p, handle).length() < HANDLE_SIZE) {
-            activeSlopeHandle = &handle;
+    for (int side = 0; side < 2; ++side) {
+        if (QLineF(p, slopeHandlePosition(selectedPoint, side)).length() < HANDLE_SIZE) {
+            activeSlopeHandle = side;
             return true;
         }
     }
@@ -234,68 +472,130 @@ bool NURBSEditor::trySelectSlopeHandle(const QPointF &p)
 
 void NURBSEditor::selectOrCreateControlPoint(const QPointF &p)
 {
-    for (auto *cp : controlPoints) {
-        if (QLineF(p, cp->position).length() < SNAP_DISTANCE) {
-            selectedPoint = cp;
-            if (cp->slopeHandles.isEmpty()) {
-                initSlopeHandles(*cp);
-            }
-            return;
-        }
+    int hit = pointIndex.firstWithin(p.x(), p.y(), SNAP_DISTANCE);
+    if (hit >= 0) {
+        selectedPoint = hit;
+        return;
     }
     createNewControlPoint(p);
 }
 
 void NURBSEditor::createNewControlPoint(const QPointF &p)
 {
-    ControlPoint* cp = new ControlPoint(p);
-    controlPoints.append(cp);
-    selectedPoint = cp;
-    initSlopeHandles(*cp);
+    const double xy[2] = { p.x(), p.y() };
+    curve.append(xy);
+    slopeAngles.append(0.0);
+    pointIndex.append(p.x(), p.y());
+    selectedPoint = curve.size() - 1;
+    onKnotsChanged();
+    journal.record(captureEdit(Edit::INSERT_POINT, selectedPoint));
+}
+
+/**
+ * @brief 在 p 投影到曲线的位置插入控制点
+ *        控制点 i 的 Greville 横坐标 (u_{i+1} + ... + u_{i+p}) / p 近似其对曲线影响最大的参数，
+ *        新点插在横坐标跨过投影参数的两点之间；首末点不变
+ */
+bool NURBSEditor::insertPointOnCurve(const QPointF &p)
+{
+    double t;
+    QPointF onCurve;
+    if (!projectToCurve(p, t, onCurve)) return false;
+
+    const std::vector<double> &knots = curve.knots();
+    const int degree = curve.effectiveDegree();
+    int i = 1;
+    for (; i < curve.size() - 1; ++i) {
+        double greville = 0.0;
+        for (int k = 1; k <= degree; ++k) greville += knots[i + k];
+        if (greville / degree >= t) break;
+    }
+
+    insertControlPoint(i, onCurve, 1.0, 0.0);
+    selectedPoint = i;
+    journal.record(captureEdit(Edit::INSERT_POINT, i));
+    return true;
 }
 
 void NURBSEditor::updateSlopeHandles(const QPointF &p)
 {
-    QPointF center = selectedPoint->position;
+    QPointF center = controlPoint(selectedPoint);
         double dx = p.x() - center.x();
         double dy = p.y() - center.y();
         double distance = qSqrt(dx * dx + dy * dy);
 
         // 更新角度和权重
-        selectedPoint->slopeAngle = qAtan2(dy, dx);
+        slopeAngles[selectedPoint] = qAtan2(dy, dx);
         // 修改为不限制权重版本
-        selectedPoint->weight = qMax(0.1, distance / HANDLE_RADIUS);
+        curve.setWeight(selectedPoint, qMax(0.1, distance / HANDLE_RADIUS));
 
-        updateSlopeHandlePositions(*selectedPoint);
+        markSamplesDirty(selectedPoint);
 
 }
 
-void NURBSEditor::initSlopeHandles(ControlPoint &cp)
+/**
+ * @brief 计算第 i 个控制点的权重手柄位置
+ * @param side 0 为沿手柄方向的一端，1 为相反一端
+ */
+QPointF NURBSEditor::slopeHandlePosition(int i, int side) const
 {
-    cp.slopeHandles.clear();
-    cp.slopeHandles.append(QPointF(cp.position.x() + HANDLE_RADIUS, cp.position.y()));
-    cp.slopeHandles.append(QPointF(cp.position.x() - HANDLE_RADIUS, cp.position.y()));
-    cp.weight = 1.0;
+    double angle = slopeAngles[i];
+   // double length = cp.weight * HANDLE_RADIUS;
+    double visualLength = qMin(curve.weight(i) * HANDLE_RADIUS, 600.0); // 可视手柄不超过300像素
+    if (side == 1) visualLength = -visualLength;
+
+    return QPointF(curve.coord(0, i) + visualLength * qCos(angle),
+                   curve.coord(1, i) + visualLength * qSin(angle));
 }
 
-void NURBSEditor::updateSlopeHandlePositions(ControlPoint &cp)
+QPointF NURBSEditor::controlPoint(int i) const
 {
-    double angle = cp.slopeAngle;
-   // double length = cp.weight * HANDLE_RADIUS;
-    double visualLength = qMin(cp.weight * HANDLE_RADIUS, 600.0); // 可视手柄不超过300像素
+    return QPointF(curve.coord(0, i), curve.coord(1, i));
+}
 
-    cp.slopeHandles[0] = QPointF(cp.position.x() + visualLength * qCos(angle),
-                                 cp.position.y() + visualLength * qSin(angle));
-    cp.slopeHandles[1] = QPointF(cp.position.x() - visualLength * qCos(angle),
-                                 cp.position.y() - visualLength * qSin(angle));
+void NURBSEditor::setControlPoint(int i, const QPointF &p)
+{
+    const double xy[2] = { p.x(), p.y() };
+    curve.setPoint(i, xy);
 }
 
+//----------------------------------------
+// 局部重绘区域
+//----------------------------------------
 
-double NURBSEditor::getCurrentAngle(const ControlPoint &cp)
+/**
+ * @brief 控制点 i 的位置或权重变化时需要重绘的区域
+ *        受影响的曲线位于 P_{i-p}..P_{i+p} 的包围盒内（强凸包性），相邻控制多边形边也在其中；
+ *        选中点另加两个权重手柄，最后外扩 REPAINT_MARGIN
+ */
+QRect NURBSEditor::pointRegion(int i) const
 {
-    if (cp.slopeHandles.isEmpty()) return 0;
-    return qAtan2(cp.slopeHandles[0].y() - cp.position.y(),
-                  cp.slopeHandles[0].x() - cp.position.x());
+    if (i < 0 || i >= curve.size()) return QRect();
+
+    int p = qMax(curve.effectiveDegree(), 1);
+    double lo[2], hi[2];
+    curve.controlBounds(i - p, i + p, lo, hi);
+    if (i == selectedPoint) {
+        for (int side = 0; side < 2; ++side) {
+            QPointF h = slopeHandlePosition(i, side);
+            lo[0] = qMin(lo[0], h.x());
+            lo[1] = qMin(lo[1], h.y());
+            hi[0] = qMax(hi[0], h.x());
+            hi[1] = qMax(hi[1], h.y());
+        }
+    }
+    return QRect(QPoint(qFloor(lo[0]), qFloor(lo[1])), QPoint(qCeil(hi[0]), qCeil(hi[1])))
+        .adjusted(-REPAINT_MARGIN, -REPAINT_MARGIN, REPAINT_MARGIN, REPAINT_MARGIN);
+}
+
+/**
+ * @brief 拖动时内容会变化的文字区域：左上角说明文字与性能面板
+ */
+QRegion NURBSEditor::overlayRegion() const
+{
+    QRegion region(0, 0, STATUS_WIDTH, STATUS_HEIGHT);
+    if (showProfiling) region |= stats.overlayRect(rect());
+    return region;
 }
 
 
@@ -303,76 +603,397 @@ double NURBSEditor::getCurrentAngle(const ControlPoint &cp)
 // 曲线绘制与评估
 //----------------------------------------
 
-QPointF* NURBSEditor::getOppositeHandle(ControlPoint &cp)
+/**
+ * @brief 控制多边形：不含选中点的边来自缓存图层，选中点的两条邻边随拖动直接绘制
+ */
+void NURBSEditor::drawConnectionLines(QPainter &painter)
 {
-    if (&cp.slopeHandles[0] == activeSlopeHandle) {
-        return &cp.slopeHandles[1];
+    syncControlLayers();
+    const QPen pen(QColor(200, 200, 200, 150), 2);
+
+    polygonLayer.draw(painter, controlArea, devicePixelRatioF(), [this, &pen](QPainter &layer) {
+        layer.setPen(pen);
+        for (int i = 1; i < curve.size(); ++i) {
+            if (i == selectedPoint || i - 1 == selectedPoint) continue;
+            layer.drawLine(controlPoint(i - 1), controlPoint(i));
+        }
+    });
+
+    if (selectedPoint < 0) return;
+    painter.setPen(pen);
+    if (selectedPoint > 0)
+        painter.drawLine(controlPoint(selectedPoint - 1), controlPoint(selectedPoint));
+    if (selectedPoint + 1 < curve.size())
+        painter.drawLine(controlPoint(selectedPoint), controlPoint(selectedPoint + 1));
+}
+
+/**
+ * @brief 控制点：未选中的点来自缓存图层，选中点直接绘制
+ *        OpenGL 后端下全部点的阴影与渐变圆由一次实例化绘制完成，图层只缓存编号
+ */
+void NURBSEditor::drawControlPoints(QPainter &painter)
+{
+    bool gpuSprites = surfaceRenderer.acceleratesDiscs();
+    if (gpuSprites) {
+        discBuffer.clear();
+        for (int idx = 0; idx < curve.size(); ++idx)
+            appendControlPointDiscs(discBuffer, controlPoint(idx), idx == selectedPoint);
+        surfaceRenderer.drawDiscs(painter, discBuffer);
     }
-    return &cp.slopeHandles[0];
+
+    syncControlLayers();
+    pointLayer.draw(painter, controlArea, devicePixelRatioF(), [this, gpuSprites](QPainter &layer) {
+        layer.setFont(font());
+        for (int idx = 0; idx < curve.size(); ++idx)
+            if (idx != selectedPoint) drawControlPoint(layer, idx, !gpuSprites);
+    });
+
+    if (selectedPoint >= 0) drawControlPoint(painter, selectedPoint, !gpuSprites);
 }
 
-void NURBSEditor::drawConnectionLines(QPainter &painter)
+/**
+ * @brief 绘制单个控制点：预渲染的阴影 + 渐变精灵（withSprite 时），以及编号（选中点另加权重）
+ */
+void NURBSEditor::drawControlPoint(QPainter &painter, int idx, bool withSprite)
 {
-    painter.setPen(QPen(QColor(200, 200, 200, 150), 2));
-    for (int i = 1; i < controlPoints.size(); ++i) {
-        painter.drawLine(controlPoints[i - 1]->position, controlPoints[i]->position);
+    bool isSelected = (idx == selectedPoint);
+    QPointF position = controlPoint(idx);
+
+    if (withSprite)
+        painter.drawPixmap(position - QPointF(SPRITE_RADIUS, SPRITE_RADIUS), pointSprite(isSelected));
+
+    painter.setPen(Qt::darkGray);
+    painter.drawText(position + QPointF(-10, 20), QString::number(idx));
+
+    if (isSelected) {
+        painter.setPen(Qt::black);
+        painter.drawText(position + QPointF(15, -5),
+                         QString::number(curve.weight(idx), 'f', 2));
     }
 }
 
-void NURBSEditor::drawControlPoints(QPainter &painter)
+/**
+ * @brief 控制点精灵：阴影圆与径向渐变圆只随设备像素比重建一次，此后每个点只需一次 drawPixmap
+ */
+const QPixmap &NURBSEditor::pointSprite(bool selected)
 {
-    int idx = 0;
-    for (const auto *cp : controlPoints) {
-        bool isSelected = (cp == selectedPoint);
+    QPixmap &sprite = pointSprites[selected ? 1 : 0];
+    qreal dpr = devicePixelRatioF();
+    if (!sprite.isNull() && sprite.devicePixelRatio() == dpr) return sprite;
+
+    sprite = QPixmap(QSize(2 * SPRITE_RADIUS, 2 * SPRITE_RADIUS) * dpr);
+    sprite.setDevicePixelRatio(dpr);
+    sprite.fill(Qt::transparent);
 
-        painter.setBrush(QColor(0, 0, 0, 30));
-        painter.setPen(Qt::NoPen);
-        painter.drawEllipse(cp->position, POINT_SIZE / 2 + 3, POINT_SIZE / 2 + 3);
+    QVector<SurfaceDisc> discs;
+    appendControlPointDiscs(discs, QPointF(SPRITE_RADIUS, SPRITE_RADIUS), selected);
 
-        QRadialGradient gradient(cp->position, POINT_SIZE / 2);
-        gradient.setColorAt(0, isSelected ? QColor(255, 90, 90) : QColor(80, 140, 220));
-        gradient.setColorAt(1, isSelected ? QColor(220, 70, 70) : QColor(60, 120, 200));
+    QPainter painter(&sprite);
+    painter.setRenderHint(QPainter::Antialiasing);
+    SurfaceRenderer::paintDiscs(painter, discs);
+    return sprite;
+}
 
-        painter.setBrush(gradient);
-        painter.setPen(QPen(QColor(255, 255, 255, 150), 1.5));
-        painter.drawEllipse(cp->position, POINT_SIZE / 2, POINT_SIZE / 2);
+/**
+ * @brief 一个控制点由阴影圆与带白色描边的径向渐变圆组成
+ */
+void NURBSEditor::appendControlPointDiscs(QVector<SurfaceDisc> &discs, const QPointF &center,
+                                          bool selected) const
+{
+    const QColor shadow(0, 0, 0, 30);
+    discs.append({ center, POINT_SIZE / 2 + 3.0, shadow, shadow, Qt::transparent, 0.0 });
+    discs.append({ center, POINT_SIZE / 2.0,
+                   selected ? QColor(255, 90, 90) : QColor(80, 140, 220),
+                   selected ? QColor(220, 70, 70) : QColor(60, 120, 200),
+                   QColor(255, 255, 255, 150), 1.5 });
+}
 
-        painter.setPen(Qt::darkGray);
-        painter.drawText(cp->position + QPointF(-10, 20), QString::number(idx++));
+/**
+ * @brief 说明文字与节点向量：内容不变时直接合成缓存图层
+ */
+void NURBSEditor::drawStatusText(QPainter &painter)
+{
+    QStringList lines = {
+        "左键点击: 添加/移动点",
+        "拖动绿色手柄: 调整权重",
+        "上下箭头: 微调权重",
+        "Delete: 删除选中点",
+        "C: 清除所有点, Ctrl+Z / Ctrl+Y: 撤销 / 重做",
+        QString("当前阶数(数字1-5): %1").arg(curve.degree()),
+        QString("曲线采样(+ / -): %1").arg(sampleResolution),
+        QString("显示控制点: %1 (按 V 切换)").arg(showControlPoints ? "是" : "否"),
+        adaptiveMode
+            ? QString("自适应细分(A): 开, 容差([ / ]) %1px, 顶点 %2")
+                  .arg(adaptiveSettings.tolerance, 0, 'f', 2).arg(adaptiveX.size())
+            : QString("自适应细分(A): 关"),
+        lodMode
+            ? QString("视口细分(L): 开, 剔除 %1 / %2 区间").arg(lodStats.culled).arg(lodStats.intervals)
+            : QString("视口细分(L): 关"),
+        "Ctrl+S / Ctrl+O: 保存 / 打开曲线文件",
+        "Ctrl+E / Ctrl+Shift+E: 导出折线（参数 / 弧长等距）",
+        QString("性能统计(P): %1").arg(showProfiling ? "开" : "关"),
+        precision.mode == curvecore::PRECISION_MIXED
+            ? QString("绘制精度(F): 混合, 回退 double %1 区间").arg(mixedCurve.fallbackCount())
+            : QString("绘制精度(F): %1").arg(precision.mode == curvecore::PRECISION_FLOAT ? "float" : "double")
+    };
+    // 选中点的权重与“显示控制点”同一行叠加绘制
+    QString weightLine = selectedPoint >= 0
+        ? QString("权重: %1").arg(curve.weight(selectedPoint), 0, 'f', 2) : QString();
+
+    statusLayer.setKey(lines.join('\n') + "\n" + weightLine);
+    statusLayer.draw(painter, QRect(0, 0, STATUS_WIDTH, STATUS_HEIGHT), devicePixelRatioF(),
+                     [this, &lines, &weightLine](QPainter &layer) {
+        layer.setFont(font());
+        layer.setPen(Qt::black);
+        for (int k = 0; k < lines.size(); ++k)
+            layer.drawText(10, 20 * (k + 1), lines[k]);
+        if (!weightLine.isEmpty())
+            layer.drawText(10, 160, weightLine);
+    });
+
+    knotLayer.setKey(knotText);
+    knotLayer.draw(painter, QRect(0, height() - 40, width(), 40), devicePixelRatioF(),
+                   [this](QPainter &layer) {
+        layer.setFont(font());
+        layer.setPen(Qt::black);
+        layer.drawText(10, height() - 20, knotText);
+    });
+}
 
-        if (isSelected) {
-            painter.setPen(Qt::black);
-            painter.drawText(cp->position + QPointF(15, -5),
-                             QString::number(cp->weight, 'f', 2));
-        }
+/**
+ * @brief 选中点或窗口尺寸变化时重建控制点图层的覆盖区域
+ */
+void NURBSEditor::syncControlLayers()
+{
+    if (layerSelection == selectedPoint && layerSize == size()
+            && polygonLayer.isValid() && pointLayer.isValid())
+        return;
+
+    layerSelection = selectedPoint;
+    layerSize = size();
+    polygonLayer.invalidate();
+    pointLayer.invalidate();
+
+    if (curve.isEmpty()) {
+        controlArea = QRect();
+        return;
     }
+    double lo[2], hi[2];
+    curve.controlBounds(0, curve.size() - 1, lo, hi);
+    controlArea = QRect(QPoint(qFloor(lo[0]), qFloor(lo[1])), QPoint(qCeil(hi[0]), qCeil(hi[1])))
+        .adjusted(-REPAINT_MARGIN, -REPAINT_MARGIN, REPAINT_MARGIN, REPAINT_MARGIN)
+        .intersected(rect());
 }
 
-void NURBSEditor::drawSlopeHandles(QPainter &painter)
+/**
+ * @brief 控制点增删或整体替换后调用，下一帧重建控制点图层
+ */
+void NURBSEditor::invalidateControlLayers()
 {
-    if (!selectedPoint) return;
-    painter.setPen(QPen(QColor(150, 200, 150, 150), 1.5));
+    polygonLayer.invalidate();
+    pointLayer.invalidate();
+}
 
-    for (const auto &handle : selectedPoint->slopeHandles) {
-        painter.drawLine(selectedPoint->position, handle);
-        painter.setBrush(QColor(150, 200, 150, 150));
-        painter.drawEllipse(handle, HANDLE_SIZE / 2, HANDLE_SIZE / 2);
+void NURBSEditor::drawSlopeHandles(QPainter &painter)
+{
+    if (selectedPoint < 0) return;
+    const QColor color(150, 200, 150, 150);
+    painter.setPen(QPen(color, 1.5));
+
+    QPointF center = controlPoint(selectedPoint);
+    discBuffer.clear();
+    for (int side = 0; side < 2; ++side) {
+        QPointF handle = slopeHandlePosition(selectedPoint, side);
+        painter.drawLine(center, handle);
+        discBuffer.append({ handle, HANDLE_SIZE / 2.0, color, color, color, 1.5 });
     }
+    surfaceRenderer.drawDiscs(painter, discBuffer);
 }
 
 void NURBSEditor::drawNURBSCurve(QPainter &painter)
 {
-    if (controlPoints.size() < 2) return;
+    if (curve.size() < 2) return;
 
-    QPainterPath path;
-    path.moveTo(evaluateNURBS(0));
+    stats.beginTessellation();
+    if (useBackgroundTessellation()) {
+        drawBackgroundCurve(painter);
+        return;
+    }
+
+    const double *xs, *ys;
+    int count;
+    const QPen pen(QColor(220, 80, 80), 3.5);
+    if (adaptiveMode) {
+        int evaluations = tessellateAdaptive();
+        xs = adaptiveX.constData();
+        ys = adaptiveY.constData();
+        count = adaptiveX.size();
+        stats.endTessellation(count, evaluations, 0);
+        ++curveRevision;
+    } else if (lodMode) {
+        lodStats = curvecore::LodStats();
+        if (bezierStale) {
+            curvecore::decomposeBezier(curve.view(), bezier);
+            bezierStale = false;
+        }
+        // 自定义节点向量未夹紧时无法分解，直接在 de Boor 控制点上细分
+        if (bezier.isValid())
+            curvecore::tessellateLod(bezier, viewport(), lodSettings(), lodLine, &lodStats);
+        else
+            curvecore::tessellateLod(curve.view(), viewport(), lodSettings(), lodLine, &lodStats,
+                                     &surfaceRenderer.frameArena());
+        xs = lodLine.coords[0].data();
+        ys = lodLine.coords[1].data();
+        count = static_cast<int>(lodLine.size());
+        stats.endTessellation(count, lodStats.evaluations, 0);
+        ++curveRevision;
+    } else {
+        updateBasisTable();
+        count = basisSampleCount();
+        int evaluated = 0;
+        if (dirtyBegin < dirtyEnd) {
+            int begin = qMax(dirtyBegin, 0), end = qMin(dirtyEnd, count);
+            evaluateSamples(begin, end);
+            evaluated = qMax(end - begin, 0);
+            dirtyBegin = count;
+            dirtyEnd = 0;
+        }
+        stats.endTessellation(count, evaluated, count - evaluated);
+        if (evaluated > 0) ++curveRevision;
+
+        // 采样缓存为 float，GPU 上传时不再转换
+        surfaceRenderer.strokePolyline(painter, sampleX.constData(), sampleY.constData(), count, curveRevision, pen);
+        return;
+    }
 
-    for (int t = 1; t <= sampleResolution; ++t) {
-        path.lineTo(evaluateNURBS(static_cast<double>(t) / sampleResolution));
+    surfaceRenderer.strokePolyline(painter, xs, ys, count, curveRevision, pen);
+}
+
+/**
+ * @brief 自适应细分整条曲线（curvecore::tessellateAdaptive），顶点直接写入 adaptiveX / adaptiveY
+ * @return 曲线求值次数
+ */
+int NURBSEditor::tessellateAdaptive()
+{
+    adaptiveX.clear();
+    adaptiveY.clear();
+
+    const curvecore::NurbsView<double, 2> view = curve.view();
+    int evaluations = 0;
+    curvecore::tessellateAdaptive(view, adaptiveSettings,
+                                  [&view, &evaluations](double t, double *p) {
+        curvecore::evaluate(view, t, p);
+        ++evaluations;
+    }, [this](const double *p) {
+        adaptiveX.append(p[0]);
+        adaptiveY.append(p[1]);
+    });
+    return evaluations;
+}
+
+/**
+ * @brief 提交最新快照（若有变化）并绘制后台线程最近发布的折线
+ *        拖动期间工作线程忙碌时提交的快照只保留最新一个，GUI 线程从不等待
+ */
+void NURBSEditor::drawBackgroundCurve(QPainter &painter)
+{
+    if (lodMode && !adaptiveMode && submittedViewport != viewport()) tessellationStale = true;
+    if (tessellationStale) {
+        std::shared_ptr<TessellationJob> job = jobPool.acquire();
+        job->curve = curve;
+        job->resolution = sampleResolution;
+        job->adaptive = adaptiveMode;
+        job->settings = adaptiveSettings;
+        job->lod = lodMode;
+        job->viewport = submittedViewport = viewport();
+        job->lodSettings = lodSettings();
+        job->precision = precision;
+        backgroundTessellator.submit(job);
+        tessellationStale = false;
     }
 
-    painter.setPen(QPen(QColor(220, 80, 80), 3.5));
-    painter.drawPath(path);
+    if (backgroundTessellator.acquire()) ++curveRevision;
+    const Polyline &line = backgroundTessellator.front();
+    stats.endTessellation(static_cast<qint64>(line.size()), 0, 0, true);
+
+    surfaceRenderer.strokePolyline(painter, line.coords[0].data(), line.coords[1].data(),
+                                   static_cast<int>(line.size()), curveRevision,
+                                   QPen(QColor(220, 80, 80), 3.5));
+}
+
+void NURBSEditor::setAdaptiveTessellation(bool enabled)
+{
+    tessellationStale = true;
+    adaptiveMode = enabled;
+    update();
+}
+
+void NURBSEditor::setAdaptiveTolerance(double pixels)
+{
+    tessellationStale = true;
+    adaptiveSettings.tolerance = qBound(0.01, pixels, 16.0);
+    update();
+}
+
+void NURBSEditor::setAdaptiveMaxDepth(int depth)
+{
+    tessellationStale = true;
+    adaptiveSettings.maxDepth = qBound(0, depth, 20);
+    update();
+}
+
+void NURBSEditor::setLevelOfDetail(bool enabled)
+{
+    tessellationStale = true;
+    lodMode = enabled;
+    update();
+}
+
+bool NURBSEditor::levelOfDetail() const
+{
+    return lodMode;
+}
+
+/**
+ * @brief 曲线坐标到屏幕像素的变换：目前两者重合，平移 / 缩放接入后在此返回当前视图变换
+ */
+curvecore::Viewport NURBSEditor::viewport() const
+{
+    curvecore::Viewport view;
+    view.width = width();
+    view.height = height();
+    return view;
+}
+
+/**
+ * @brief 视口细分与自适应细分共用弦偏差容差（[ / ] 调节）
+ */
+curvecore::LodSettings NURBSEditor::lodSettings() const
+{
+    curvecore::LodSettings settings;
+    settings.tolerance = adaptiveSettings.tolerance;
+    return settings;
+}
+
+//----------------------------------------
+// 性能统计
+//----------------------------------------
+
+const RenderStats &NURBSEditor::renderStats() const
+{
+    return stats;
+}
+
+void NURBSEditor::setProfilingOverlay(bool visible)
+{
+    showProfiling = visible;
+    stats.reset();
+    update();
+}
+
+bool NURBSEditor::profilingOverlay() const
+{
+    return showProfiling;
 }
 
 
@@ -381,55 +1002,363 @@ void NURBSEditor::drawNURBSCurve(QPainter &painter)
 //----------------------------------------
 QPointF NURBSEditor::evaluateNURBS(double t) const
 {
-    if (controlPoints.size() < 2) return QPointF();
-    if (t <= 0) return controlPoints.first()->position;
-    if (t >= 1) return controlPoints.last()->position;
+    double x = 0.0, y = 0.0;
+    evaluateMany(&t, 1, &x, &y);
+    return QPointF(x, y);
+}
 
-    t = qBound(0.0, t, 1.0);
-    QVector<double> knots = generateKnots();
-    int n = controlPoints.size() - 1;
+/**
+ * @brief 批量求值 NURBS 曲线（由 curvecore 完成，复用相邻样本的节点区间）
+ * @param t    参数数组，取值范围 [0,1]，超出部分按端点处理
+ * @param n    参数个数
+ * @param outX 输出 x 坐标（至少 n 个元素）
+ * @param outY 输出 y 坐标（至少 n 个元素）
+ */
+void NURBSEditor::evaluateMany(const double *t, size_t n, double *outX, double *outY) const
+{
+    double *out[2] = { outX, outY };
+    curve.evaluateMany(t, n, out);
+}
 
-    double x = 0.0, y = 0.0, denominator = 0.0;
-    for (int i = 0; i <= n; ++i) {
-        double basis = basisFunction(degree, i, knots, t) * controlPoints[i]->weight;
-        x += controlPoints[i]->position.x() * basis;
-        y += controlPoints[i]->position.y() * basis;
-        denominator += basis;
+/**
+ * @brief 节点向量已由 curve 重建（控制点增删或阶数改变），整条曲线需重新采样，
+ *        控制点图层与节点向量文字随之重建；拖动点、调整权重不影响节点向量
+ */
+void NURBSEditor::onKnotsChanged()
+{
+    markAllSamplesDirty();
+    invalidateControlLayers();
+
+    knotText = "Knots: ";
+    for (double k : curve.knots())
+        knotText += QString::number(k, 'f', 2) + ", ";
+}
+
+/**
+ * @brief 为定义域上的均匀采样网格（sampleResolution 等分）建立稀疏基函数表
+ *        基函数只依赖阶数、节点向量和采样密度，与控制点位置、权重无关，
+ *        三者未变化时直接返回（表自带节点向量比较，加载或撤销换入不同节点时同样重建）
+ */
+void NURBSEditor::updateBasisTable()
+{
+    if (basisTableMatches())
+        return;
+
+    // float 表同样在 double 中求节点区间与基函数，只在存储时舍入
+    if (usesFloatTable()) {
+        floatBasisTable.build(curve.view(), sampleResolution);
+        basisTable.clear();
+    } else {
+        basisTable.build(curve.view(), sampleResolution);
+        floatBasisTable.clear();
     }
+    markAllSamplesDirty();
+
+    sampleX.resize(basisSampleCount());
+    sampleY.resize(basisSampleCount());
+}
 
-    return denominator != 0.0 ? QPointF(x / denominator, y / denominator) : QPointF();
+bool NURBSEditor::basisTableMatches() const
+{
+    const curvecore::NurbsView<double, 2> view = curve.view();
+    return usesFloatTable() ? floatBasisTable.matches(view, sampleResolution)
+                            : basisTable.matches(view, sampleResolution);
 }
 
-double NURBSEditor::basisFunction(int p, int i, const QVector<double> &knots, double t) const
+int NURBSEditor::basisSampleCount() const
 {
-    if (p == 0) {
-        return (knots[i] <= t && t < knots[i + 1]) ? 1.0 : 0.0;
+    return usesFloatTable() ? floatBasisTable.sampleCount() : basisTable.sampleCount();
+}
+
+/**
+ * @brief 切换绘制精度：基函数表、float 副本与采样缓存整体重建
+ */
+void NURBSEditor::setPrecision(curvecore::EvalPrecision mode)
+{
+    precision.mode = mode;
+    basisTable.clear();
+    floatBasisTable.clear();
+    markAllSamplesDirty();
+}
+
+/**
+ * @brief 用基函数表计算样本 [begin, end) 的曲线坐标，写入 sampleX/sampleY
+ *        每个样本只剩 p+1 项的加权求和；样本多时分块交给线程池，各块写入互不重叠
+ *        float / 混合精度下用 float 表求和，混合精度中误差上界超过容差的节点区间改用 double
+ */
+void NURBSEditor::evaluateSamples(int begin, int end)
+{
+    const curvecore::NurbsView<double, 2> view = curve.view();
+    float *out[2] = { sampleX.data(), sampleY.data() };
+    const bool useFloat = usesFloatTable();
+    if (useFloat && mixedCurveStale) {
+        mixedCurve.assign(view, precision, false);
+        mixedCurveStale = false;
     }
+    curvecore::ThreadPool::instance().parallelFor(begin, end, curvecore::PARALLEL_SAMPLE_GRAIN,
+                                                  [&](size_t b, size_t e) {
+        if (useFloat)
+            mixedCurve.evaluateTable(view, floatBasisTable, static_cast<int>(b), static_cast<int>(e), out);
+        else
+            basisTable.evaluate(view, static_cast<int>(b), static_cast<int>(e), out);
+    });
+}
+
+/**
+ * @brief 标记受某个控制点影响的样本为脏
+ *        控制点 i 只影响 [u_i, u_{i+p+1})，即节点区间 i..i+p 内的样本；
+ *        基函数表中 spans 单调不减，可二分得到样本区间
+ */
+void NURBSEditor::markSamplesDirty(int i)
+{
+    if (i < 0) return;
+    tessellationStale = true;
+    bezierStale = true;
+    curveIndexStale = true;
+    hovering = false;
+    // 只更新该点的 float 副本与受影响节点区间的回退标记
+    if (!mixedCurveStale) mixedCurve.updatePoint(curve.view(), i);
+
+    // 基函数表已过期时下一帧会整体重算
+    if (!basisTableMatches())
+        return;
+
+    int begin, end;
+    if (usesFloatTable()) floatBasisTable.supportRange(i, begin, end);
+    else basisTable.supportRange(i, begin, end);
+
+    dirtyBegin = qMin(dirtyBegin, begin);
+    dirtyEnd = qMax(dirtyEnd, end);
+}
+
+void NURBSEditor::markAllSamplesDirty()
+{
+    tessellationStale = true;
+    bezierStale = true;
+    curveIndexStale = true;
+    hovering = false;
+    mixedCurveStale = true;
+    dirtyBegin = 0;
+    dirtyEnd = std::numeric_limits<int>::max();
+}
 
-    double term1 = 0.0, term2 = 0.0;
-    double denom1 = knots[i + p] - knots[i];
-    if (!qFuzzyIsNull(denom1))
-        term1 = (t - knots[i]) / denom1 * basisFunction(p - 1, i, knots, t);
 
-    double denom2 = knots[i + p + 1] - knots[i + 1];
-    if (!qFuzzyIsNull(denom2))
-        term2 = (knots[i + p + 1] - t) / denom2 * basisFunction(p - 1, i + 1, knots, t);
+//----------------------------------------
+// 曲线投影
+//----------------------------------------
+
+/**
+ * @brief p 在 SNAP_DISTANCE 内的最近曲线点；曲线变化后首次查询时重建投影索引
+ */
+bool NURBSEditor::projectToCurve(const QPointF &p, double &t, QPointF &onCurve)
+{
+    if (curveIndexStale) {
+        curveIndex.build(curve.view());
+        curveIndexStale = false;
+    }
+    const double query[2] = { p.x(), p.y() };
+    double point[2];
+    if (!curveIndex.closest(curve.view(), query, double(SNAP_DISTANCE), t, point)) return false;
+    onCurve = QPointF(point[0], point[1]);
+    return true;
+}
 
-    return term1 + term2;
+/**
+ * @brief 悬停移动：只重绘新旧两个标记
+ */
+void NURBSEditor::updateHover(const QPointF &p)
+{
+    QRect before = hoverRegion();
+    double t;
+    QPointF onCurve;
+    hovering = projectToCurve(p, t, onCurve);
+    if (hovering) hoverPoint = onCurve;
+    QRect after = hoverRegion();
+    if (before != after) update(QRegion(before) | after);
 }
 
-QVector<double> NURBSEditor::generateKnots() const
+void NURBSEditor::clearHover()
 {
-    int n = controlPoints.size() - 1;
-    int m = n + degree + 1;
-    QVector<double> knots(m + 1);
+    if (!hovering) return;
+    update(hoverRegion());
+    hovering = false;
+}
 
-    for (int i = 0; i <= degree; ++i) knots[i] = 0.0;
-    for (int i = m - degree; i <= m; ++i) knots[i] = 1.0;
-    for (int i = degree + 1; i < m - degree; ++i)
-        knots[i] = static_cast<double>(i - degree) / (n - degree + 1);
+QRect NURBSEditor::hoverRegion() const
+{
+    if (!hovering) return QRect();
+    const int r = HOVER_RADIUS + 2;
+    return QRect(qFloor(hoverPoint.x()) - r, qFloor(hoverPoint.y()) - r, 2 * r + 2, 2 * r + 2);
+}
 
-    return knots;
+void NURBSEditor::drawHover(QPainter &painter)
+{
+    if (!hovering) return;
+    painter.save();
+    painter.setPen(QPen(QColor(255, 140, 0), 2));
+    painter.setBrush(Qt::white);
+    painter.drawEllipse(hoverPoint, HOVER_RADIUS, HOVER_RADIUS);
+    painter.restore();
 }
 
+//----------------------------------------
+// 后台细分
+//----------------------------------------
+
+/**
+ * @brief 重建整条曲线预计的基函数求值次数
+ *        均匀采样为 (res+1)(p+1)；自适应细分按每个节点区间约 8 次求值估算；
+ *        视口细分与采样精度无关，按每个节点区间约 8 个样本估算
+ */
+int NURBSEditor::tessellationWork() const
+{
+    int stride = curve.effectiveDegree() + 1;
+    if (adaptiveMode)
+        return curve.size() * adaptiveSettings.initialSplits * 8 * stride;
+    if (lodMode)
+        return curve.size() * 8 * stride;
+    return (sampleResolution + 1) * stride;
+}
 
+/**
+ * @brief 小曲线继续走同步的增量采样路径，大曲线交给后台线程
+ */
+bool NURBSEditor::useBackgroundTessellation() const
+{
+    return tessellationWork() > BACKGROUND_WORK;
+}
+
+/**
+ * @brief 在工作线程上执行：只访问快照，不触碰编辑器状态
+ */
+void NURBSEditor::buildTessellation(const TessellationJob &job, Polyline &out)
+{
+    if (job.adaptive)
+        curvecore::tessellateAdaptive(job.curve.view(), job.settings, out);
+    else if (job.lod) {
+        curvecore::BezierSegments<double, 2> bezier;
+        if (curvecore::decomposeBezier(job.curve.view(), bezier))
+            curvecore::tessellateLod(bezier, job.viewport, job.lodSettings, out);
+        else
+            curvecore::tessellateLod(job.curve.view(), job.viewport, job.lodSettings, out);
+    } else
+        curvecore::tessellateUniform(job.curve.view(), job.resolution, out, job.precision);
+}
+
+
+//----------------------------------------
+// 曲线文件
+//----------------------------------------
+
+bool NURBSEditor::saveCurve(const QString &fileName, QString *error) const
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        if (error) *error = file.errorString();
+        return false;
+    }
+
+    auto sink = [&file](const void *data, size_t bytes) {
+        return file.write(static_cast<const char *>(data), bytes) == static_cast<qint64>(bytes);
+    };
+    if (!curvecore::writeNurbs(curve.view(), sink)) {
+        if (error) *error = file.errorString();
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief 内存映射文件后解析，再拷贝到可编辑的曲线；文件中的节点向量原样保留
+ */
+bool NURBSEditor::loadCurve(const QString &fileName, QString *error)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        if (error) *error = file.errorString();
+        return false;
+    }
+    uchar *data = file.map(0, file.size());
+    if (!data) {
+        if (error) *error = file.errorString();
+        return false;
+    }
+
+    std::string message;
+    curvecore::CurveFileView view;
+    Curve loaded;
+    bool ok = view.open(data, static_cast<size_t>(file.size()), &message)
+           && curvecore::loadCurve(view, loaded, &message);
+    file.unmap(data);
+    if (!ok) {
+        if (error) *error = QString::fromUtf8(message.c_str());
+        return false;
+    }
+
+    curve = loaded;
+    slopeAngles = QVector<double>(curve.size(), 0.0);
+    resetPointIndex();
+    journal.clear();
+    selectedPoint = -1;
+    activeSlopeHandle = -1;
+    isDraggingPoint = false;
+
+    onKnotsChanged();
+    update();
+    return true;
+}
+
+/**
+ * @brief 询问文件名与采样点数后导出
+ */
+void NURBSEditor::exportWithDialog(curvecore::ExportSpacing spacing)
+{
+    QString fileName = QFileDialog::getSaveFileName(this, "导出折线", QString(),
+                                                    "文本 (*.txt);;二进制 (*.bin)");
+    if (fileName.isEmpty()) return;
+
+    // exportPolyline 接受 64 位点数，getInt 的上限只有 2^31-1，改用 0 位小数的 getDouble
+    bool ok = false;
+    qint64 samples = qRound64(QInputDialog::getDouble(this, "导出折线", "采样点数", 1e6, 2, 1e12, 0, &ok));
+    if (!ok) return;
+
+    QString error;
+    if (!exportPolyline(fileName, samples, 0.0, &error, spacing))
+        QMessageBox::warning(this, "导出失败", error);
+}
+
+/**
+ * @brief 导出均匀采样的折线
+ *        求值在线程池上分块进行，写出线程异步写文件，缓冲池大小固定
+ * @param tolerance 块内 Douglas–Peucker 简化容差，<= 0 时不简化
+ * @param spacing   参数等距或弧长等距（恒速遍历）
+ */
+bool NURBSEditor::exportPolyline(const QString &fileName, qint64 samples, double tolerance,
+                               QString *error, curvecore::ExportSpacing spacing) const
+{
+    if (curve.size() < 2) {
+        if (error) *error = "曲线至少需要两个点";
+        return false;
+    }
+
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        if (error) *error = file.errorString();
+        return false;
+    }
+
+    curvecore::ExportSettings settings;
+    settings.samples = static_cast<std::uint64_t>(qMax<qint64>(samples, 2));
+    settings.tolerance = tolerance;
+    settings.spacing = spacing;
+    settings.format = QFileInfo(fileName).suffix().toLower() == "bin"
+                    ? curvecore::EXPORT_BINARY : curvecore::EXPORT_TEXT;
+    settings.pool = &curvecore::ThreadPool::instance();
+
+    auto sink = [&file](const void *data, size_t bytes) {
+        return file.write(static_cast<const char *>(data), bytes) == static_cast<qint64>(bytes);
+    };
+    curvecore::ExportStats result = curvecore::exportPolyline(curve.view(), sink, settings);
+    if (!result.ok && error) *error = file.errorString();
+    return result.ok;
+}
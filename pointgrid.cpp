@@ -0,0 +1,153 @@
+/**
+ * @file pointgrid.cpp
+ * @brief PointGrid 均匀网格空间索引实现
+ */
+#include "PointGrid.h"
+#include <QtMath>
+
+PointGrid::PointGrid(double cellSize)
+    : cellSize(cellSize > 0 ? cellSize : 32.0)
+{
+}
+
+void PointGrid::clear()
+{
+    px.clear();
+    py.clear();
+    cellOf.clear();
+    cells.clear();
+}
+
+void PointGrid::append(double x, double y)
+{
+    int id = px.size();
+    qint64 key = cellKey(x, y);
+    px.append(x);
+    py.append(y);
+    cellOf.append(key);
+    addToCell(key, id);
+}
+
+void PointGrid::insert(int id, double x, double y)
+{
+    if (id >= px.size()) {
+        append(x, y);
+        return;
+    }
+
+    shiftIds(id, 1);
+    qint64 key = cellKey(x, y);
+    px.insert(id, x);
+    py.insert(id, y);
+    cellOf.insert(id, key);
+    addToCell(key, id);
+}
+
+void PointGrid::removeAt(int id)
+{
+    removeFromCell(cellOf[id], id);
+    px.remove(id);
+    py.remove(id);
+    cellOf.remove(id);
+    if (id < px.size())
+        shiftIds(id + 1, -1);
+}
+
+void PointGrid::move(int id, double x, double y)
+{
+    px[id] = x;
+    py[id] = y;
+
+    qint64 key = cellKey(x, y);
+    if (key == cellOf[id]) return;
+
+    removeFromCell(cellOf[id], id);
+    addToCell(key, id);
+    cellOf[id] = key;
+}
+
+int PointGrid::firstWithin(double x, double y, double radius) const
+{
+    int best = -1;
+    double r2 = radius * radius;
+
+    int ix0 = qFloor((x - radius) / cellSize), ix1 = qFloor((x + radius) / cellSize);
+    int iy0 = qFloor((y - radius) / cellSize), iy1 = qFloor((y + radius) / cellSize);
+    for (int ix = ix0; ix <= ix1; ++ix) {
+        for (int iy = iy0; iy <= iy1; ++iy) {
+            auto it = cells.constFind(packKey(ix, iy));
+            if (it == cells.constEnd()) continue;
+
+            for (int id : it.value()) {
+                if (best >= 0 && id >= best) continue;
+                double dx = px[id] - x, dy = py[id] - y;
+                if (dx * dx + dy * dy < r2) best = id;
+            }
+        }
+    }
+    return best;
+}
+
+void PointGrid::queryWithin(double x, double y, double radius, QVector<int> &out) const
+{
+    out.clear();
+    double r2 = radius * radius;
+
+    int ix0 = qFloor((x - radius) / cellSize), ix1 = qFloor((x + radius) / cellSize);
+    int iy0 = qFloor((y - radius) / cellSize), iy1 = qFloor((y + radius) / cellSize);
+    for (int ix = ix0; ix <= ix1; ++ix) {
+        for (int iy = iy0; iy <= iy1; ++iy) {
+            auto it = cells.constFind(packKey(ix, iy));
+            if (it == cells.constEnd()) continue;
+
+            for (int id : it.value()) {
+                double dx = px[id] - x, dy = py[id] - y;
+                if (dx * dx + dy * dy < r2) out.append(id);
+            }
+        }
+    }
+}
+
+qint64 PointGrid::cellKey(double x, double y) const
+{
+    return packKey(qFloor(x / cellSize), qFloor(y / cellSize));
+}
+
+qint64 PointGrid::packKey(int ix, int iy)
+{
+    return (static_cast<qint64>(ix) << 32) | static_cast<quint32>(iy);
+}
+
+void PointGrid::addToCell(qint64 key, int id)
+{
+    cells[key].append(id);
+}
+
+void PointGrid::removeFromCell(qint64 key, int id)
+{
+    auto it = cells.find(key);
+    if (it == cells.end()) return;
+
+    QVector<int> &ids = it.value();
+    for (int k = 0; k < ids.size(); ++k) {
+        if (ids[k] == id) {
+            // 格内顺序无关，用末尾元素填补
+            ids[k] = ids.last();
+            ids.removeLast();
+            break;
+        }
+    }
+    if (ids.isEmpty()) cells.erase(it);
+}
+
+/**
+ * @brief 编号 >= from 的点整体平移 delta，保持与编辑器数组下标一致
+ */
+void PointGrid::shiftIds(int from, int delta)
+{
+    for (auto it = cells.begin(); it != cells.end(); ++it) {
+        for (int &id : it.value()) {
+            if (id >= from) id += delta;
+        }
+    }
+}
@@ -0,0 +1,140 @@
+/**
+ * @file renderstats.cpp
+ * @brief RenderStats 实现：计时、滑动窗口汇总与性能面板绘制
+ */
+#include "RenderStats.h"
+
+#include <QPainter>
+#include <QRect>
+#include <QStringList>
+
+namespace {
+const int OVERLAY_WIDTH = 260;
+const int OVERLAY_LINE_HEIGHT = 16;
+const int OVERLAY_LINES = 6;
+}
+
+RenderStats::RenderStats()
+{
+    history.reserve(WINDOW);
+}
+
+void RenderStats::beginFrame()
+{
+    current = FrameStats();
+    frameTimer.start();
+}
+
+void RenderStats::beginTessellation()
+{
+    stageTimer.start();
+}
+
+void RenderStats::endTessellation(qint64 samples, qint64 evaluations, qint64 cacheHits, bool background)
+{
+    current.tessellationMs = stageTimer.nsecsElapsed() * 1e-6;
+    current.samples = samples;
+    current.evaluations = evaluations;
+    current.cacheHits = cacheHits;
+    current.background = background;
+}
+
+void RenderStats::endFrame()
+{
+    current.frameMs = frameTimer.nsecsElapsed() * 1e-6;
+    current.drawMs = qMax(0.0, current.frameMs - current.tessellationMs);
+    last = current;
+
+    if (history.size() < WINDOW) history.append(current);
+    else history[next] = current;
+    next = (next + 1) % WINDOW;
+    ++frames;
+}
+
+FrameStats RenderStats::average() const
+{
+    FrameStats avg;
+    if (history.isEmpty()) return avg;
+
+    for (const FrameStats &f : history) {
+        avg.frameMs += f.frameMs;
+        avg.tessellationMs += f.tessellationMs;
+        avg.drawMs += f.drawMs;
+        avg.samples += f.samples;
+        avg.evaluations += f.evaluations;
+        avg.cacheHits += f.cacheHits;
+    }
+    int n = history.size();
+    avg.frameMs /= n;
+    avg.tessellationMs /= n;
+    avg.drawMs /= n;
+    avg.samples /= n;
+    avg.evaluations /= n;
+    avg.cacheHits /= n;
+    avg.background = last.background;
+    return avg;
+}
+
+double RenderStats::evaluationsPerSecond() const
+{
+    double evaluations = 0.0, ms = 0.0;
+    for (const FrameStats &f : history) {
+        evaluations += f.evaluations;
+        ms += f.tessellationMs;
+    }
+    return ms > 0.0 ? evaluations * 1000.0 / ms : 0.0;
+}
+
+double RenderStats::cacheHitRate() const
+{
+    double hits = 0.0, total = 0.0;
+    for (const FrameStats &f : history) {
+        hits += f.cacheHits;
+        total += f.cacheHits + f.evaluations;
+    }
+    return total > 0.0 ? hits / total : 0.0;
+}
+
+void RenderStats::reset()
+{
+    current = FrameStats();
+    last = FrameStats();
+    history.clear();
+    next = 0;
+    frames = 0;
+}
+
+void RenderStats::drawOverlay(QPainter &painter, const QRect &area) const
+{
+    const FrameStats avg = average();
+    QStringList lines = {
+        QString("性能统计 (P 关闭)，最近 %1 帧平均").arg(history.size()),
+        QString("帧耗时: %1 ms").arg(avg.frameMs, 0, 'f', 2),
+        QString("  细分: %1 ms  绘制: %2 ms").arg(avg.tessellationMs, 0, 'f', 2).arg(avg.drawMs, 0, 'f', 2),
+        QString("顶点: %1  本帧求值: %2").arg(last.samples).arg(last.evaluations),
+        QString("求值吞吐: %1 M/s").arg(evaluationsPerSecond() * 1e-6, 0, 'f', 1),
+        last.background
+            ? QString("缓存命中: 不适用（后台细分）")
+            : QString("缓存命中: %1%").arg(cacheHitRate() * 100.0, 0, 'f', 1)
+    };
+
+    const QRect box = overlayRect(area);
+
+    painter.save();
+    painter.setPen(Qt::NoPen);
+    painter.setBrush(QColor(0, 0, 0, 160));
+    painter.drawRect(box);
+    painter.setPen(Qt::white);
+    int y = box.top() + OVERLAY_LINE_HEIGHT;
+    for (const QString &line : lines) {
+        painter.drawText(box.left() + 8, y, line);
+        y += OVERLAY_LINE_HEIGHT;
+    }
+    painter.restore();
+}
+
+QRect RenderStats::overlayRect(const QRect &area) const
+{
+    return QRect(area.right() - OVERLAY_WIDTH - 10, area.top() + 10,
+                 OVERLAY_WIDTH, OVERLAY_LINE_HEIGHT * OVERLAY_LINES + 10);
+}
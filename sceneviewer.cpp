@@ -0,0 +1,379 @@
+/**
+ * @file sceneviewer.cpp
+ * @brief SceneViewer 类实现文件
+ *
+ * 曲线保存在 curvecore::Scene 中，细分、剔除与拾取都交给场景；
+ * 本文件只负责文件载入、视图变换、绘制与把曲线交给编辑器。
+ */
+
+
+// sceneviewer.cpp
+#include "SceneViewer.h"
+#include "NurbsEditor.h"
+#include "HermiteEditor.h"
+#include <QPainter>
+#include <QMouseEvent>
+#include <QWheelEvent>
+#include <QKeyEvent>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileDialog>
+#include <QFileInfo>
+#include <QMessageBox>
+#include <QtMath>
+#include <algorithm>
+#include <string>
+
+SceneViewer::SceneViewer(QWidget *parent)
+    : CurveSurface(parent), surfaceRenderer(this)
+{
+    setMouseTracking(true);
+    setFocusPolicy(Qt::StrongFocus);
+    applySettings();
+}
+
+SceneViewer::~SceneViewer()
+{
+}
+
+//----------------------------------------
+// 文件
+//----------------------------------------
+
+/**
+ * @brief 把一个文件载入场景；映射内存只在载入期间使用，曲线拷贝进场景
+ */
+bool SceneViewer::loadInto(const QString &fileName, Scene &scene, QString *error)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        if (error) *error = file.errorString();
+        return false;
+    }
+    uchar *data = file.map(0, file.size());
+    if (!data) {
+        if (error) *error = file.errorString();
+        return false;
+    }
+
+    std::string message;
+    curvecore::CurveFileView view;
+    bool ok = view.open(data, static_cast<size_t>(file.size()), &message);
+    if (ok && view.kind() == curvecore::CURVE_NURBS) {
+        curvecore::NurbsCurve<double, 2> nurbs;
+        ok = curvecore::loadCurve(view, nurbs, &message);
+        if (ok) scene.addNurbs(nurbs);
+    } else if (ok) {
+        curvecore::HermiteSpline<double, 2> hermite;
+        ok = curvecore::loadCurve(view, hermite, &message);
+        if (ok) scene.addHermite(hermite);
+    }
+    file.unmap(data);
+    if (!ok && error) *error = QString::fromUtf8(message.c_str());
+    return ok;
+}
+
+bool SceneViewer::loadCurves(const QStringList &fileNames, QString *error)
+{
+    bool wasEmpty = scene.isEmpty();
+    QStringList failures;
+    for (const QString &fileName : fileNames) {
+        QString message;
+        if (loadInto(fileName, scene, &message)) sources.append(fileName);
+        else failures.append(QFileInfo(fileName).fileName() + ": " + message);
+    }
+
+    // 第一次载入时适配视图，之后保持用户当前的视图
+    updateScene();
+    if (wasEmpty && !scene.isEmpty()) fitToScene();
+    update();
+
+    if (!failures.isEmpty() && error) *error = failures.join('\n');
+    return failures.isEmpty();
+}
+
+void SceneViewer::clear()
+{
+    scene.clear();
+    sources.clear();
+    hovered = -1;
+    retessellated = 0;
+    update();
+}
+
+//----------------------------------------
+// 视图与细分
+//----------------------------------------
+
+curvecore::Viewport SceneViewer::viewport() const
+{
+    curvecore::Viewport view;
+    view.scale = scale;
+    view.offset[0] = offset.x();
+    view.offset[1] = offset.y();
+    view.width = width();
+    view.height = height();
+    return view;
+}
+
+QPointF SceneViewer::toWorld(const QPointF &p) const
+{
+    return (p - offset) / scale;
+}
+
+/**
+ * @brief 自适应细分的容差换算到曲线坐标，只在适配视图时更新，平移缩放不触发重新细分；
+ *        视口细分按当前视口取样，视图每次变化都要重新细分
+ */
+void SceneViewer::applySettings()
+{
+    curvecore::SceneSettings settings = scene.settings();
+    settings.mode = lodMode ? curvecore::SCENE_LOD : curvecore::SCENE_ADAPTIVE;
+    settings.adaptive.tolerance = tolerance / scale;
+    settings.viewport = viewport();
+    settings.lod.tolerance = tolerance;
+    scene.setSettings(settings);
+}
+
+void SceneViewer::updateScene()
+{
+    if (lodMode && scene.settings().viewport != viewport()) applySettings();
+
+    QElapsedTimer timer;
+    timer.start();
+    int count = scene.update(curvecore::ThreadPool::instance());
+    if (count > 0) {
+        retessellated = count;
+        updateMs = timer.nsecsElapsed() / 1e6;
+    }
+}
+
+/**
+ * @brief 视口细分会剔除视口外的部分，包围盒只覆盖可见部分；此时先按自适应细分取整条曲线的包围盒
+ */
+void SceneViewer::fitToScene()
+{
+    if (lodMode) {
+        lodMode = false;
+        applySettings();
+        updateScene();
+        lodMode = true;
+    }
+    double lo[2], hi[2];
+    if (!scene.bounds(lo, hi)) {
+        applySettings();
+        return;
+    }
+
+    double w = qMax(hi[0] - lo[0], 1e-9), h = qMax(hi[1] - lo[1], 1e-9);
+    double availableW = qMax(width() - 2 * FIT_MARGIN, 1), availableH = qMax(height() - 2 * FIT_MARGIN, 1);
+    scale = qMin(availableW / w, availableH / h);
+    offset = QPointF(width() / 2.0 - (lo[0] + hi[0]) / 2.0 * scale,
+                     height() / 2.0 - (lo[1] + hi[1]) / 2.0 * scale);
+
+    applySettings();
+    updateScene();
+    hovered = -1;
+    update();
+}
+
+//----------------------------------------
+// 绘制
+//----------------------------------------
+
+void SceneViewer::paintEvent(QPaintEvent *)
+{
+    updateScene();
+
+    QPainter painter(this);
+    painter.setRenderHint(QPainter::Antialiasing);
+    painter.fillRect(rect(), Qt::white);
+    surfaceRenderer.begin(painter);
+
+    drawCurves(painter);
+    drawStatusText(painter);
+
+    surfaceRenderer.end();
+}
+
+/**
+ * @brief 只绘制包围盒与视口相交的曲线；顶点在每帧临时内存中变换到屏幕坐标
+ */
+void SceneViewer::drawCurves(QPainter &painter)
+{
+    const QPointF topLeft = toWorld(QPointF(0, 0)), bottomRight = toWorld(QPointF(width(), height()));
+    const double lo[2] = { topLeft.x(), topLeft.y() };
+    const double hi[2] = { bottomRight.x(), bottomRight.y() };
+    scene.query(lo, hi, visible);
+
+    curvecore::ScratchArena &arena = surfaceRenderer.frameArena();
+    const QPen nurbsPen(QColor(200, 60, 60), 1.5), hermitePen(QColor(40, 90, 200), 1.5);
+    for (int i : visible) {
+        const Scene::Curve &c = scene.curve(i);
+        int count = static_cast<int>(c.line.size());
+        float *xs = arena.allocate<float>(count), *ys = arena.allocate<float>(count);
+        const double *wx = c.line.coords[0].data(), *wy = c.line.coords[1].data();
+        for (int k = 0; k < count; ++k) {
+            xs[k] = static_cast<float>(wx[k] * scale + offset.x());
+            ys[k] = static_cast<float>(wy[k] * scale + offset.y());
+        }
+
+        QPen pen = c.kind == curvecore::CURVE_NURBS ? nurbsPen : hermitePen;
+        if (i == hovered) pen.setWidthF(3.5);
+        surfaceRenderer.strokePolyline(painter, xs, ys, count, ++drawRevision, pen);
+    }
+}
+
+void SceneViewer::drawStatusText(QPainter &painter)
+{
+    qint64 vertices = 0;
+    int nurbs = 0;
+    for (int i = 0; i < scene.size(); ++i) {
+        vertices += static_cast<qint64>(scene.curve(i).line.size());
+        nurbs += scene.curve(i).kind == curvecore::CURVE_NURBS ? 1 : 0;
+    }
+
+    QStringList helpText = {
+        "Ctrl+O 添加曲线文件（可多选），C 清空",
+        "左键拖动平移，滚轮缩放，R 适配全部曲线",
+        "双击曲线在编辑器中打开",
+        QString("曲线: %1（NURBS %2, Hermite %3），顶点 %4")
+            .arg(scene.size()).arg(nurbs).arg(scene.size() - nurbs).arg(vertices),
+        QString("可见: %1, 上次细分 %2 条 %3 ms")
+            .arg(static_cast<int>(visible.size())).arg(retessellated).arg(updateMs, 0, 'f', 2),
+        QString("视口细分(L): %1, 容差([ / ]) %2px").arg(lodMode ? "开" : "关").arg(tolerance, 0, 'f', 2),
+        hovered >= 0 ? QString("悬停: %1").arg(QFileInfo(sources[hovered]).fileName()) : QString()
+    };
+
+    painter.setPen(Qt::black);
+    int y = 20;
+    for (const QString &line : helpText) {
+        painter.drawText(10, y, line);
+        y += 16;
+    }
+}
+
+//----------------------------------------
+// 交互
+//----------------------------------------
+
+void SceneViewer::updateHover(const QPointF &p)
+{
+    const QPointF w = toWorld(p);
+    int hit = scene.pick(w.x(), w.y(), PICK_DISTANCE / scale);
+    if (hit != hovered) {
+        hovered = hit;
+        update();
+    }
+}
+
+void SceneViewer::mousePressEvent(QMouseEvent *event)
+{
+    if (event->button() == Qt::LeftButton) {
+        panning = true;
+        panAnchor = event->pos();
+    }
+}
+
+void SceneViewer::mouseMoveEvent(QMouseEvent *event)
+{
+    if (panning) {
+        offset += event->pos() - panAnchor;
+        panAnchor = event->pos();
+        update();
+        return;
+    }
+    updateHover(event->pos());
+}
+
+void SceneViewer::mouseReleaseEvent(QMouseEvent *event)
+{
+    if (event->button() == Qt::LeftButton) panning = false;
+}
+
+void SceneViewer::mouseDoubleClickEvent(QMouseEvent *event)
+{
+    updateHover(event->pos());
+    if (hovered >= 0) openInEditor(hovered);
+}
+
+/**
+ * @brief 以鼠标位置为中心缩放：缩放前后鼠标下的曲线坐标不变
+ */
+void SceneViewer::wheelEvent(QWheelEvent *event)
+{
+    double factor = qPow(1.0015, event->angleDelta().y());
+    const QPointF p = event->position();
+    const QPointF anchor = toWorld(p);
+    scale = qBound(1e-9, scale * factor, 1e9);
+    offset = p - anchor * scale;
+    hovered = -1;
+    update();
+}
+
+void SceneViewer::keyPressEvent(QKeyEvent *event)
+{
+    if (event->matches(QKeySequence::Open)) {
+        QStringList fileNames = QFileDialog::getOpenFileNames(this, "添加曲线文件", QString(), "曲线文件 (*.crv)");
+        QString error;
+        if (!fileNames.isEmpty() && !loadCurves(fileNames, &error))
+            QMessageBox::warning(this, "打开失败", error);
+        return;
+    }
+
+    switch (event->key()) {
+    case Qt::Key_C:
+        clear();
+        break;
+    case Qt::Key_R:
+        fitToScene();
+        break;
+    case Qt::Key_L:
+        lodMode = !lodMode;
+        applySettings();
+        break;
+    case Qt::Key_BracketLeft:
+        tolerance = qMax(tolerance * 0.5, 0.05);
+        applySettings();
+        break;
+    case Qt::Key_BracketRight:
+        tolerance = qMin(tolerance * 2.0, 8.0);
+        applySettings();
+        break;
+    default:
+        CurveSurface::keyPressEvent(event);
+        return;
+    }
+    update();
+}
+
+/**
+ * @brief 编辑器是独立窗口，关闭时释放；编辑的是文件副本，不回写场景（文档模型只读，见 SceneViewer.h）
+ */
+void SceneViewer::openInEditor(int i)
+{
+    bool isNurbs = scene.curve(i).kind == curvecore::CURVE_NURBS;
+    QString error;
+    CurveSurface *editor = nullptr;
+    bool ok;
+    if (isNurbs) {
+        NURBSEditor *nurbsEditor = new NURBSEditor();
+        ok = nurbsEditor->loadCurve(sources[i], &error);
+        editor = nurbsEditor;
+    } else {
+        HermiteEditor *hermiteEditor = new HermiteEditor();
+        ok = hermiteEditor->loadCurve(sources[i], &error);
+        editor = hermiteEditor;
+    }
+    if (!ok) {
+        delete editor;
+        QMessageBox::warning(this, "打开失败", error);
+        return;
+    }
+
+    editor->setAttribute(Qt::WA_DeleteOnClose);
+    editor->setWindowTitle(QString("%1 - %2").arg(isNurbs ? "NURBS 曲线编辑器" : "Hermite 样条曲线编辑器")
+                               .arg(QFileInfo(sources[i]).fileName()));
+    editor->resize(1280, 800);
+    editor->show();
+}
@@ -0,0 +1,31 @@
+/**
+ * @file Check.h
+ * @brief 回归测试共用的断言：失败时打印位置并计数，不中止，便于一次看到所有失败
+ */
+#ifndef TESTS_CHECK_H
+#define TESTS_CHECK_H
+
+#include <cstdio>
+
+namespace tests {
+
+extern int failures;
+
+void runCurveFileTests();
+void runExporterTests();
+void runTessellationTests();
+void runKnotInsertionTests();
+void runArcLengthTests();
+void runClosestPointTests();
+
+} // namespace tests
+
+#define CHECK(condition)                                                                         \
+    do {                                                                                         \
+        if (!(condition)) {                                                                      \
+            std::fprintf(stderr, "%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #condition);   \
+            ++tests::failures;                                                                   \
+        }                                                                                        \
+    } while (0)
+
+#endif // TESTS_CHECK_H
@@ -0,0 +1,123 @@
+/**
+ * @file arclengthtest.cpp
+ * @brief 弧长表回归测试：总长与稠密折线一致，按弧长反查能回到原参数，批量与弧长等距查询结果一致
+ */
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "Check.h"
+#include "curvecore/CurveCore.h"
+
+namespace {
+
+typedef curvecore::NurbsCurve<double, 2> Nurbs;
+typedef curvecore::HermiteSpline<double, 2> Hermite;
+
+/**
+ * @brief 10 个点的 3 阶有理曲线，节点向量平移缩放到 [begin, end]
+ */
+Nurbs makeNurbs(double begin, double end, std::mt19937 &rng)
+{
+    const int COUNT = 10;
+    std::uniform_real_distribution<double> coord(-300.0, 300.0), weight(0.5, 2.0);
+    Nurbs curve(3);
+    std::vector<double> x(COUNT), y(COUNT), w(COUNT);
+    for (int i = 0; i < COUNT; ++i) {
+        x[i] = coord(rng);
+        y[i] = coord(rng);
+        w[i] = weight(rng);
+    }
+    const double *coords[2] = {x.data(), y.data()};
+    curve.assign(coords, w.data(), COUNT);
+    std::vector<double> knots = curve.knots();
+    for (double &k : knots) k = begin + (end - begin) * k;
+    curve.setKnots(knots.data(), static_cast<int>(knots.size()));
+    return curve;
+}
+
+Hermite makeHermite(std::mt19937 &rng)
+{
+    std::uniform_real_distribution<double> coord(-300.0, 300.0);
+    Hermite spline;
+    for (int i = 0; i < 7; ++i) {
+        const double p[2] = {coord(rng), coord(rng)}, t[2] = {0.0, 0.0};
+        spline.append(p, t, false);
+    }
+    return spline;
+}
+
+/**
+ * @brief 稠密折线在 [t0, t1] 上的长度，作为弧长的参照
+ */
+template <typename View>
+double polylineLength(const View &v, double t0, double t1)
+{
+    const int N = 100000;
+    double a[2], b[2], length = 0.0;
+    curvecore::evaluate(v, t0, a);
+    for (int k = 1; k <= N; ++k) {
+        curvecore::evaluate(v, t0 + (t1 - t0) * k / N, b);
+        length += std::hypot(b[0] - a[0], b[1] - a[1]);
+        a[0] = b[0];
+        a[1] = b[1];
+    }
+    return length;
+}
+
+template <template <typename, int> class View>
+void checkTable(const View<double, 2> &v, std::mt19937 &rng)
+{
+    curvecore::ArcLengthTable<double> table;
+    curvecore::buildArcLengthTable(v, table);
+    CHECK(table.isValid());
+    if (!table.isValid()) return;
+
+    std::vector<double> breaks;
+    curvecore::spanBreaks(v, breaks);
+    const double begin = breaks.front(), end = breaks.back();
+    CHECK(table.domainBegin() == begin && table.domainEnd() == end);
+
+    // 每个表区间的误差不超过 tolerance（1e-3），总长只会差若干个 tolerance
+    const double total = table.length();
+    CHECK(std::abs(total - polylineLength(v, begin, end)) < 1e-2);
+    CHECK(table.lengthAt(begin) == 0.0 && table.lengthAt(end) == total);
+
+    std::uniform_real_distribution<double> param(begin, end);
+    std::vector<double> t(100);
+    for (double &u : t) u = param(rng);
+    std::sort(t.begin(), t.end());
+    const double middle = t[t.size() / 2];
+    CHECK(std::abs(table.lengthAt(middle) - polylineLength(v, begin, middle)) < 1e-2);
+
+    std::vector<double> s(t.size()), batch(t.size());
+    for (size_t k = 0; k < t.size(); ++k) {
+        s[k] = table.lengthAt(t[k]);
+        CHECK(std::abs(table.parameterAt(s[k]) - t[k]) <= 1e-9 * (end - begin));
+        if (k > 0) CHECK(s[k] >= s[k - 1]);
+    }
+    table.parametersAt(s.data(), s.size(), batch.data());
+    for (size_t k = 0; k < t.size(); ++k) CHECK(std::abs(batch[k] - t[k]) <= 1e-9 * (end - begin));
+
+    // 弧长等距参数：相邻两点间的表弧长相等，首尾落在定义域端点
+    const size_t N = 33;
+    std::vector<double> uniform(N);
+    table.uniformParameters(N, uniform.data());
+    CHECK(uniform.front() == begin && uniform.back() == end);
+    for (size_t k = 1; k < N; ++k)
+        CHECK(std::abs(table.lengthAt(uniform[k]) - table.lengthAt(uniform[k - 1]) - total / (N - 1)) <= 1e-7 * total);
+}
+
+} // namespace
+
+void tests::runArcLengthTests()
+{
+    std::mt19937 rng(20260315);
+    const Nurbs unit = makeNurbs(0.0, 1.0, rng);
+    const Nurbs shifted = makeNurbs(2.0, 12.0, rng);
+    const Hermite spline = makeHermite(rng);
+    checkTable(unit.view(), rng);
+    checkTable(shifted.view(), rng);
+    checkTable(spline.view(), rng);
+}
@@ -0,0 +1,138 @@
+/**
+ * @file closestpointtest.cpp
+ * @brief 最近点投影回归测试：与稠密采样加局部搜索的暴力结果一致，返回的点与参数自洽
+ */
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "Check.h"
+#include "curvecore/CurveCore.h"
+
+namespace {
+
+typedef curvecore::NurbsCurve<double, 2> Nurbs;
+typedef curvecore::HermiteSpline<double, 2> Hermite;
+
+Nurbs makeNurbs(double begin, double end, std::mt19937 &rng)
+{
+    const int COUNT = 12;
+    std::uniform_real_distribution<double> coord(0.0, 600.0), weight(0.5, 2.0);
+    Nurbs curve(3);
+    std::vector<double> x(COUNT), y(COUNT), w(COUNT);
+    for (int i = 0; i < COUNT; ++i) {
+        x[i] = coord(rng);
+        y[i] = coord(rng);
+        w[i] = weight(rng);
+    }
+    const double *coords[2] = {x.data(), y.data()};
+    curve.assign(coords, w.data(), COUNT);
+    std::vector<double> knots = curve.knots();
+    for (double &k : knots) k = begin + (end - begin) * k;
+    curve.setKnots(knots.data(), static_cast<int>(knots.size()));
+    return curve;
+}
+
+Hermite makeHermite(std::mt19937 &rng)
+{
+    std::uniform_real_distribution<double> coord(0.0, 600.0);
+    Hermite spline;
+    for (int i = 0; i < 8; ++i) {
+        const double p[2] = {coord(rng), coord(rng)}, t[2] = {0.0, 0.0};
+        spline.append(p, t, false);
+    }
+    return spline;
+}
+
+/**
+ * @brief 暴力搜索：稠密采样找到最近的样本，再在其相邻两个采样间隔内三分搜索
+ */
+template <typename View>
+double bruteForceDistance(const View &v, double begin, double end, const double *p)
+{
+    const int N = 20000;
+    auto distanceAt = [&v, p](double t) {
+        double c[2];
+        curvecore::evaluate(v, t, c);
+        return std::hypot(c[0] - p[0], c[1] - p[1]);
+    };
+
+    int nearest = 0;
+    double best = std::numeric_limits<double>::infinity();
+    for (int k = 0; k <= N; ++k) {
+        const double d = distanceAt(begin + (end - begin) * k / N);
+        if (d < best) {
+            best = d;
+            nearest = k;
+        }
+    }
+
+    double lo = begin + (end - begin) * std::max(nearest - 1, 0) / N;
+    double hi = begin + (end - begin) * std::min(nearest + 1, N) / N;
+    for (int iteration = 0; iteration < 100; ++iteration) {
+        const double a = lo + (hi - lo) / 3, b = hi - (hi - lo) / 3;
+        if (distanceAt(a) < distanceAt(b)) hi = b;
+        else lo = a;
+    }
+    return std::min(best, distanceAt((lo + hi) / 2));
+}
+
+template <template <typename, int> class View>
+void checkIndex(const View<double, 2> &v, std::mt19937 &rng)
+{
+    curvecore::ClosestPointIndex<double, 2> index;
+    index.build(v);
+    CHECK(index.isValid());
+
+    std::vector<double> breaks;
+    curvecore::spanBreaks(v, breaks);
+    const double begin = breaks.front(), end = breaks.back();
+    const double far = std::numeric_limits<double>::max();
+
+    const int N = 60;
+    std::uniform_real_distribution<double> coord(-100.0, 700.0);
+    std::vector<double> qx(N), qy(N), params(N), distances(N);
+    for (int k = 0; k < N; ++k) {
+        const double p[2] = {qx[k] = coord(rng), qy[k] = coord(rng)};
+        double t = -1.0, point[2], distance = -1.0;
+        CHECK(index.closest(v, p, far, t, point, &distance));
+        CHECK(t >= begin && t <= end);
+
+        // 返回的点、参数与距离彼此一致
+        double c[2];
+        curvecore::evaluate(v, t, c);
+        CHECK(c[0] == point[0] && c[1] == point[1]);
+        CHECK(std::abs(distance - std::hypot(point[0] - p[0], point[1] - p[1])) <= 1e-9);
+
+        const double brute = bruteForceDistance(v, begin, end, p);
+        CHECK(std::abs(distance - brute) <= 1e-6);
+
+        // 半径小于最近距离时找不到
+        double ignored;
+        CHECK(!index.closest(v, p, distance * 0.5, ignored));
+    }
+
+    const double *queries[2] = {qx.data(), qy.data()};
+    index.closestMany(v, queries, N, far, params.data(), distances.data());
+    for (int k = 0; k < N; ++k) {
+        const double p[2] = {qx[k], qy[k]};
+        double t, distance;
+        index.closest(v, p, far, t, nullptr, &distance);
+        CHECK(params[k] == t && distances[k] == distance);
+    }
+}
+
+} // namespace
+
+void tests::runClosestPointTests()
+{
+    std::mt19937 rng(20260316);
+    const Nurbs unit = makeNurbs(0.0, 1.0, rng);
+    const Nurbs shifted = makeNurbs(-4.0, 6.0, rng);
+    const Hermite spline = makeHermite(rng);
+    checkIndex(unit.view(), rng);
+    checkIndex(shifted.view(), rng);
+    checkIndex(spline.view(), rng);
+}
@@ -0,0 +1,296 @@
+/**
+ * @file curvefiletest.cpp
+ * @brief .crv 读取端回归测试：合法文件往返，以及各类损坏文件必须被拒绝而不是越界读写
+ *
+ * 文件在内存中构造，映射路径（CurveFileView）与流式路径（streamCurve）都要检查。
+ */
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "Check.h"
+#include "curvecore/CurveCore.h"
+
+namespace {
+
+typedef curvecore::NurbsCurve<double, 2> Nurbs;
+typedef curvecore::HermiteSpline<double, 2> Hermite;
+
+/**
+ * @brief 内存中的文件：按 8 字节对齐存放，满足 CurveFileView 的要求
+ */
+struct Bytes {
+    std::vector<unsigned char> data;
+
+    bool operator()(const void *p, size_t n)
+    {
+        const unsigned char *c = static_cast<const unsigned char *>(p);
+        data.insert(data.end(), c, c + n);
+        return true;
+    }
+
+    template <typename Pod>
+    void append(const Pod &value) { (*this)(&value, sizeof(value)); }
+
+    void appendChunk(std::uint32_t tag, int component, std::uint64_t first, std::uint64_t count,
+                     std::uint64_t payloadBytes, const void *payload, size_t bytes)
+    {
+        curvecore::ChunkHeader c;
+        std::memset(&c, 0, sizeof(c));
+        c.tag = tag;
+        c.component = static_cast<std::uint16_t>(component);
+        c.first = first;
+        c.count = count;
+        c.payloadBytes = payloadBytes;
+        append(c);
+        (*this)(payload, bytes);
+    }
+
+    void appendEnd() { appendChunk(curvecore::CHUNK_END, 0, 0, 0, 0, nullptr, 0); }
+};
+
+curvecore::FileHeader makeHeader(curvecore::CurveKind kind, int degree, std::uint64_t count)
+{
+    curvecore::FileHeader h;
+    std::memset(&h, 0, sizeof(h));
+    std::memcpy(h.magic, "CRVF", 4);
+    h.version = curvecore::CURVE_FILE_VERSION;
+    h.byteOrder = curvecore::CURVE_FILE_BYTE_ORDER;
+    h.kind = static_cast<std::uint8_t>(kind);
+    h.dimension = 2;
+    h.scalarBytes = 8;
+    h.degree = degree;
+    h.count = count;
+    return h;
+}
+
+Nurbs makeNurbs(int count, int degree)
+{
+    Nurbs curve(degree);
+    std::vector<double> x(count), y(count), w(count, 1.0);
+    for (int i = 0; i < count; ++i) {
+        x[i] = 100.0 * i;
+        y[i] = 50.0 * std::sin(i * 0.9);
+    }
+    const double *coords[2] = {x.data(), y.data()};
+    curve.assign(coords, w.data(), count);
+    return curve;
+}
+
+/**
+ * @brief 映射路径：解析后拷贝为可编辑曲线
+ */
+template <typename Curve>
+bool loadMapped(const Bytes &file, Curve &curve, std::string *error = nullptr)
+{
+    std::vector<std::uint64_t> aligned((file.data.size() + 7) / 8);
+    if (!file.data.empty()) std::memcpy(aligned.data(), file.data.data(), file.data.size());
+    curvecore::CurveFileView view;
+    return view.open(aligned.data(), file.data.size(), error) && curvecore::loadCurve(view, curve, error);
+}
+
+/**
+ * @brief 流式路径：逐块读入
+ */
+template <typename Curve>
+bool loadStreamed(const Bytes &file, Curve &curve)
+{
+    size_t offset = 0;
+    auto read = [&](void *buffer, size_t bytes) {
+        size_t n = std::min(bytes, file.data.size() - offset);
+        std::memcpy(buffer, file.data.data() + offset, n);
+        offset += n;
+        return n;
+    };
+    return curvecore::streamCurve(read, curve, [](std::uint64_t) {});
+}
+
+template <typename Curve>
+bool loadsEither(const Bytes &file)
+{
+    Curve a, b;
+    return loadMapped(file, a) || loadStreamed(file, b);
+}
+
+/**
+ * @brief 用给定节点向量写出 4 个点的 3 阶 NURBS 文件
+ */
+Bytes nurbsWithKnots(const std::vector<double> &knots)
+{
+    Bytes file;
+    file.append(makeHeader(curvecore::CURVE_NURBS, 3, 4));
+    const double coords[4] = {0.0, 1.0, 2.0, 3.0}, weights[4] = {1.0, 1.0, 1.0, 1.0};
+    file.appendChunk(curvecore::CHUNK_KNOTS, 0, 0, knots.size(), knots.size() * 8, knots.data(), knots.size() * 8);
+    file.appendChunk(curvecore::CHUNK_COORDS, 0, 0, 4, 32, coords, 32);
+    file.appendChunk(curvecore::CHUNK_COORDS, 1, 0, 4, 32, coords, 32);
+    file.appendChunk(curvecore::CHUNK_WEIGHTS, 0, 0, 4, 32, weights, 32);
+    file.appendEnd();
+    return file;
+}
+
+//----------------------------------------
+// 合法文件
+//----------------------------------------
+
+void testRoundTrip()
+{
+    Nurbs curve = makeNurbs(12, 3);
+    const double knots[16] = {0, 0, 0, 0, 1, 2, 3, 4, 5, 6, 7, 8, 10, 10, 10, 10};
+    CHECK(curve.setKnots(knots, 16));
+    for (std::uint64_t chunkPoints : {std::uint64_t(0), std::uint64_t(5)}) {
+        Bytes file;
+        CHECK(curvecore::writeNurbs(curve.view(), std::ref(file), chunkPoints));
+        Nurbs mapped, streamed;
+        CHECK(loadMapped(file, mapped));
+        CHECK(loadStreamed(file, streamed));
+        CHECK(mapped.size() == 12 && streamed.size() == 12);
+        CHECK(mapped.view().domainEnd() == 10.0);
+        for (int i = 0; i < 12; ++i) CHECK(streamed.coord(1, i) == curve.coord(1, i));
+    }
+
+    Hermite spline;
+    for (int i = 0; i < 6; ++i) {
+        const double p[2] = {10.0 * i, 3.0 * i}, t[2] = {1.0, -1.0};
+        spline.append(p, t, i % 2 == 0);
+    }
+    Bytes file;
+    CHECK(curvecore::writeHermite(spline.view(), std::ref(file), 4));
+    Hermite mapped, streamed;
+    CHECK(loadMapped(file, mapped));
+    CHECK(loadStreamed(file, streamed));
+    CHECK(mapped.size() == 6 && streamed.size() == 6 && streamed.hasTangent(4));
+
+    // 少于两个点的曲线没有节点向量，也必须能存取
+    Bytes single;
+    CHECK(curvecore::writeNurbs(makeNurbs(1, 3).view(), std::ref(single)));
+    Nurbs loaded;
+    CHECK(loadMapped(single, loaded) && loaded.size() == 1);
+}
+
+//----------------------------------------
+// 损坏文件
+//----------------------------------------
+
+/**
+ * @brief 块长度未补齐到 8 字节：曾导致流式读取的缓冲区溢出、映射路径的列指针失去对齐
+ */
+void testUnpaddedPayload()
+{
+    const unsigned char zeros[16] = {};
+    const std::uint32_t tags[2] = {curvecore::CHUNK_KNOTS, curvecore::makeChunkTag('X', 'T', 'R', 'A')};
+    for (std::uint32_t tag : tags) {
+        Bytes file;
+        file.append(makeHeader(curvecore::CURVE_NURBS, 1, 2));
+        file.appendChunk(tag, 0, 0, 1, 12, zeros, 12);
+        file.appendEnd();
+        CHECK(!loadsEither<Nurbs>(file));
+    }
+
+    // 已知块的长度必须恰好等于补齐后的数据长度
+    Bytes oversized;
+    oversized.append(makeHeader(curvecore::CURVE_NURBS, 1, 2));
+    oversized.appendChunk(curvecore::CHUNK_WEIGHTS, 0, 0, 1, 16, zeros, 16);
+    oversized.appendEnd();
+    CHECK(!loadsEither<Nurbs>(oversized));
+}
+
+/**
+ * @brief 文件头的点数远超文件大小：映射路径必须在分配内存前拒绝
+ */
+void testCountExceedsFile()
+{
+    Bytes file;
+    file.append(makeHeader(curvecore::CURVE_NURBS, 3, 0x7fffffff));
+    file.appendEnd();
+    std::string error;
+    Nurbs curve;
+    CHECK(!loadMapped(file, curve, &error));
+    CHECK(error == "point count exceeds file size");
+}
+
+/**
+ * @brief 缺少或只覆盖部分的列不能被当成零点曲线加载
+ */
+void testIncompleteColumns()
+{
+    Bytes endOnly;
+    endOnly.append(makeHeader(curvecore::CURVE_NURBS, 3, 4));
+    endOnly.appendChunk(curvecore::makeChunkTag('P', 'A', 'D', ' '), 0, 0, 0, 256, std::vector<char>(256).data(), 256);
+    endOnly.appendEnd();
+    CHECK(!loadsEither<Nurbs>(endOnly));
+
+    const double values[4] = {0.0, 1.0, 2.0, 3.0};
+    Bytes partial;
+    partial.append(makeHeader(curvecore::CURVE_HERMITE, 3, 4));
+    for (int d = 0; d < 2; ++d) {
+        partial.appendChunk(curvecore::CHUNK_COORDS, d, 0, 4, 32, values, 32);
+        partial.appendChunk(curvecore::CHUNK_TANGENTS, d, 0, d == 0 ? 3 : 4, d == 0 ? 24 : 32, values, d == 0 ? 24 : 32);
+    }
+    const unsigned char flags[8] = {};
+    partial.appendChunk(curvecore::CHUNK_FLAGS, 0, 0, 4, 8, flags, 8);
+    partial.appendEnd();
+    CHECK(!loadsEither<Hermite>(partial));
+
+    // 重叠的块同样视为损坏
+    Bytes overlap;
+    overlap.append(makeHeader(curvecore::CURVE_NURBS, 1, 4));
+    for (int d = 0; d < 2; ++d) overlap.appendChunk(curvecore::CHUNK_COORDS, d, 0, 4, 32, values, 32);
+    overlap.appendChunk(curvecore::CHUNK_WEIGHTS, 0, 0, 2, 16, values + 1, 16);
+    overlap.appendChunk(curvecore::CHUNK_WEIGHTS, 0, 1, 3, 24, values + 1, 24);
+    overlap.appendEnd();
+    CHECK(!loadsEither<Nurbs>(overlap));
+}
+
+/**
+ * @brief 节点向量与权重在求值前检查，映射视图与拷贝路径都要拒绝
+ */
+void testInvalidKnots()
+{
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    const std::vector<double> bad[4] = {
+        {0, 0, 0, 0, 1, 1, 0.5, 1},          // 递减
+        {0, 0, 0, 0, nan, 1, 1, 1},          // 非有限
+        {0, 0, 0, 0, 0, 1, 1, 1},            // 重数超过 p+1
+        {0, 0, 0, 0, 0, 0, 0, 0},            // 定义域为空（同时重数超限）
+    };
+    for (const std::vector<double> &knots : bad) {
+        Bytes file = nurbsWithKnots(knots);
+        CHECK(!loadsEither<Nurbs>(file));
+
+        std::vector<std::uint64_t> aligned((file.data.size() + 7) / 8);
+        std::memcpy(aligned.data(), file.data.data(), file.data.size());
+        curvecore::CurveFileView view;
+        curvecore::NurbsView<double, 2> mapped;
+        CHECK(view.open(aligned.data(), file.data.size()));
+        CHECK(!view.nurbsView(mapped));
+    }
+
+    Bytes good = nurbsWithKnots({0, 0, 0, 0, 4, 4, 4, 4});
+    Nurbs curve;
+    CHECK(loadMapped(good, curve) && curve.view().domainEnd() == 4.0);
+
+    Bytes zeroWeight;
+    zeroWeight.append(makeHeader(curvecore::CURVE_NURBS, 1, 2));
+    const double coords[2] = {0.0, 1.0}, weights[2] = {1.0, 0.0};
+    zeroWeight.appendChunk(curvecore::CHUNK_COORDS, 0, 0, 2, 16, coords, 16);
+    zeroWeight.appendChunk(curvecore::CHUNK_COORDS, 1, 0, 2, 16, coords, 16);
+    zeroWeight.appendChunk(curvecore::CHUNK_WEIGHTS, 0, 0, 2, 16, weights, 16);
+    zeroWeight.appendEnd();
+    CHECK(!loadsEither<Nurbs>(zeroWeight));
+}
+
+} // namespace
+
+void tests::runCurveFileTests()
+{
+    testRoundTrip();
+    testUnpaddedPayload();
+    testCountExceedsFile();
+    testIncompleteColumns();
+    testInvalidKnots();
+}
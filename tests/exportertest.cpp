@@ -0,0 +1,77 @@
+/**
+ * @file exportertest.cpp
+ * @brief 折线导出回归测试：文本格式对任意宽度的数值都不越界，且逐行完整
+ */
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "Check.h"
+#include "curvecore/CurveCore.h"
+
+namespace {
+
+struct StringSink {
+    std::string *text;
+    bool operator()(const void *data, size_t bytes) const
+    {
+        text->append(static_cast<const char *>(data), bytes);
+        return true;
+    }
+};
+
+/**
+ * @brief 两个插值点的 Hermite 样条，坐标取给定值
+ */
+template <int Dim>
+curvecore::HermiteSpline<double, Dim> makeSpline(double value)
+{
+    curvecore::HermiteSpline<double, Dim> spline;
+    double p[Dim], t[Dim] = {};
+    for (int d = 0; d < Dim; ++d) p[d] = value;
+    spline.append(p, t, true);
+    spline.append(p, t, true);
+    return spline;
+}
+
+/**
+ * @brief 导出后逐行解析：行数等于写出点数，每行 Dim 个值且与输入一致
+ */
+template <int Dim>
+void checkWideValues(double value, int precision)
+{
+    curvecore::HermiteSpline<double, Dim> spline = makeSpline<Dim>(value);
+    curvecore::ExportSettings settings;
+    settings.samples = 5;
+    settings.precision = precision;
+    std::string text;
+    curvecore::ExportStats stats = curvecore::exportPolyline(spline.view(), StringSink{&text}, settings);
+    CHECK(stats.ok && stats.written == 5 && stats.bytes == text.size());
+
+    size_t lines = 0;
+    const char *p = text.c_str();
+    while (*p) {
+        for (int d = 0; d < Dim; ++d) {
+            char *end;
+            double parsed = std::strtod(p, &end);
+            CHECK(end != p && parsed == value);
+            p = end;
+        }
+        CHECK(*p == '\n');
+        if (*p) ++p;
+        ++lines;
+    }
+    CHECK(lines == 5);
+}
+
+} // namespace
+
+void tests::runExporterTests()
+{
+    // 1e70、1e300 以 %.f 输出都远超以前每维 64 字节的行缓冲
+    checkWideValues<2>(1e70, 6);
+    checkWideValues<3>(1e70, 6);
+    checkWideValues<3>(-1e300, 17);
+    checkWideValues<2>(2.0, 0);
+}
@@ -0,0 +1,124 @@
+/**
+ * @file knotinsertiontest.cpp
+ * @brief 节点插入与 Bézier 分解回归测试：两者都只改变表示，任意参数处的曲线点必须与原曲线一致
+ */
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "Check.h"
+#include "curvecore/CurveCore.h"
+
+namespace {
+
+typedef curvecore::NurbsCurve<double, 2> Nurbs;
+
+/**
+ * @brief count 个点的 degree 阶有理曲线，节点向量平移缩放到 [begin, end]，坐标与权重取自 rng
+ */
+Nurbs makeCurve(int degree, int count, double begin, double end, std::mt19937 &rng)
+{
+    std::uniform_real_distribution<double> coord(-200.0, 200.0), weight(0.3, 3.0);
+    Nurbs curve(degree);
+    std::vector<double> x(count), y(count), w(count);
+    for (int i = 0; i < count; ++i) {
+        x[i] = coord(rng);
+        y[i] = coord(rng);
+        w[i] = weight(rng);
+    }
+    const double *coords[2] = {x.data(), y.data()};
+    curve.assign(coords, w.data(), count);
+    std::vector<double> knots = curve.knots();
+    for (double &k : knots) k = begin + (end - begin) * k;
+    curve.setKnots(knots.data(), static_cast<int>(knots.size()));
+    return curve;
+}
+
+bool samePoint(const double *a, const double *b)
+{
+    return std::abs(a[0] - b[0]) <= 1e-8 && std::abs(a[1] - b[1]) <= 1e-8;
+}
+
+/**
+ * @brief 在定义域内随机参数处比较 evaluate 与 BezierSegments::evaluate / evaluateMany
+ */
+void checkDecomposition(const Nurbs &curve, std::mt19937 &rng)
+{
+    const curvecore::NurbsView<double, 2> v = curve.view();
+    curvecore::BezierSegments<double, 2> segments;
+    CHECK(curvecore::decomposeBezier(v, segments));
+    if (!segments.isValid()) return;
+
+    const int N = 200;
+    std::uniform_real_distribution<double> param(v.domainBegin(), v.domainEnd());
+    std::vector<double> t(N);
+    for (double &u : t) u = param(rng);
+    t[0] = v.domainBegin();
+    t[N - 1] = v.domainEnd();
+    std::sort(t.begin(), t.end());
+
+    std::vector<double> x(N), y(N);
+    double *out[2] = {x.data(), y.data()};
+    segments.evaluateMany(t.data(), N, out);
+    for (int k = 0; k < N; ++k) {
+        double expected[2], single[2];
+        curvecore::evaluate(v, t[k], expected);
+        segments.evaluate(t[k], single);
+        const double batch[2] = {x[k], y[k]};
+        CHECK(samePoint(single, expected));
+        CHECK(samePoint(batch, expected));
+    }
+}
+
+/**
+ * @brief 在随机参数处插入节点直到重数为 p，插入前后在随机参数处的曲线点一致，再插入则被拒绝
+ */
+void checkInsertion(const Nurbs &curve, std::mt19937 &rng)
+{
+    const curvecore::NurbsView<double, 2> v = curve.view();
+    std::uniform_real_distribution<double> param(v.domainBegin(), v.domainEnd());
+
+    for (int trial = 0; trial < 8; ++trial) {
+        // 插入已有的内部节点时重数叠加
+        const double u = trial % 4 == 3 ? v.knots[v.degree + 1] : param(rng);
+        const int s = curvecore::knotMultiplicity(v.knots, v.count + v.degree + 1, u);
+        Nurbs refined;
+        if (s >= v.degree) {
+            CHECK(!curvecore::insertKnot(v, u, 1, refined));
+            continue;
+        }
+        const int times = v.degree - s;
+        CHECK(curvecore::insertKnot(v, u, times, refined));
+        const curvecore::NurbsView<double, 2> r = refined.view();
+        CHECK(r.count == v.count + times && r.degree == v.degree);
+        CHECK(curvecore::knotMultiplicity(r.knots, r.count + r.degree + 1, u) == s + times);
+        CHECK(r.domainBegin() == v.domainBegin() && r.domainEnd() == v.domainEnd());
+
+        for (int k = 0; k < 50; ++k) {
+            const double t = k == 0 ? u : param(rng);
+            double a[2], b[2];
+            curvecore::evaluate(v, t, a);
+            curvecore::evaluate(r, t, b);
+            CHECK(samePoint(a, b));
+        }
+
+        Nurbs untouched;
+        CHECK(!curvecore::insertKnot(r, u, 1, untouched));
+    }
+}
+
+} // namespace
+
+void tests::runKnotInsertionTests()
+{
+    std::mt19937 rng(20260314);
+    for (int degree = 1; degree <= 5; ++degree) {
+        const Nurbs unit = makeCurve(degree, 12, 0.0, 1.0, rng);
+        const Nurbs shifted = makeCurve(degree, 9, 2.0, 12.0, rng);
+        checkDecomposition(unit, rng);
+        checkDecomposition(shifted, rng);
+        checkInsertion(unit, rng);
+        checkInsertion(shifted, rng);
+    }
+}
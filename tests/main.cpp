@@ -0,0 +1,26 @@
+/**
+ * @file main.cpp
+ * @brief curvetests 入口：依次运行各组回归测试，有失败时返回非零
+ */
+#include "Check.h"
+
+namespace tests {
+int failures = 0;
+}
+
+int main()
+{
+    tests::runCurveFileTests();
+    tests::runExporterTests();
+    tests::runTessellationTests();
+    tests::runKnotInsertionTests();
+    tests::runArcLengthTests();
+    tests::runClosestPointTests();
+
+    if (tests::failures) {
+        std::fprintf(stderr, "%d check(s) failed\n", tests::failures);
+        return 1;
+    }
+    std::printf("curvetests: all checks passed\n");
+    return 0;
+}
@@ -0,0 +1,181 @@
+/**
+ * @file tessellationtest.cpp
+ * @brief 均匀采样回归测试：节点向量不在 [0,1] 上时，各条采样路径都必须覆盖整个定义域
+ */
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "Check.h"
+#include "curvecore/CurveCore.h"
+
+namespace {
+
+typedef curvecore::NurbsCurve<double, 2> Nurbs;
+
+/**
+ * @brief 8 个点的 3 阶曲线，节点向量平移缩放到 [2, 12]（如从文件加载）
+ */
+Nurbs makeShiftedCurve()
+{
+    const int COUNT = 8;
+    Nurbs curve(3);
+    std::vector<double> x(COUNT), y(COUNT), w(COUNT);
+    for (int i = 0; i < COUNT; ++i) {
+        x[i] = 100.0 * i;
+        y[i] = 40.0 * std::sin(i * 1.1);
+        w[i] = 1.0 + 0.25 * (i % 3);
+    }
+    const double *coords[2] = {x.data(), y.data()};
+    curve.assign(coords, w.data(), COUNT);
+    std::vector<double> knots = curve.knots();
+    for (double &k : knots) k = 2.0 + 10.0 * k;
+    curve.setKnots(knots.data(), static_cast<int>(knots.size()));
+    return curve;
+}
+
+bool near(double a, double b, double tolerance) { return std::abs(a - b) <= tolerance; }
+
+/**
+ * @brief 未夹紧的均匀节点向量：定义域 [u_p, u_n+1] 之外还有 p 个节点区间
+ *        自适应细分只能细分定义域内的区间，首尾顶点落在定义域端点，且没有截断产生的重复顶点
+ */
+void checkAdaptiveDomain()
+{
+    Nurbs curve = makeShiftedCurve();
+    std::vector<double> knots(curve.knots().size());
+    for (size_t i = 0; i < knots.size(); ++i) knots[i] = -3.0 + 0.5 * i;
+    CHECK(curve.setKnots(knots.data(), static_cast<int>(knots.size())));
+    const curvecore::NurbsView<double, 2> v = curve.view();
+
+    curvecore::TessellationSettings settings;
+    curvecore::Polyline<double, 2> line;
+    curvecore::tessellateAdaptive(v, settings, line);
+    CHECK(line.size() > 2);
+    if (line.size() < 2) return;
+
+    double first[2], last[2];
+    curvecore::evaluate(v, v.domainBegin(), first);
+    curvecore::evaluate(v, v.domainEnd(), last);
+    const size_t n = line.size() - 1;
+    CHECK(line.coords[0][0] == first[0] && line.coords[1][0] == first[1]);
+    CHECK(line.coords[0][n] == last[0] && line.coords[1][n] == last[1]);
+    for (size_t k = 1; k < line.size(); ++k)
+        CHECK(line.coords[0][k] != line.coords[0][k - 1] || line.coords[1][k] != line.coords[1][k - 1]);
+}
+
+/**
+ * @brief 基函数表按节点向量匹配：点数、阶数与采样密度不变而节点不同时必须判为过期
+ */
+void checkBasisTableKnots()
+{
+    Nurbs curve = makeShiftedCurve();
+    const int RES = 32;
+    curvecore::BasisTable<double> table;
+    curvecore::BasisTable<float> floatTable;
+    table.build(curve.view(), RES);
+    floatTable.build(curve.view(), RES);
+    CHECK(table.matches(curve.view(), RES) && floatTable.matches(curve.view(), RES));
+    CHECK(!table.matches(curve.view(), RES + 1));
+
+    std::vector<double> knots = curve.knots();
+    knots[5] += 0.5;
+    CHECK(curve.setKnots(knots.data(), static_cast<int>(knots.size())));
+    CHECK(!table.matches(curve.view(), RES) && !floatTable.matches(curve.view(), RES));
+
+    table.build(curve.view(), RES);
+    CHECK(table.matches(curve.view(), RES));
+    table.clear();
+    CHECK(!table.matches(curve.view(), RES));
+}
+
+/**
+ * @brief 阶数超过 MAX_NURBS_DEGREE 的曲线视图无效：各求值器不得写出栈上基函数工作区
+ */
+void checkDegreeBound()
+{
+    const int COUNT = 20, DEGREE = curvecore::MAX_NURBS_DEGREE + 3;
+    Nurbs curve(DEGREE);
+    std::vector<double> x(COUNT), y(COUNT), w(COUNT, 1.0);
+    for (int i = 0; i < COUNT; ++i) {
+        x[i] = i;
+        y[i] = i % 2;
+    }
+    const double *coords[2] = {x.data(), y.data()};
+    curve.assign(coords, w.data(), COUNT);
+    const curvecore::NurbsView<double, 2> v = curve.view();
+    CHECK(v.degree == DEGREE && !v.isValid());
+
+    double p[2] = {1.0, 1.0};
+    curvecore::evaluate(v, 0.5, p);
+    CHECK(p[0] == 0.0 && p[1] == 0.0);
+
+    double ders[2 * (curvecore::MAX_DERIVATIVE_ORDER + 1)];
+    curvecore::evaluateDerivatives(v, 0.5, 1, ders);
+
+    curvecore::Polyline<double, 2> line;
+    curvecore::tessellateUniform(v, 16, line);
+    CHECK(line.isEmpty());
+    curvecore::tessellateAdaptive(v, curvecore::TessellationSettings(), line);
+    CHECK(line.isEmpty());
+
+    curvecore::BasisTable<double> table;
+    table.build(v, 16);
+    CHECK(table.sampleCount() == 0);
+
+    curvecore::BezierSegments<double, 2> segments;
+    CHECK(!curvecore::decomposeBezier(v, segments));
+}
+
+} // namespace
+
+void tests::runTessellationTests()
+{
+    const Nurbs curve = makeShiftedCurve();
+    const curvecore::NurbsView<double, 2> v = curve.view();
+    const int RES = 64;
+
+    // 参照：在定义域等分网格上逐点求值
+    std::vector<double> ex(RES + 1), ey(RES + 1);
+    for (int k = 0; k <= RES; ++k) {
+        double p[2];
+        curvecore::evaluate(v, 2.0 + 10.0 * k / RES, p);
+        ex[k] = p[0];
+        ey[k] = p[1];
+    }
+    CHECK(near(ex[RES], curve.coord(0, curve.size() - 1), 1e-9));
+
+    curvecore::Polyline<double, 2> line;
+    curvecore::tessellateUniform(v, RES, line);
+    CHECK(line.size() == size_t(RES + 1));
+    for (int k = 0; k <= RES; ++k) CHECK(near(line.coords[0][k], ex[k], 1e-9) && near(line.coords[1][k], ey[k], 1e-9));
+
+    curvecore::PrecisionSettings mixed;
+    curvecore::tessellateUniform(v, RES, line, mixed);
+    for (int k = 0; k <= RES; ++k) CHECK(near(line.coords[0][k], ex[k], 0.05) && near(line.coords[1][k], ey[k], 0.05));
+
+    curvecore::BasisTable<double> table;
+    table.build(v, RES);
+    std::vector<double> x(RES + 1), y(RES + 1);
+    double *out[2] = {x.data(), y.data()};
+    table.evaluate(v, 0, RES + 1, out);
+    for (int k = 0; k <= RES; ++k) CHECK(near(x[k], ex[k], 1e-9) && near(y[k], ey[k], 1e-9));
+
+    // float 表与回退到 double 的区间：容差为 0 时每个区间都回退，逐样本按表的参数网格求值
+    curvecore::BasisTable<float> floatTable;
+    floatTable.build(v, RES);
+    for (double tolerance : {0.05, 0.0}) {
+        curvecore::PrecisionSettings settings;
+        settings.tolerance = tolerance;
+        curvecore::MixedNurbs<2> mixedCurve;
+        mixedCurve.assign(v, settings, false);
+        std::vector<float> fx(RES + 1), fy(RES + 1);
+        float *fout[2] = {fx.data(), fy.data()};
+        mixedCurve.evaluateTable(v, floatTable, 0, RES + 1, fout);
+        for (int k = 0; k <= RES; ++k) CHECK(near(fx[k], ex[k], 0.05) && near(fy[k], ey[k], 0.05));
+    }
+
+    checkAdaptiveDomain();
+    checkDegreeBound();
+    checkBasisTableKnots();
+}
@@ -0,0 +1,22 @@
+QT       -= core gui
+
+CONFIG += c++11 console
+CONFIG -= app_bundle
+
+TARGET = curvetests
+
+INCLUDEPATH += $$PWD/..
+
+SOURCES += \
+    arclengthtest.cpp \
+    closestpointtest.cpp \
+    curvefiletest.cpp \
+    exportertest.cpp \
+    knotinsertiontest.cpp \
+    tessellationtest.cpp \
+    main.cpp
+
+HEADERS += \
+    Check.h
+
+include(../curvecore/curvecore.pri)